@@ -262,10 +262,9 @@ void ModuleAudio::DrawWwiseElementsDetected()
 void ModuleAudio::Load()
 {
 	RE_PROFILE(RE_ProfiledFunc::Load, RE_ProfiledClass::ModuleAudio);
-	RE_Json* node = RE_FS->ConfigNode("Audio");
-	audioBanksFolderPath = node->PullString("FolderBanks", "NONE SELECTED");
+	RE_JsonCursor node = RE_FS->ConfigCursor("Audio");
+	audioBanksFolderPath = node.PullString("FolderBanks", "NONE SELECTED");
 	located_banksFolder = (audioBanksFolderPath != "NONE SELECTED");
-	DEL(node)
 }
 
 void ModuleAudio::Save() const
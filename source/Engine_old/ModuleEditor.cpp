@@ -554,56 +554,54 @@ void ModuleEditor::Load()
 	if (_load.Load())
 		ImGui::LoadIniSettingsFromMemory(_load.GetBuffer(), _load.GetSize());
 
-	RE_Json* node = RE_FS->ConfigNode("Editor");
+	RE_JsonCursor node = RE_FS->ConfigCursor("Editor");
 
-	cam_speed = node->PullFloat("C_Speed", 25.0f);
-	cam_sensitivity = node->PullFloat("C_Sensitivity", 0.01f);
+	cam_speed = node.PullFloat("C_Speed", 25.0f);
+	cam_sensitivity = node.PullFloat("C_Sensitivity", 0.01f);
 
 	//Editor Camera
 	RE_CompCamera* editor_camera = RE_CameraManager::EditorCamera();
 
-	editor_camera->draw_frustum = node->PullBool("C_DrawFrustum", true);
-	editor_camera->override_cull = node->PullBool("C_OverrideCull", false);
+	editor_camera->draw_frustum = node.PullBool("C_DrawFrustum", true);
+	editor_camera->override_cull = node.PullBool("C_OverrideCull", false);
 
-	math::float2 planes = node->PullFloat2("C_Planes", { 1.0f, 5000.0f });
+	math::float2 planes = node.PullFloat2("C_Planes", { 1.0f, 5000.0f });
 	editor_camera->SetPlanesDistance(planes.x, planes.y);
 
-	editor_camera->target_ar = static_cast<RE_CompCamera::AspectRatio>(node->PullInt("C_AspectRatio", static_cast<int>(RE_CompCamera::AspectRatio::Fit_Window)));
-	editor_camera->isPerspective = node->PullBool("C_Prespective", true);
-	editor_camera->SetFOV(math::RadToDeg(node->PullFloat("C_VerticalFOV", math::DegToRad(30.0f))));
+	editor_camera->target_ar = static_cast<RE_CompCamera::AspectRatio>(node.PullInt("C_AspectRatio", static_cast<int>(RE_CompCamera::AspectRatio::Fit_Window)));
+	editor_camera->isPerspective = node.PullBool("C_Prespective", true);
+	editor_camera->SetFOV(math::RadToDeg(node.PullFloat("C_VerticalFOV", math::DegToRad(30.0f))));
 	//------------------
 
-	select_on_mc = node->PullBool("SelectMouseClick", true);
-	focus_on_select = node->PullBool("FocusOnSelect", false);
+	select_on_mc = node.PullBool("SelectMouseClick", true);
+	focus_on_select = node.PullBool("FocusOnSelect", false);
 
-	debug_drawing = node->PullBool("DebugDraw", true);
+	debug_drawing = node.PullBool("DebugDraw", true);
 
-	grid->SetActive(node->PullBool("Grid_Draw", true));
+	grid->SetActive(node.PullBool("Grid_Draw", true));
 
-	math::float2 grid_size_vec = node->PullFloat2("Grid_Size", { 1.0f, 1.0f });
+	math::float2 grid_size_vec = node.PullFloat2("Grid_Size", { 1.0f, 1.0f });
 	memcpy_s(grid_size, sizeof(float) * 2, grid_size_vec.ptr(), sizeof(float) * 2);
 	grid->GetTransformPtr()->SetScale(math::vec(grid_size[0], 0.f, grid_size[1]));
 	grid->GetTransformPtr()->Update();
 
-	aabb_drawing = static_cast<AABBDebugDrawing>(node->PullInt("AABB_Drawing", static_cast<int>(AABBDebugDrawing::ALL_AND_SELECTED)));
+	aabb_drawing = static_cast<AABBDebugDrawing>(node.PullInt("AABB_Drawing", static_cast<int>(AABBDebugDrawing::ALL_AND_SELECTED)));
 
-	math::vec temp_color = node->PullFloatVector("AABB_Selected_Color", { 0.0f, 1.0f, 0.0f });
+	math::vec temp_color = node.PullFloatVector("AABB_Selected_Color", { 0.0f, 1.0f, 0.0f });
 	memcpy_s(all_aabb_color, sizeof(float) * 3, temp_color.ptr(), sizeof(float) * 3);
 
-	temp_color = node->PullFloatVector("AABB_Color", { 1.0f, 0.5f, 0.0f });
+	temp_color = node.PullFloatVector("AABB_Color", { 1.0f, 0.5f, 0.0f });
 	memcpy_s(sel_aabb_color, sizeof(float) * 3, temp_color.ptr(), sizeof(float) * 3);
 
-	draw_quad_tree = node->PullBool("QuadTree_Draw", true);
+	draw_quad_tree = node.PullBool("QuadTree_Draw", true);
 
-	temp_color = node->PullFloatVector("Quadtree_Color", { 1.0f, 1.0f, 0.0f });
+	temp_color = node.PullFloatVector("Quadtree_Color", { 1.0f, 1.0f, 0.0f });
 	memcpy_s(quad_tree_color, sizeof(float) * 3, temp_color.ptr(), sizeof(float) * 3);
 
-	draw_cameras = node->PullBool("Frustum_Draw", true);
+	draw_cameras = node.PullBool("Frustum_Draw", true);
 
-	temp_color = node->PullFloatVector("Frustum_Color", { 0.0f, 1.0f, 1.0f });
+	temp_color = node.PullFloatVector("Frustum_Color", { 0.0f, 1.0f, 1.0f });
 	memcpy_s(frustum_color, sizeof(float) * 3, temp_color.ptr(), sizeof(float) * 3);
-
-	DEL(node)
 }
 
 void ModuleEditor::Save() const
@@ -150,11 +150,9 @@ void ModulePhysics::Load()
 {
 	RE_PROFILE(RE_ProfiledFunc::Load, RE_ProfiledClass::ModuleWindow);
 	RE_LOG_SECONDARY("Loading Physics propieties from config:");
-	RE_Json* node = RE_FS->ConfigNode("Physics");
-
-	mode = static_cast<UpdateMode>(node->PullInt("UpdateMode", static_cast<int>(UpdateMode::FIXED_UPDATE)));
+	RE_JsonCursor node = RE_FS->ConfigCursor("Physics");
 
-	DEL(node)
+	mode = static_cast<UpdateMode>(node.PullInt("UpdateMode", static_cast<int>(UpdateMode::FIXED_UPDATE)));
 }
 
 void ModulePhysics::Save() const
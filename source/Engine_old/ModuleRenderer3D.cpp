@@ -454,19 +454,17 @@ void ModuleRenderer3D::Load()
 {
 	RE_PROFILE(RE_ProfiledFunc::Load, RE_ProfiledClass::ModuleRender);
 	RE_LOG_SECONDARY("Loading Render3D config values:");
-	RE_Json* node = RE_FS->ConfigNode("Renderer3D");
+	RE_JsonCursor node = RE_FS->ConfigCursor("Renderer3D");
 
-	SetVSync(node->PullBool("vsync", true));
+	SetVSync(node.PullBool("vsync", true));
 	RE_LOG_TERCIARY((vsync) ? "VSync enabled." : "VSync disabled");
 
-	if (shareLightPass = node->PullBool("share_light_pass", false))
+	if (shareLightPass = node.PullBool("share_light_pass", false))
 		RE_RES->At(RE_InternalResources::GetParticleLightPassShader())->UnloadMemory();
 
 	// Render Views
 	for (uint i = 0; i < render_views.size(); ++i)
-		render_views[i].Load(node->PullJObject((render_views[i].name + " View").c_str()));
-
-	DEL(node)
+		render_views[i].Load(node.Child((render_views[i].name + " View").c_str()));
 }
 
 void ModuleRenderer3D::Save() const
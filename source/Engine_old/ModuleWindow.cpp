@@ -82,7 +82,7 @@ void ModuleWindow::Load()
 {
 	RE_PROFILE(RE_ProfiledFunc::Load, RE_ProfiledClass::ModuleWindow);
 	RE_LOG_SECONDARY("Loading Window propieties from config:");
-	RE_Json* node = RE_FS->ConfigNode("Window");
+	RE_JsonCursor node = RE_FS->ConfigCursor("Window");
 
 	/*/Use OpenGL 2.1 ?? TODO: check prefered GL Context version setting
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
@@ -90,18 +90,16 @@ void ModuleWindow::Load()
 
 	//OpenGL context 
 	flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN;
-	if (node->PullBool("fullscreen", false)) flags |= SDL_WINDOW_FULLSCREEN;
-	if (node->PullBool("resizable", true)) flags |= SDL_WINDOW_RESIZABLE;
-	if (node->PullBool("borderless", false)) flags |= SDL_WINDOW_BORDERLESS;
-	if (node->PullBool("fullscreen_desktop", false)) flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
-
-	title = node->PullString("title", title.c_str());
-	pos_x = node->PullInt("pos_x", SDL_WINDOWPOS_CENTERED);
-	pos_y = node->PullInt("pos_y", SDL_WINDOWPOS_CENTERED);
-	width = node->PullInt("width", width);
-	height = node->PullInt("height", height);
-
-	DEL(node)
+	if (node.PullBool("fullscreen", false)) flags |= SDL_WINDOW_FULLSCREEN;
+	if (node.PullBool("resizable", true)) flags |= SDL_WINDOW_RESIZABLE;
+	if (node.PullBool("borderless", false)) flags |= SDL_WINDOW_BORDERLESS;
+	if (node.PullBool("fullscreen_desktop", false)) flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+
+	title = node.PullString("title", title.c_str());
+	pos_x = node.PullInt("pos_x", SDL_WINDOWPOS_CENTERED);
+	pos_y = node.PullInt("pos_y", SDL_WINDOWPOS_CENTERED);
+	width = node.PullInt("width", width);
+	height = node.PullInt("height", height);
 }
 
 void ModuleWindow::Save() const
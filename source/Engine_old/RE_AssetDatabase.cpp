@@ -0,0 +1,221 @@
+#include "RE_AssetDatabase.h"
+
+#include "Application.h"
+#include "RE_Memory.h"
+#include "RE_FileBuffer.h"
+
+#include <MD5/md5.h>
+#include <PhysFS/physfs.h>
+
+bool RE_AssetDatabase::Load(const char* db_path)
+{
+	if (!PHYSFS_exists(db_path)) return false;
+
+	RE_FileBuffer dbFile(db_path);
+	if (!dbFile.Load()) return false;
+
+	const char* cursor = dbFile.GetBuffer();
+	const char* end = cursor + dbFile.GetSize();
+
+	uint fileVersion = 0, count = 0;
+	size_t size = sizeof(uint);
+	if (cursor + size * 2 > end) return false;
+	memcpy(&fileVersion, cursor, size);
+	cursor += size;
+	if (fileVersion != version)
+	{
+		RE_LOG_WARNING("Asset database version mismatch (%u != %u). Rebuilding.", fileVersion, version);
+		return false;
+	}
+	memcpy(&count, cursor, size);
+	cursor += size;
+
+	entries.clear();
+	for (uint i = 0; i < count; i++)
+	{
+		uint pathSize = 0;
+		size = sizeof(uint);
+		if (cursor + size > end) break;
+		memcpy(&pathSize, cursor, size);
+		cursor += size;
+
+		if (cursor + pathSize + sizeof(signed long long) * 2 + sizeof(ulonglong) + sizeof(uint) > end) break;
+		eastl::string path(cursor, pathSize);
+		cursor += pathSize;
+
+		Entry entry;
+		size = sizeof(signed long long);
+		memcpy(&entry.size, cursor, size);
+		cursor += size;
+		memcpy(&entry.modtime, cursor, size);
+		cursor += size;
+
+		size = sizeof(ulonglong);
+		memcpy(&entry.hash, cursor, size);
+		cursor += size;
+
+		uint md5Size = 0;
+		size = sizeof(uint);
+		memcpy(&md5Size, cursor, size);
+		cursor += size;
+
+		if (cursor + md5Size > end) break;
+		entry.md5.assign(cursor, md5Size);
+		cursor += md5Size;
+
+		entries.insert({ path, entry });
+	}
+
+	dirty = false;
+	RE_LOG("Loaded asset database with %u entries.", static_cast<uint>(entries.size()));
+	return true;
+}
+
+void RE_AssetDatabase::Save(const char* db_path)
+{
+	if (!dirty) return;
+
+	size_t bufferSize = sizeof(uint) * 2;
+	for (const auto& entry : entries)
+		bufferSize += sizeof(uint) * 2 + entry.first.size() + entry.second.md5.size()
+			+ sizeof(signed long long) * 2 + sizeof(ulonglong);
+
+	char* buffer = new char[bufferSize];
+	char* cursor = buffer;
+
+	size_t size = sizeof(uint);
+	uint value = version;
+	memcpy(cursor, &value, size);
+	cursor += size;
+	value = static_cast<uint>(entries.size());
+	memcpy(cursor, &value, size);
+	cursor += size;
+
+	for (const auto& entry : entries)
+	{
+		size = sizeof(uint);
+		value = static_cast<uint>(entry.first.size());
+		memcpy(cursor, &value, size);
+		cursor += size;
+		memcpy(cursor, entry.first.c_str(), value);
+		cursor += value;
+
+		size = sizeof(signed long long);
+		memcpy(cursor, &entry.second.size, size);
+		cursor += size;
+		memcpy(cursor, &entry.second.modtime, size);
+		cursor += size;
+
+		size = sizeof(ulonglong);
+		memcpy(cursor, &entry.second.hash, size);
+		cursor += size;
+
+		size = sizeof(uint);
+		value = static_cast<uint>(entry.second.md5.size());
+		memcpy(cursor, &value, size);
+		cursor += size;
+		memcpy(cursor, entry.second.md5.c_str(), value);
+		cursor += value;
+	}
+
+	RE_FileBuffer dbFile(db_path);
+	dbFile.Save(buffer, bufferSize);
+	DEL_A(buffer);
+	dirty = false;
+}
+
+void RE_AssetDatabase::Clear()
+{
+	entries.clear();
+	dirty = false;
+}
+
+void RE_AssetDatabase::Remove(const char* path)
+{
+	auto entry = entries.find(path);
+	if (entry == entries.end()) return;
+	entries.erase(entry);
+	dirty = true;
+}
+
+eastl::string RE_AssetDatabase::GetMD5(const char* path, const char* buffer, size_t size)
+{
+	PHYSFS_Stat stat;
+	if (PHYSFS_stat(path, &stat) == 0)
+	{
+		RE_LOG_ERROR("Asset database can't stat %s: %s", path, PHYSFS_getLastError());
+		return "";
+	}
+
+	auto cached = entries.find(path);
+	if (cached != entries.end() && !cached->second.md5.empty() &&
+		cached->second.size == stat.filesize && cached->second.modtime == stat.modtime)
+		return cached->second.md5;
+
+	RE_FileBuffer file(path);
+	if (buffer == nullptr)
+	{
+		if (!file.Load()) return "";
+		buffer = file.GetBuffer();
+		size = file.GetSize();
+	}
+
+	// Only inserted once the content is known, a failed load leaves no empty entry behind
+	Entry& entry = (cached != entries.end()) ? cached->second : entries[path];
+	ulonglong hash = Hash(buffer, size);
+	if (entry.md5.empty() || entry.hash != hash)
+	{
+		entry.md5 = md5(eastl::string(buffer, size));
+		entry.hash = hash;
+	}
+
+	entry.size = stat.filesize;
+	entry.modtime = stat.modtime;
+	dirty = true;
+
+	return entry.md5;
+}
+
+// MurmurHash64A: 8 bytes per step, good distribution for change detection
+ulonglong RE_AssetDatabase::Hash(const char* buffer, size_t size, ulonglong seed)
+{
+	const ulonglong m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+
+	ulonglong h = seed ^ (size * m);
+
+	const char* cursor = buffer;
+	const char* end = buffer + (size / 8) * 8;
+	for (; cursor != end; cursor += 8)
+	{
+		ulonglong k;
+		memcpy(&k, cursor, sizeof(ulonglong));
+
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+
+		h ^= k;
+		h *= m;
+	}
+
+	const unsigned char* tail = reinterpret_cast<const unsigned char*>(cursor);
+	switch (size & 7)
+	{
+	case 7: h ^= static_cast<ulonglong>(tail[6]) << 48; [[fallthrough]];
+	case 6: h ^= static_cast<ulonglong>(tail[5]) << 40; [[fallthrough]];
+	case 5: h ^= static_cast<ulonglong>(tail[4]) << 32; [[fallthrough]];
+	case 4: h ^= static_cast<ulonglong>(tail[3]) << 24; [[fallthrough]];
+	case 3: h ^= static_cast<ulonglong>(tail[2]) << 16; [[fallthrough]];
+	case 2: h ^= static_cast<ulonglong>(tail[1]) << 8; [[fallthrough]];
+	case 1: h ^= static_cast<ulonglong>(tail[0]);
+		h *= m;
+	default: break;
+	}
+
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+
+	return h;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef __RE_ASSET_DATABASE_H__
+#define __RE_ASSET_DATABASE_H__
+
+#include "RE_DataTypes.h"
+#include <EASTL/string.h>
+#include <EASTL/hash_map.h>
+
+// Persistent record of every asset's size, modification time and content hash.
+// MD5 identities are only recomputed when the cheap content hash changes.
+class RE_AssetDatabase
+{
+public:
+
+	struct Entry
+	{
+		signed long long size = 0;
+		signed long long modtime = 0;
+		ulonglong hash = 0;
+		eastl::string md5;
+	};
+
+	RE_AssetDatabase() {}
+	~RE_AssetDatabase() {}
+
+	bool Load(const char* db_path);
+	void Save(const char* db_path);
+	void Clear();
+
+	void Remove(const char* path);
+
+	// Returns cached MD5 when size & modtime match. Otherwise hashes the content
+	// (loading it unless already given) and only runs MD5 if that hash changed.
+	eastl::string GetMD5(const char* path, const char* buffer = nullptr, size_t size = 0);
+
+	static ulonglong Hash(const char* buffer, size_t size, ulonglong seed = 0);
+
+	size_t GetCount() const { return entries.size(); }
+
+private:
+
+	static const uint version = 1u;
+
+	eastl::hash_map<eastl::string, Entry> entries;
+	bool dirty = false;
+};
+
+#endif // !__RE_ASSET_DATABASE_H__
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "RE_AssetWatcher.h"
+
+#include "RE_ConsoleLog.h"
+
+#include <PhysFS/physfs.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+bool RE_AssetWatcher::Init(unsigned int debounce_ms)
+{
+	debounce = debounce_ms;
+	timer.Start();
+
+#ifdef __linux__
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0)
+	{
+		RE_LOG_WARNING("Can't initialize inotify (%s). Assets will be polled.", strerror(errno));
+		return false;
+	}
+
+	RE_LOG("Watching asset changes through inotify");
+	return true;
+#else
+	return false;
+#endif
+}
+
+void RE_AssetWatcher::CleanUp()
+{
+#ifdef __linux__
+	if (fd >= 0)
+	{
+		for (auto watch : watches) inotify_rm_watch(fd, watch.first);
+		close(fd);
+		fd = -1;
+	}
+	watches.clear();
+#endif
+
+	pendingChanges.clear();
+	pendingRemovals.clear();
+}
+
+bool RE_AssetWatcher::IsActive() const
+{
+#ifdef __linux__
+	return fd >= 0;
+#else
+	return false;
+#endif
+}
+
+void RE_AssetWatcher::Watch(RE_FileSystem::RE_Directory* dir)
+{
+#ifdef __linux__
+	if (fd < 0) return;
+
+	const char* realDir = PHYSFS_getRealDir(dir->path.c_str());
+	if (realDir == nullptr) return;
+
+	eastl::string osPath(realDir);
+	if (!osPath.empty() && osPath.back() != '/') osPath += '/';
+	osPath += dir->path;
+
+	int wd = inotify_add_watch(fd, osPath.c_str(),
+		IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_ONLYDIR);
+
+	if (wd < 0) RE_LOG_WARNING("Can't watch %s: %s", osPath.c_str(), strerror(errno));
+	else watches[wd] = dir;
+#endif
+}
+
+void RE_AssetWatcher::Unwatch(RE_FileSystem::RE_Directory* dir)
+{
+	pendingChanges.erase(dir);
+
+#ifdef __linux__
+	for (auto watch = watches.begin(); watch != watches.end(); ++watch)
+	{
+		if (watch->second == dir)
+		{
+			if (fd >= 0) inotify_rm_watch(fd, watch->first);
+			watches.erase(watch);
+			break;
+		}
+	}
+#endif
+}
+
+void RE_AssetWatcher::Poll(eastl::vector<RE_FileSystem::RE_Directory*>& changed, eastl::vector<eastl::string>& removed)
+{
+	if (!IsActive()) return;
+
+	ReadEvents();
+
+	unsigned int now = timer.Read();
+
+	for (auto pending = pendingChanges.begin(); pending != pendingChanges.end();)
+	{
+		if (now - pending->second >= debounce)
+		{
+			changed.push_back(pending->first);
+			pending = pendingChanges.erase(pending);
+		}
+		else ++pending;
+	}
+
+	for (auto pending = pendingRemovals.begin(); pending != pendingRemovals.end();)
+	{
+		if (now - pending->last_event >= debounce)
+		{
+			// Saved through a temporary file: the asset is back in place
+			if (!PHYSFS_exists(pending->path.c_str())) removed.push_back(pending->path);
+			pending = pendingRemovals.erase(pending);
+		}
+		else ++pending;
+	}
+}
+
+void RE_AssetWatcher::ReadEvents()
+{
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+	unsigned int now = timer.Read();
+
+	for (;;)
+	{
+		ssize_t length = read(fd, buffer, sizeof(buffer));
+		if (length <= 0)
+		{
+			if (length < 0 && errno != EAGAIN) RE_LOG_ERROR("Error reading asset changes: %s", strerror(errno));
+			break;
+		}
+
+		for (char* cursor = buffer; cursor < buffer + length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+			cursor += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				// Events were dropped, every watched directory has to be checked
+				for (auto watch : watches) pendingChanges[watch.second] = now;
+				continue;
+			}
+
+			auto watch = watches.find(event->wd);
+			if (watch == watches.end()) continue;
+
+			if (event->mask & IN_IGNORED)
+			{
+				watches.erase(watch);
+				continue;
+			}
+
+			if (event->len == 0) continue;
+
+			RE_FileSystem::RE_Directory* dir = watch->second;
+			pendingChanges[dir] = now;
+
+			if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+			{
+				eastl::string path(dir->path);
+				path += event->name;
+				if (event->mask & IN_ISDIR) path += "/";
+
+				bool found = false;
+				for (auto& pending : pendingRemovals)
+				{
+					if (pending.path == path)
+					{
+						pending.last_event = now;
+						found = true;
+						break;
+					}
+				}
+
+				if (!found) pendingRemovals.push_back({ path, now });
+			}
+		}
+	}
+#endif
+}
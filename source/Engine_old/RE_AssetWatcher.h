@@ -0,0 +1,57 @@
+#ifndef __RE_ASSET_WATCHER_H__
+#define __RE_ASSET_WATCHER_H__
+
+#include "RE_FileSystem.h"
+#include "RE_Timer.h"
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <EASTL/hash_map.h>
+
+// Native change notifications for the Assets tree (inotify on Linux).
+// Events are held until their directory has been quiet for the debounce window,
+// so editors saving through temporary files settle into a single change.
+// When no backend is available IsActive() stays false and assets keep being polled.
+class RE_AssetWatcher
+{
+public:
+
+	RE_AssetWatcher() {}
+	~RE_AssetWatcher() { CleanUp(); }
+
+	bool Init(unsigned int debounce_ms = 100u);
+	void CleanUp();
+
+	bool IsActive() const;
+
+	void Watch(RE_FileSystem::RE_Directory* dir);
+	void Unwatch(RE_FileSystem::RE_Directory* dir);
+
+	// Fills directories that need CheckAndApply and asset paths removed from disk
+	void Poll(eastl::vector<RE_FileSystem::RE_Directory*>& changed, eastl::vector<eastl::string>& removed);
+
+private:
+
+	void ReadEvents();
+
+	struct PendingRemoval
+	{
+		eastl::string path;
+		unsigned int last_event = 0u;
+	};
+
+private:
+
+	unsigned int debounce = 100u;
+	RE_Timer timer;
+
+	eastl::hash_map<RE_FileSystem::RE_Directory*, unsigned int> pendingChanges;
+	eastl::vector<PendingRemoval> pendingRemovals;
+
+#ifdef __linux__
+	int fd = -1;
+	eastl::hash_map<int, RE_FileSystem::RE_Directory*> watches;
+#endif
+};
+
+#endif // !__RE_ASSET_WATCHER_H__
@@ -451,7 +451,7 @@ void RE_CompCamera::SerializeBinary(char*& cursor, eastl::map<const char*, int>*
 	cursor += size;
 }
 
-void RE_CompCamera::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompCamera::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(bool);
 	memcpy(&isPerspective, cursor, size);
@@ -502,16 +502,16 @@ void RE_CompCamera::SerializeJson(RE_Json * node, eastl::map<const char*, int>*
 	node->Push("skyboxResource", (skyboxMD5) ? resources->at(skyboxMD5) : -1);
 }
 
-void RE_CompCamera::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompCamera::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	usingSkybox = node->PullBool("usingSkybox", true);
-	int sbRes = node->PullInt("skyboxResource", -1);
+	usingSkybox = node.PullBool("usingSkybox", true);
+	int sbRes = node.PullInt("skyboxResource", -1);
 
-	SetProperties(node->PullBool("isPrespective", true),
-		node->PullFloat("near_plane", 1.0f), node->PullFloat("far_plane", 5000.0f),
-		node->PullFloat("v_fov_rads", 0.523599f),
-		AspectRatio(node->PullUInt("aspect_ratio", 0)),
-		node->PullBool("draw_frustum", true),
+	SetProperties(node.PullBool("isPrespective", true),
+		node.PullFloat("near_plane", 1.0f), node.PullFloat("far_plane", 5000.0f),
+		node.PullFloat("v_fov_rads", 0.523599f),
+		AspectRatio(node.PullUInt("aspect_ratio", 0)),
+		node.PullBool("draw_frustum", true),
 		usingSkybox,
 		(sbRes != -1) ? resources->at(sbRes) : nullptr);
 }
@@ -103,17 +103,17 @@ void RE_CompLight::SerializeJson(RE_Json* node, eastl::map<const char*, int>* re
 	node->Push("outerCutOff", outerCutOff[0]);
 }
 
-void RE_CompLight::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompLight::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	light_type = static_cast<Type>(node->PullUInt("light_type", static_cast<uint>(Type::POINT)));
-	intensity = node->PullFloat("intensity", intensity);
-	constant = node->PullFloat("constant", constant);
-	linear = node->PullFloat("linear", linear);
-	quadratic = node->PullFloat("quadratic", quadratic);
-	diffuse = node->PullFloatVector("diffuse", diffuse);
-	specular = node->PullFloat("specular", specular);
-	cutOff[0] = node->PullFloat("cutOff", cutOff[0]);
-	outerCutOff[0] = node->PullFloat("outerCutOff", outerCutOff[0]);
+	light_type = static_cast<Type>(node.PullUInt("light_type", static_cast<uint>(Type::POINT)));
+	intensity = node.PullFloat("intensity", intensity);
+	constant = node.PullFloat("constant", constant);
+	linear = node.PullFloat("linear", linear);
+	quadratic = node.PullFloat("quadratic", quadratic);
+	diffuse = node.PullFloatVector("diffuse", diffuse);
+	specular = node.PullFloat("specular", specular);
+	cutOff[0] = node.PullFloat("cutOff", cutOff[0]);
+	outerCutOff[0] = node.PullFloat("outerCutOff", outerCutOff[0]);
 	UpdateCutOff();
 }
 
@@ -142,7 +142,7 @@ void RE_CompLight::SerializeBinary(char*& cursor, eastl::map<const char*, int>*
 	cursor += size;
 }
 
-void RE_CompLight::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompLight::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(ushort);
 	memcpy(&light_type, cursor, size);
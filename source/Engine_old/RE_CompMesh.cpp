@@ -145,11 +145,11 @@ void RE_CompMesh::SerializeJson(RE_Json* node, eastl::map<const char*, int>* res
 	node->Push("materialResource", (materialMD5) ? resources->at(materialMD5) : -1);
 }
 
-void RE_CompMesh::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompMesh::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	int id = node->PullInt("meshResource", -1);
+	int id = node.PullInt("meshResource", -1);
 	meshMD5 = (id != -1) ? resources->at(id) : nullptr;
-	id = node->PullInt("materialResource", -1);
+	id = node.PullInt("materialResource", -1);
 	materialMD5 = (id != -1) ? resources->at(id) : nullptr;
 }
 
@@ -170,7 +170,7 @@ void RE_CompMesh::SerializeBinary(char*& cursor, eastl::map<const char*, int>* r
 	cursor += size;
 }
 
-void RE_CompMesh::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompMesh::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(int);
 	int md5 = -1;
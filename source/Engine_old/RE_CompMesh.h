@@ -24,11 +24,11 @@ public:
 	eastl::vector<const char*> GetAllResources() final;
 	
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 
 	size_t GetBinarySize() const override;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	math::AABB GetAABB() const;
 	bool CheckFaceCollision(const math::Ray &local_ray, float &distance) const;
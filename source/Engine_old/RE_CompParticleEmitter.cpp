@@ -91,9 +91,9 @@ void RE_CompParticleEmitter::SerializeJson(RE_Json* node, eastl::map<const char*
 	node->Push("emitterResource", (emitter_md5) ? resources->at(emitter_md5) : -1);
 }
 
-void RE_CompParticleEmitter::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompParticleEmitter::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	int id = node->PullInt("emitterResource", -1);
+	int id = node.PullInt("emitterResource", -1);
 	emitter_md5 = (id != -1) ? resources->at(id) : nullptr;
 }
 
@@ -107,7 +107,7 @@ void RE_CompParticleEmitter::SerializeBinary(char*& cursor, eastl::map<const cha
 	cursor += size;
 }
 
-void RE_CompParticleEmitter::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompParticleEmitter::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(int);
 	int md5 = -1;
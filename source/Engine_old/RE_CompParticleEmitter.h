@@ -18,11 +18,11 @@ public:
 	void DrawProperties() final;
 
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 
 	size_t GetBinarySize() const final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	eastl::vector<const char*> GetAllResources() final;
 	void UseResources();
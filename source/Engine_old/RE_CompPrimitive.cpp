@@ -128,10 +128,10 @@ void RE_CompGrid::SerializeJson(RE_Json* node, eastl::map<const char*, int>* res
 	node->Push("divisions", divisions);
 }
 
-void RE_CompGrid::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompGrid::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	color = node->PullFloatVector("color", color);
-	GridSetUp(node->PullInt("divisions", divisions));
+	color = node.PullFloatVector("color", color);
+	GridSetUp(node.PullInt("divisions", divisions));
 }
 
 void RE_CompGrid::SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const
@@ -145,7 +145,7 @@ void RE_CompGrid::SerializeBinary(char*& cursor, eastl::map<const char*, int>* r
 	cursor += size;
 }
 
-void RE_CompGrid::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompGrid::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(float) * 3;
 	memcpy(&color[0], cursor, size);
@@ -268,10 +268,10 @@ void RE_CompRock::SerializeJson(RE_Json* node, eastl::map<const char*, int>* res
 	node->Push("nsubdivisions", nsubdivisions);
 }
 
-void RE_CompRock::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompRock::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	color = node->PullFloatVector("color", { 1.0f,1.0f,1.0f });
-	RockSetUp(node->PullInt("seed", seed), node->PullInt("nsubdivisions", nsubdivisions));
+	color = node.PullFloatVector("color", { 1.0f,1.0f,1.0f });
+	RockSetUp(node.PullInt("seed", seed), node.PullInt("nsubdivisions", nsubdivisions));
 }
 
 void RE_CompRock::SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const
@@ -289,7 +289,7 @@ void RE_CompRock::SerializeBinary(char*& cursor, eastl::map<const char*, int>* r
 	cursor += size;
 }
 
-void RE_CompRock::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompRock::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(float) * 3;
 	memcpy(&color[0], cursor, size);
@@ -427,9 +427,9 @@ void RE_CompPlatonic::SerializeJson(RE_Json* node, eastl::map<const char*, int>*
 	node->PushFloatVector("color", color);
 }
 
-void RE_CompPlatonic::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompPlatonic::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	color = node->PullFloatVector("color", color);
+	color = node.PullFloatVector("color", color);
 	PlatonicSetUp();
 }
 
@@ -440,7 +440,7 @@ void RE_CompPlatonic::SerializeBinary(char*& cursor, eastl::map<const char*, int
 	cursor += size;
 }
 
-void RE_CompPlatonic::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompPlatonic::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(float) * 3;
 	memcpy(&color[0], cursor, size);
@@ -558,10 +558,10 @@ void RE_CompParametric::SerializeJson(RE_Json* node, eastl::map<const char*, int
 	node->Push("radius", radius);
 }
 
-void RE_CompParametric::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_CompParametric::DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	color = node->PullFloatVector("color", color);
-	ParametricSetUp(node->PullInt("slices", slices), node->PullInt("stacks", stacks), node->PullFloat("radius", radius));
+	color = node.PullFloatVector("color", color);
+	ParametricSetUp(node.PullInt("slices", slices), node.PullInt("stacks", stacks), node.PullFloat("radius", radius));
 }
 
 void RE_CompParametric::SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const
@@ -583,7 +583,7 @@ void RE_CompParametric::SerializeBinary(char*& cursor, eastl::map<const char*, i
 	cursor += size;
 }
 
-void RE_CompParametric::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_CompParametric::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	size_t size = sizeof(float) * 3;
 	memcpy(&RE_CompPrimitive::color[0], cursor, size);
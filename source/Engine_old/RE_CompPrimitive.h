@@ -66,9 +66,9 @@ public:
 
 	size_t GetBinarySize() const final;
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	float GetDistance() const;
 
@@ -100,9 +100,9 @@ public:
 
 	size_t GetBinarySize() const final;
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	size_t GetParticleBinarySize() const final;
 	void SerializeParticleJson(RE_Json* node) const final;
@@ -141,9 +141,9 @@ public:
 
 	size_t GetBinarySize() const final;
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 protected:
 
@@ -170,9 +170,9 @@ public:
 
 	size_t GetBinarySize() const final;
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	size_t GetParticleBinarySize() const final;
 	void SerializeParticleJson(RE_Json* node) const final;
@@ -1,6 +1,8 @@
 #ifndef __RE_COMPWATER_H__
 #define __RE_COMPWATER_H__
 
+#include "RE_Reflection.h"
+
 class RE_CompWater : public RE_Component
 {
 public:
@@ -13,11 +15,11 @@ public:
 	void DrawProperties() final;
 
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources) const final;
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) final;
+	void DeserializeJson(const RE_JsonCursor& node, const eastl::vector<const char*>* resources) final;
 
 	size_t GetBinarySize() const final;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const final;
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) final;
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) final;
 
 	math::AABB GetAABB() const;
 	bool CheckFaceCollision(const math::Ray& local_ray, float& distance) const;
@@ -28,6 +30,29 @@ public:
 	unsigned int GetVAO() const;
 	size_t GetTriangles() const;
 
+	// direction and center are pushed to JSON together as "dirCe"
+	static constexpr auto Reflection()
+	{
+		return RE_Reflection::Fields(
+			RE_FIELD("slices", &RE_CompWater::slices),
+			RE_FIELD("stacks", &RE_CompWater::stacks),
+			RE_FIELD("waveLenght", &RE_CompWater::waveLenght),
+			RE_FIELD("amplitude", &RE_CompWater::amplitude),
+			RE_FIELD("speed", &RE_CompWater::speed),
+			RE_FIELD("is_linear", &RE_CompWater::is_linear),
+			RE_FIELD_FLAGS("direction", &RE_CompWater::direction, RE_Reflection::BINARY_ONLY),
+			RE_FIELD_FLAGS("center", &RE_CompWater::center, RE_Reflection::BINARY_ONLY),
+			RE_FIELD("steepness", &RE_CompWater::steepness),
+			RE_FIELD("numWaves", &RE_CompWater::numWaves),
+			RE_FIELD("cdiffuse", &RE_CompWater::cdiffuse),
+			RE_FIELD("shininess", &RE_CompWater::shininess),
+			RE_FIELD("foamMin", &RE_CompWater::foamMin),
+			RE_FIELD("foamMax", &RE_CompWater::foamMax),
+			RE_FIELD("foamColor", &RE_CompWater::foam_color),
+			RE_FIELD("opacity", &RE_CompWater::opacity),
+			RE_FIELD("distanceFoam", &RE_CompWater::distanceFoam));
+	}
+
 private:
 
 	void GeneratePlane();
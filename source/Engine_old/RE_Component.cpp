@@ -6,10 +6,15 @@ COMP_UID RE_Component::PoolSetUp(GameObjectsPool* pool, const GO_UID parent, boo
 {
 	pool_gos = pool;
 	useParent = (go = parent);
-	if (report_parent && useParent) pool_gos->AtPtr(go)->ReportComponent(id, type);
+	if (report_parent) ReportToParent();
 	return id;
 }
 
+void RE_Component::ReportToParent() const
+{
+	if (useParent) pool_gos->AtPtr(go)->ReportComponent(id, type);
+}
+
 RE_GameObject* RE_Component::GetGOPtr() const
 {
 	return pool_gos->AtPtr(go);
@@ -47,6 +47,7 @@ public:
 	virtual ~RE_Component() = default;
 
 	virtual COMP_UID PoolSetUp(class GameObjectsPool* pool, const GO_UID parent, bool report_parent = false);
+	void ReportToParent() const;
 	virtual void CopySetUp(GameObjectsPool* pool, RE_Component* copy, const GO_UID parent) {}
 
 	virtual void Init() {}
@@ -82,11 +83,11 @@ public:
 	virtual eastl::vector<const char*> GetAllResources() { return eastl::vector<const char*>(); }
 
 	virtual void SerializeJson(class RE_Json* node, eastl::map<const char*, int>* resources) const {}
-	virtual void DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources) {}
+	virtual void DeserializeJson(const class RE_JsonCursor& node, const eastl::vector<const char*>* resources) {}
 
 	virtual size_t GetBinarySize() const { return 0; }
 	virtual void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources) const {}
-	virtual void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources) {}
+	virtual void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources) {}
 
 	virtual void UseResources() {}
 	virtual void UnUseResources() {}
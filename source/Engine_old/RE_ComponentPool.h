@@ -5,8 +5,11 @@
 #include "RE_Random.h"
 #include "Application.h"
 #include "RE_Json.h"
+#include "RE_Reflection.h"
 #include "RE_HashMap.h"
 
+#include <stdio.h>
+
 class GameObjectsPool;
 
 template<class COMPCLASS, unsigned int size, unsigned int increment>
@@ -84,20 +87,56 @@ public:
 		DEL(compPool)
 	}
 
-	void DeserializeJson(GameObjectsPool* goPool, RE_Json* node, eastl::map<int, const char*>* resources)
+	RE_JsonCursor GetJsonNode(const RE_JsonCursor& node) const { return node.Child(cName.c_str()); }
+
+	// Bulk loads: entries are pushed on the loading thread, then a range can be decoded
+	// alongside other pools as it only touches its own entries. Reporting components to
+	// their gameobjects is left for a serial pass once every pool is done.
+	int PushLoadRange(size_t count)
+	{
+		RE_HashMap::Reserve(count);
+		int first = lastAvaibleIndex;
+		for (size_t i = 0; i < count; i++) Push({});
+		return first;
+	}
+
+	void DeserializeJsonRange(GameObjectsPool* goPool, const RE_JsonCursor& node, int first, size_t begin, size_t count, const eastl::vector<const char*>* resources)
 	{
-		RE_Json* comp_objs = node->PullJObject(cName.c_str());
-		auto cmpSize = comp_objs->PullSizeT("poolSize", 0);
-		for (size_t i = 0; i < cmpSize; i++)
+		char key[24];
+		for (size_t i = begin; i < begin + count; i++)
 		{
-			COMPCLASS* comp_ptr = AtPtr(Push({}));
-			RE_Json* comp_obj = comp_objs->PullJObject(eastl::to_string(i).c_str());
-			comp_ptr->PoolSetUp(goPool, comp_obj->PullUnsignedLongLong("parentPoolID", 0), true);
-			comp_ptr->DeserializeJson(comp_obj, resources);
+			// Components follow "poolSize" in order, so the hint finds them without a search
+			snprintf(key, sizeof(key), "%zu", i);
+			RE_JsonCursor comp_obj = node.Child(key, i + 1);
+
+			COMPCLASS& comp = pool_[first + i];
+			comp.PoolSetUp(goPool, comp_obj.PullUnsignedLongLong("parentPoolID", 0));
+			comp.DeserializeJson(comp_obj, resources);
+		}
+	}
+
+	// A block holds all its GO_UIDs before the records, so a range past the first one
+	// is only found from a fixed record size
+	void DeserializeBinaryRange(GameObjectsPool* goPool, char* cursor, int first, size_t total, size_t begin, size_t count, const eastl::vector<const char*>* resources)
+	{
+		const char* uids = cursor;
+		cursor += total * sizeof(GO_UID);
+		if (begin > 0) cursor += begin * pool_[first].GetBinarySize();
+
+		for (size_t i = begin; i < begin + count; i++)
+		{
+			GO_UID goID;
+			memcpy(&goID, uids + i * sizeof(GO_UID), sizeof(GO_UID));
 
-			DEL(comp_obj)
+			COMPCLASS& comp = pool_[first + i];
+			comp.PoolSetUp(goPool, goID);
+			comp.DeserializeBinary(cursor, resources);
 		}
-		DEL(comp_objs)
+	}
+
+	void ReportLoadRange(int first, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) pool_[first + i].ReportToParent();
 	}
 
 	size_t GetBinarySize() const
@@ -132,7 +171,7 @@ public:
 		}
 	}
 
-	void DeserializeBinary(GameObjectsPool* goPool, char*& cursor, eastl::map<int, const char*>* resources)
+	void DeserializeBinary(GameObjectsPool* goPool, char*& cursor, const eastl::vector<const char*>* resources)
 	{
 		// Count
 		size_t size = sizeof(size_t);
@@ -154,6 +193,30 @@ public:
 		}
 	}
 
+	// Scene block: every GO_UID, then every component, sized and allocated up front
+	size_t GetBinaryBlockSize() const
+	{
+		size_t count = GetCount();
+		size_t size = count * sizeof(GO_UID);
+		for (size_t i = 0; i < count; i++) size += pool_[i].GetBinarySize();
+		return size;
+	}
+
+	ulonglong GetBinarySchema() const { return RE_Reflection::SchemaHash<COMPCLASS>(); }
+
+	void SerializeBinaryBlock(char* cursor, eastl::map<const char*, int>* resources)
+	{
+		size_t count = GetCount();
+		for (size_t i = 0; i < count; i++)
+		{
+			GO_UID uid = pool_[i].GetGOUID();
+			memcpy(cursor, &uid, sizeof(GO_UID));
+			cursor += sizeof(GO_UID);
+		}
+
+		for (size_t i = 0; i < count; i++) pool_[i].SerializeBinary(cursor, resources);
+	}
+
 	eastl::vector<COMP_UID> GetAllKeys() const final
 	{
 		eastl::vector<COMP_UID> ret;
@@ -1,8 +1,45 @@
 #include "RE_ComponentsPool.h"
 
 #include "RE_Memory.h"
+#include "RE_Assert.h"
 #include "RE_Json.h"
 #include "RE_GameObject.h"
+#include "RE_WorkerPool.h"
+
+#include <EASTL/algorithm.h>
+#include <atomic>
+
+namespace
+{
+	// Primitives share the scene's primitive mesh cache, so those pools load on the calling thread
+	inline bool IsConcurrentPool(uint pool) { return pool < 5u; }
+
+	// Cameras update their gameobject's transform while loading, so their pool stays in one task
+	inline bool IsSplitPool(uint pool) { return pool != 0u; }
+
+	// Meshes, lights and particle emitters write a fixed size binary record, so a range can
+	// find its first record without walking the ones before it
+	inline bool IsFixedBinaryPool(uint pool) { return pool == 1u || pool == 2u || pool == 4u; }
+
+	// Entries per task when splitting a pool
+	const size_t loadRange = 1024u;
+
+	template<class Load, class Function>
+	void RunLoads(const eastl::vector<Load>& loads, Function function)
+	{
+		eastl::vector<const Load*> concurrent;
+		for (const Load& load : loads) if (IsConcurrentPool(load.pool)) concurrent.push_back(&load);
+
+		std::atomic<size_t> next = 0;
+		RE_WorkerPool::Get().Run([&]()
+			{
+				for (size_t i = next++; i < concurrent.size(); i = next++)
+					function(*concurrent[i]);
+			});
+
+		for (const Load& load : loads) if (!IsConcurrentPool(load.pool)) function(load);
+	}
+}
 
 ComponentsPool::ComponentsPool()
 {
@@ -749,29 +786,41 @@ void ComponentsPool::SerializeJson(RE_Json* node, eastl::map<const char*, int>*
 	DEL(comps)
 }
 
-void ComponentsPool::DeserializeJson(GameObjectsPool* goPool, RE_Json* node, eastl::map<int, const char*>* resources)
+void ComponentsPool::DeserializeJson(GameObjectsPool* goPool, const RE_JsonCursor& node, const eastl::vector<const char*>* resources)
 {
-	RE_Json* comps = node->PullJObject("Components Pool");
-	camPool.DeserializeJson(goPool, comps, resources);
-	meshPool.DeserializeJson(goPool, comps, resources);
-	lightPool.DeserializeJson(goPool, comps, resources);
-	waterPool.DeserializeJson(goPool, comps, resources);
-	particleSPool.DeserializeJson(goPool, comps, resources);
-	pGridPool.DeserializeJson(goPool, comps, resources);
-	pRockPool.DeserializeJson(goPool, comps, resources);
-	pCubePool.DeserializeJson(goPool, comps, resources);
-	pDodecahedronPool.DeserializeJson(goPool, comps, resources);
-	pTetrahedronPool.DeserializeJson(goPool, comps, resources);
-	pOctohedronPool.DeserializeJson(goPool, comps, resources);
-	pIcosahedronPool.DeserializeJson(goPool, comps, resources);
-	pPointPool.DeserializeJson(goPool, comps, resources);
-	pPlanePool.DeserializeJson(goPool, comps, resources);
-	pSpherePool.DeserializeJson(goPool, comps, resources);
-	pCylinderPool.DeserializeJson(goPool, comps, resources);
-	pHemiSpherePool.DeserializeJson(goPool, comps, resources);
-	pTorusPool.DeserializeJson(goPool, comps, resources);
-	pTrefoiKnotPool.DeserializeJson(goPool, comps, resources);
-	DEL(comps)
+	struct JsonLoad
+	{
+		uint pool;
+		RE_JsonCursor node;
+		int first;
+		size_t begin;
+		size_t count;
+	};
+
+	// Push every entry up front, large pools split in ranges
+	RE_JsonCursor comps = node.Child("Components Pool");
+	eastl::vector<JsonLoad> loads;
+	for (uint p = 0; p < binaryPoolCount; p++)
+	{
+		ForSerializedPool(*this, p, [&](auto& cPool)
+			{
+				RE_JsonCursor poolNode = cPool.GetJsonNode(comps);
+				size_t count = poolNode.PullSizeT("poolSize", 0);
+				int first = cPool.PushLoadRange(count);
+				size_t range = IsSplitPool(p) ? loadRange : count;
+				for (size_t begin = 0; begin < count; begin += range)
+					loads.push_back({ p, poolNode, first, begin, eastl::min(range, count - begin) });
+			});
+	}
+
+	RunLoads(loads, [&](const JsonLoad& load)
+		{
+			ForSerializedPool(*this, load.pool, [&](auto& cPool)
+				{ cPool.DeserializeJsonRange(goPool, load.node, load.first, load.begin, load.count, resources); });
+		});
+
+	for (const JsonLoad& load : loads)
+		ForSerializedPool(*this, load.pool, [&](auto& cPool) { cPool.ReportLoadRange(load.first + static_cast<int>(load.begin), load.count); });
 }
 
 size_t ComponentsPool::GetBinarySize() const
@@ -822,7 +871,7 @@ void ComponentsPool::SerializeBinary(char*& cursor, eastl::map<const char*, int>
 	pTrefoiKnotPool.SerializeBinary(cursor, resources);
 }
 
-void ComponentsPool::DeserializeBinary(GameObjectsPool* goPool, char*& cursor, eastl::map<int, const char*>* resources)
+void ComponentsPool::DeserializeBinary(GameObjectsPool* goPool, char*& cursor, const eastl::vector<const char*>* resources)
 {
 	camPool.DeserializeBinary(goPool, cursor, resources);
 	meshPool.DeserializeBinary(goPool, cursor, resources);
@@ -843,4 +892,93 @@ void ComponentsPool::DeserializeBinary(GameObjectsPool* goPool, char*& cursor, e
 	pHemiSpherePool.DeserializeBinary(goPool, cursor, resources);
 	pTorusPool.DeserializeBinary(goPool, cursor, resources);
 	pTrefoiKnotPool.DeserializeBinary(goPool, cursor, resources);
-}
\ No newline at end of file
+}
+
+template<class Self, class Function>
+void ComponentsPool::ForSerializedPool(Self& self, uint pool, Function function)
+{
+	switch (pool)
+	{
+	case 0: function(self.camPool); break;
+	case 1: function(self.meshPool); break;
+	case 2: function(self.lightPool); break;
+	case 3: function(self.waterPool); break;
+	case 4: function(self.particleSPool); break;
+	case 5: function(self.pGridPool); break;
+	case 6: function(self.pRockPool); break;
+	case 7: function(self.pCubePool); break;
+	case 8: function(self.pDodecahedronPool); break;
+	case 9: function(self.pTetrahedronPool); break;
+	case 10: function(self.pOctohedronPool); break;
+	case 11: function(self.pIcosahedronPool); break;
+	case 12: function(self.pPointPool); break;
+	case 13: function(self.pPlanePool); break;
+	case 14: function(self.pSpherePool); break;
+	case 15: function(self.pCylinderPool); break;
+	case 16: function(self.pHemiSpherePool); break;
+	case 17: function(self.pTorusPool); break;
+	case 18: function(self.pTrefoiKnotPool); break;
+	default: RE_ASSERT(false); break;
+	}
+}
+
+size_t ComponentsPool::GetBinaryBlockSize(uint pool) const
+{
+	size_t ret = 0;
+	ForSerializedPool(*this, pool, [&ret](const auto& cPool) { ret = cPool.GetBinaryBlockSize(); });
+	return ret;
+}
+
+size_t ComponentsPool::GetBinaryBlockCount(uint pool) const
+{
+	size_t ret = 0;
+	ForSerializedPool(*this, pool, [&ret](const auto& cPool) { ret = cPool.GetCount(); });
+	return ret;
+}
+
+ulonglong ComponentsPool::GetBinaryBlockSchema(uint pool) const
+{
+	ulonglong ret = 0;
+	ForSerializedPool(*this, pool, [&ret](const auto& cPool) { ret = cPool.GetBinarySchema(); });
+	return ret;
+}
+
+void ComponentsPool::SerializeBinaryBlock(uint pool, char* cursor, eastl::map<const char*, int>* resources)
+{
+	ForSerializedPool(*this, pool, [&](auto& cPool) { cPool.SerializeBinaryBlock(cursor, resources); });
+}
+
+void ComponentsPool::DeserializeBinaryBlocks(GameObjectsPool* goPool, const eastl::vector<BinaryBlock>& blocks, const eastl::vector<const char*>* resources)
+{
+	struct BinaryLoad
+	{
+		uint pool;
+		char* cursor;
+		int first;
+		size_t total;
+		size_t begin;
+		size_t count;
+	};
+
+	// Push every entry up front, blocks of fixed size records split in ranges
+	eastl::vector<BinaryLoad> loads;
+	for (const BinaryBlock& block : blocks)
+	{
+		ForSerializedPool(*this, block.pool, [&](auto& cPool)
+			{
+				int first = cPool.PushLoadRange(block.count);
+				size_t range = IsFixedBinaryPool(block.pool) ? loadRange : block.count;
+				for (size_t begin = 0; begin < block.count; begin += range)
+					loads.push_back({ block.pool, block.cursor, first, block.count, begin, eastl::min(range, block.count - begin) });
+			});
+	}
+
+	RunLoads(loads, [&](const BinaryLoad& load)
+		{
+			ForSerializedPool(*this, load.pool, [&](auto& cPool)
+				{ cPool.DeserializeBinaryRange(goPool, load.cursor, load.first, load.total, load.begin, load.count, resources); });
+		});
+
+	for (const BinaryLoad& load : loads)
+		ForSerializedPool(*this, load.pool, [&](auto& cPool) { cPool.ReportLoadRange(load.first + static_cast<int>(load.begin), load.count); });
+}
@@ -38,14 +38,34 @@ public:
 
 	// Serialization
 	void SerializeJson(RE_Json* node, eastl::map<const char*, int>* resources);
-	void DeserializeJson(GameObjectsPool* goPool, RE_Json* node, eastl::map<int, const char*>* resources);
+	void DeserializeJson(GameObjectsPool* goPool, const RE_JsonCursor& node, const eastl::vector<const char*>* resources);
 
 	size_t GetBinarySize() const;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources);
-	void DeserializeBinary(GameObjectsPool* goPool, char*& cursor, eastl::map<int, const char*>* resources);
+	void DeserializeBinary(GameObjectsPool* goPool, char*& cursor, const eastl::vector<const char*>* resources);
+
+	// Scene blocks, one per serialized pool in the same order as SerializeBinary
+	static const uint binaryPoolCount = 19u;
+
+	size_t GetBinaryBlockSize(uint pool) const;
+	size_t GetBinaryBlockCount(uint pool) const;
+	ulonglong GetBinaryBlockSchema(uint pool) const;
+	void SerializeBinaryBlock(uint pool, char* cursor, eastl::map<const char*, int>* resources);
+
+	// Pools decode concurrently, then components are reported to their gameobjects in pool order
+	struct BinaryBlock
+	{
+		uint pool;
+		char* cursor;
+		size_t count;
+	};
+	void DeserializeBinaryBlocks(GameObjectsPool* goPool, const eastl::vector<BinaryBlock>& blocks, const eastl::vector<const char*>* resources);
 
 private:
 
+	template<class Self, class Function>
+	static void ForSerializedPool(Self& self, uint pool, Function function);
+
 	TransformsPool transPool;
 	CamerasPool camPool;
 	MeshesPool meshPool;
@@ -0,0 +1,302 @@
+#include "RE_Compression.h"
+
+#include "RE_DataTypes.h"
+#include "RE_Memory.h"
+
+#include <EASTL/vector.h>
+#include <string.h>
+
+namespace
+{
+	struct Header
+	{
+		char magic[4];
+		unsigned char level;
+		unsigned char padding[3];
+		ulonglong rawSize;
+	};
+
+	const uint minMatch = 4u;
+	const uint lastLiterals = 5u;
+	const uint matchFindLimit = 12u;
+	const uint maxOffset = 65535u;
+	const uint hashLog = 16u;
+	const uint windowMask = 0xFFFFu;
+	const uint noPosition = 0xFFFFFFFFu;
+	const ulonglong maxExpansion = 255u;
+
+	inline uint Read32(const unsigned char* p)
+	{
+		uint ret;
+		memcpy(&ret, p, sizeof(uint));
+		return ret;
+	}
+
+	inline uint HashSequence(uint sequence) { return (sequence * 2654435761u) >> (32u - hashLog); }
+
+	inline unsigned char* WriteLength(unsigned char* op, size_t length)
+	{
+		for (; length >= 255u; length -= 255u) *op++ = 255u;
+		*op++ = static_cast<unsigned char>(length);
+		return op;
+	}
+
+	unsigned char* WriteSequence(unsigned char* op, const unsigned char* literals, size_t literalCount, uint offset, size_t matchLength)
+	{
+		unsigned char* token = op++;
+		*token = static_cast<unsigned char>((literalCount >= 15u ? 15u : literalCount) << 4);
+		if (literalCount >= 15u) op = WriteLength(op, literalCount - 15u);
+
+		memcpy(op, literals, literalCount);
+		op += literalCount;
+
+		if (matchLength > 0)
+		{
+			*op++ = static_cast<unsigned char>(offset & 0xFFu);
+			*op++ = static_cast<unsigned char>(offset >> 8);
+
+			matchLength -= minMatch;
+			*token |= static_cast<unsigned char>(matchLength >= 15u ? 15u : matchLength);
+			if (matchLength >= 15u) op = WriteLength(op, matchLength - 15u);
+		}
+
+		return op;
+	}
+
+	// Greedy parse over hash chains: FAST only tries the newest candidate and skips
+	// ahead on misses, HIGH walks deeper chains and indexes every matched position.
+	size_t CompressBlock(const unsigned char* source, size_t size, unsigned char* destination, RE_Compression::Level level)
+	{
+		const bool high = (level == RE_Compression::Level::HIGH);
+		const uint searchDepth = high ? 64u : 1u;
+
+		unsigned char* op = destination;
+		const unsigned char* anchor = source;
+
+		if (size > matchFindLimit)
+		{
+			eastl::vector<uint> head(1u << hashLog, noPosition);
+			eastl::vector<uint> chain(windowMask + 1u, noPosition);
+
+			const unsigned char* ip = source;
+			const unsigned char* mfLimit = source + size - matchFindLimit;
+			const unsigned char* matchLimit = source + size - lastLiterals;
+
+			auto insert = [&](const unsigned char* p)
+			{
+				uint position = static_cast<uint>(p - source);
+				uint hash = HashSequence(Read32(p));
+				chain[position & windowMask] = head[hash];
+				head[hash] = position;
+			};
+
+			while (ip < mfLimit)
+			{
+				uint position = static_cast<uint>(ip - source);
+				uint sequence = Read32(ip);
+				uint candidate = head[HashSequence(sequence)];
+
+				size_t bestLength = 0;
+				uint bestOffset = 0;
+				for (uint depth = searchDepth; depth > 0 && candidate != noPosition && position - candidate <= maxOffset; depth--)
+				{
+					const unsigned char* match = source + candidate;
+					if (Read32(match) == sequence)
+					{
+						const unsigned char* cursor = ip + minMatch;
+						match += minMatch;
+						while (cursor < matchLimit && *cursor == *match) { cursor++; match++; }
+
+						size_t length = cursor - ip;
+						if (length > bestLength)
+						{
+							bestLength = length;
+							bestOffset = position - candidate;
+						}
+					}
+
+					uint next = chain[candidate & windowMask];
+					if (next >= candidate) break;
+					candidate = next;
+				}
+
+				insert(ip);
+
+				if (bestLength < minMatch)
+				{
+					ip += high ? 1u : 1u + ((ip - anchor) >> 6);
+					continue;
+				}
+
+				op = WriteSequence(op, anchor, ip - anchor, bestOffset, bestLength);
+
+				const unsigned char* matchEnd = ip + bestLength;
+				if (high) for (ip++; ip < matchEnd && ip < mfLimit; ip++) insert(ip);
+				ip = anchor = matchEnd;
+			}
+		}
+
+		op = WriteSequence(op, anchor, source + size - anchor, 0u, 0u);
+		return op - destination;
+	}
+
+	// Corrupt entries must not size allocations: the raw size has to fit in memory and in what the
+	// payload can expand to. Literals never grow and each match byte yields at most 255 bytes.
+	bool ReadHeader(const char* source, size_t size, Header& header)
+	{
+		memcpy(&header, source, sizeof(Header));
+		if (header.rawSize >= static_cast<ulonglong>(static_cast<size_t>(-1))) return false;
+
+		const ulonglong payloadSize = size - sizeof(Header);
+		switch (static_cast<RE_Compression::Level>(header.level))
+		{
+		case RE_Compression::Level::STORE: return header.rawSize == payloadSize;
+		case RE_Compression::Level::FAST:
+		case RE_Compression::Level::HIGH: return header.rawSize <= payloadSize * maxExpansion + 16u;
+		default: return false;
+		}
+	}
+
+	bool DecompressBlock(const unsigned char* ip, size_t size, unsigned char* destination, size_t rawSize)
+	{
+		const unsigned char* iend = ip + size;
+		unsigned char* op = destination;
+		unsigned char* oend = destination + rawSize;
+
+		auto readLength = [&](size_t& length)
+		{
+			unsigned char byte;
+			do
+			{
+				if (ip >= iend) return false;
+				byte = *ip++;
+				length += byte;
+			} while (byte == 255u);
+			return true;
+		};
+
+		while (ip < iend)
+		{
+			unsigned char token = *ip++;
+
+			size_t literalCount = token >> 4;
+			if (literalCount == 15u && !readLength(literalCount)) return false;
+			if (literalCount > static_cast<size_t>(iend - ip) || literalCount > static_cast<size_t>(oend - op)) return false;
+
+			memcpy(op, ip, literalCount);
+			ip += literalCount;
+			op += literalCount;
+
+			if (ip >= iend) break; // Last sequence only holds literals
+
+			if (iend - ip < 2) return false;
+			size_t offset = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<size_t>(op - destination)) return false;
+
+			size_t matchLength = token & 15u;
+			if (matchLength == 15u && !readLength(matchLength)) return false;
+			matchLength += minMatch;
+			if (matchLength > static_cast<size_t>(oend - op)) return false;
+
+			const unsigned char* match = op - offset;
+			if (offset >= matchLength) memcpy(op, match, matchLength);
+			else for (size_t i = 0; i < matchLength; i++) op[i] = match[i]; // Overlapping copy repeats the pattern
+			op += matchLength;
+		}
+
+		return op == oend;
+	}
+}
+
+RE_Compression::Level RE_Compression::ChooseLevel(const char* source, size_t size)
+{
+	// Header overhead outweighs anything small entries could save
+	if (size < 512u) return Level::STORE;
+
+	size_t sampleSize = size < 65536u ? size : 65536u;
+	eastl::vector<unsigned char> sample(CompressBound(sampleSize));
+	size_t compressed = CompressBlock(reinterpret_cast<const unsigned char*>(source), sampleSize, sample.data(), Level::FAST);
+
+	// Already compressed payloads (DXT blocks, embedded images) barely shrink
+	if (compressed * 10u > sampleSize * 9u) return Level::STORE;
+
+	return (size <= (8u << 20)) ? Level::HIGH : Level::FAST;
+}
+
+size_t RE_Compression::CompressBound(size_t size)
+{
+	return sizeof(Header) + size + size / 255u + 16u;
+}
+
+size_t RE_Compression::Compress(const char* source, size_t size, char*& destination, Level level)
+{
+	if (level == Level::ADAPTIVE) level = ChooseLevel(source, size);
+
+	destination = new char[CompressBound(size)];
+
+	Header header = {};
+	memcpy(header.magic, "RELZ", 4);
+	header.rawSize = size;
+
+	size_t payload = 0;
+	if (level != Level::STORE)
+	{
+		payload = CompressBlock(reinterpret_cast<const unsigned char*>(source), size,
+			reinterpret_cast<unsigned char*>(destination + sizeof(Header)), level);
+
+		if (payload >= size) level = Level::STORE;
+	}
+
+	if (level == Level::STORE)
+	{
+		memcpy(destination + sizeof(Header), source, size);
+		payload = size;
+	}
+
+	header.level = static_cast<unsigned char>(level);
+	memcpy(destination, &header, sizeof(Header));
+	return sizeof(Header) + payload;
+}
+
+bool RE_Compression::IsCompressed(const char* source, size_t size)
+{
+	return source != nullptr && size >= sizeof(Header) && memcmp(source, "RELZ", 4) == 0;
+}
+
+bool RE_Compression::GetRawSize(const char* source, size_t size, size_t& rawSize)
+{
+	rawSize = size;
+	if (!IsCompressed(source, size)) return true;
+
+	Header header;
+	if (!ReadHeader(source, size, header)) return false;
+
+	rawSize = static_cast<size_t>(header.rawSize);
+	return true;
+}
+
+bool RE_Compression::Decompress(const char* source, size_t size, char* destination, size_t capacity)
+{
+	if (!IsCompressed(source, size))
+	{
+		if (size > capacity) return false;
+		memcpy(destination, source, size);
+		return true;
+	}
+
+	Header header;
+	if (!ReadHeader(source, size, header) || header.rawSize > capacity) return false;
+
+	const char* payload = source + sizeof(Header);
+	size_t payloadSize = size - sizeof(Header);
+
+	if (static_cast<Level>(header.level) == Level::STORE)
+	{
+		memcpy(destination, payload, payloadSize);
+		return true;
+	}
+
+	return DecompressBlock(reinterpret_cast<const unsigned char*>(payload), payloadSize,
+		reinterpret_cast<unsigned char*>(destination), static_cast<size_t>(header.rawSize));
+}
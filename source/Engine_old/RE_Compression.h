@@ -0,0 +1,35 @@
+#ifndef __RE_COMPRESSION_H__
+#define __RE_COMPRESSION_H__
+
+#include <stddef.h>
+
+// LZ4 block format codec for Library entries. Compressed data starts with a small
+// header holding the level and raw size; data without it is treated as stored.
+namespace RE_Compression
+{
+	enum class Level : unsigned char
+	{
+		STORE,
+		FAST,
+		HIGH,
+		ADAPTIVE
+	};
+
+	// Samples the data: incompressible input is stored, the rest favours ratio over speed
+	Level ChooseLevel(const char* source, size_t size);
+
+	size_t CompressBound(size_t size);
+
+	// Returns compressed size including header, allocates destination with new[]
+	size_t Compress(const char* source, size_t size, char*& destination, Level level = Level::ADAPTIVE);
+
+	bool IsCompressed(const char* source, size_t size);
+
+	// False for corrupt headers: unknown level or a raw size the payload can't expand to
+	bool GetRawSize(const char* source, size_t size, size_t& rawSize);
+
+	// Decompresses straight into caller memory (e.g. a mapped staging buffer), capacity must fit the raw size
+	bool Decompress(const char* source, size_t size, char* destination, size_t capacity);
+};
+
+#endif // !__RE_COMPRESSION_H__
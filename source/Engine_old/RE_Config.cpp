@@ -63,6 +63,11 @@ RE_Json* Config::GetRootNode(const char* member)
 	return new RE_Json(path.c_str(), this);
 }
 
+RE_JsonCursor Config::GetRootCursor(const char* member) const
+{
+	return RE_JsonCursor(&document).Child(member);
+}
+
 inline bool Config::operator!() const { return document.IsNull(); }
 
 eastl::string Config::GetMd5()
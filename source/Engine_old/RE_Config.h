@@ -2,6 +2,7 @@
 #define __RE_CONFIG_H__
 
 #include "RE_FileBuffer.h"
+#include "RE_JsonCursor.h"
 #include <RapidJson/document.h>
 
 class RE_Json;
@@ -17,6 +18,7 @@ public:
 	void Save() final;
 
 	RE_Json* GetRootNode(const char* member);
+	RE_JsonCursor GetRootCursor(const char* member) const;
 	inline bool operator!() const final;
 
 	eastl::string GetMd5() final;
@@ -9,6 +9,217 @@
 
 #include <EASTL/internal/char_traits.h>
 #include <EASTL/bit.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+	// Versioned scene format. Offsets are relative to the scene start and every block is
+	// aligned, so pools are decoded in place from the loaded buffer, one contiguous block
+	// each. Resources are referenced by their index in the resource table.
+	const char sceneMagic[4] = { 'R', 'E', 'S', 'C' };
+	const uint sceneVersion = 1u;
+	const size_t blockAlignment = 16u;
+
+	struct SceneHeader
+	{
+		char magic[4];
+		uint version;
+		uint resourceCount;
+		uint blockCount;
+		ulonglong resourcesOffset;
+		ulonglong blocksOffset;
+		ulonglong stringsOffset;
+		ulonglong totalSize;
+	};
+
+	struct ResourceEntry
+	{
+		uint pathOffset; // Into the string table, null terminated
+		uint pathSize;
+		ushort type;
+		ushort padding;
+		uint reserved;
+	};
+
+	struct BlockEntry
+	{
+		uint block; // RE_ECS_Pool binary block, 0 for the gameobjects
+		uint padding;
+		ulonglong entries;
+		ulonglong schema; // Layout hash of reflected components, a mismatch fails the load
+		ulonglong offset;
+		ulonglong size;
+	};
+
+	inline size_t Align(size_t offset) { return (offset + blockAlignment - 1u) & ~(blockAlignment - 1u); }
+
+	inline bool IsSceneFormat(const char* cursor, size_t size)
+	{
+		return size >= sizeof(sceneMagic) && memcmp(cursor, sceneMagic, sizeof(sceneMagic)) == 0;
+	}
+
+	const char* ResolveResource(const char* path, ResourceContainer::Type type)
+	{
+		return (type == ResourceContainer::Type::MESH) ?
+			RE_RES->CheckOrFindMeshOnLibrary(path) :
+			RE_RES->FindMD5ByMETAPath(path, type);
+	}
+
+	inline bool Fits(ulonglong offset, ulonglong count, size_t elementSize, ulonglong size)
+	{
+		return offset <= size && count <= (size - offset) / elementSize;
+	}
+
+	ResourceEntry ReadResource(const char* scene, const SceneHeader& header, uint index)
+	{
+		ResourceEntry ret;
+		memcpy(&ret, scene + header.resourcesOffset + sizeof(ResourceEntry) * index, sizeof(ResourceEntry));
+		return ret;
+	}
+
+	// Checks the header, the tables, every resource path and every block against the buffer,
+	// so nothing is read past it whatever the file holds
+	bool ReadHeader(const char* scene, size_t size, SceneHeader& header)
+	{
+		if (size < sizeof(SceneHeader))
+		{
+			RE_LOG_ERROR("Scene binary is truncated");
+			return false;
+		}
+
+		memcpy(&header, scene, sizeof(SceneHeader));
+		if (header.version == 0u || header.version > sceneVersion)
+		{
+			RE_LOG_ERROR("Scene binary version %u is not supported, expected 1 to %u", header.version, sceneVersion);
+			return false;
+		}
+
+		const ulonglong total = header.totalSize;
+		bool valid = total >= sizeof(SceneHeader) && total <= size
+			&& Fits(header.resourcesOffset, header.resourceCount, sizeof(ResourceEntry), total)
+			&& Fits(header.blocksOffset, header.blockCount, sizeof(BlockEntry), total)
+			&& header.stringsOffset <= total;
+
+		for (uint r = 0; r < header.resourceCount && valid; r++)
+		{
+			ResourceEntry entry = ReadResource(scene, header, r);
+			const ulonglong stringsSize = total - header.stringsOffset;
+			valid = static_cast<ulonglong>(entry.pathOffset) + entry.pathSize < stringsSize
+				&& scene[header.stringsOffset + entry.pathOffset + entry.pathSize] == '\0';
+		}
+
+		for (uint b = 0; b < header.blockCount && valid; b++)
+		{
+			BlockEntry block;
+			memcpy(&block, scene + header.blocksOffset + sizeof(BlockEntry) * b, sizeof(BlockEntry));
+			valid = block.block < RE_ECS_Pool::GetBinaryBlockCount()
+				&& Fits(block.offset, block.size, 1u, total)
+				&& block.entries <= block.size / sizeof(GO_UID);
+		}
+
+		if (!valid) RE_LOG_ERROR("Scene binary is corrupted, a table or block lies outside its %llu bytes", static_cast<ulonglong>(size));
+		return valid;
+	}
+
+	// Scenes saved before the versioned format, written field by field
+	RE_ECS_Pool* LegacyBinaryDeserialize(char*& cursor)
+	{
+		//Get resources
+		size_t size = sizeof(uint);
+		uint resSize = 0;
+		memcpy(&resSize, cursor, size);
+		cursor += size;
+		eastl::vector<const char*> resourcesIndex(resSize, nullptr);
+
+		for (uint r = 0; r < resSize; r++)
+		{
+			size = sizeof(int);
+			int index = 0;
+			memcpy(&index, cursor, size);
+			cursor += size;
+
+			size = sizeof(ushort);
+			ushort typeI = 0;
+			memcpy(&typeI, cursor, size);
+			cursor += size;
+			auto rType = static_cast<ResourceContainer::Type>(typeI);
+
+			size = sizeof(size_t);
+			size_t strsize = 0;
+			memcpy(&strsize, cursor, size);
+			cursor += size;
+
+			char* str = new char[strsize + 1];
+			char* strCursor = str;
+			size = strsize * sizeof(char);
+			memcpy(str, cursor, size);
+			cursor += size;
+			strCursor += size;
+			char nullchar = '\0';
+			memcpy(strCursor, &nullchar, sizeof(char));
+
+			const char* resMD5 = nullptr;
+			(rType == ResourceContainer::Type::MESH) ?
+				resMD5 = RE_RES->CheckOrFindMeshOnLibrary(str) :
+				resMD5= RE_RES->FindMD5ByMETAPath(str, rType);
+
+			if (index >= 0 && static_cast<uint>(index) < resSize) resourcesIndex[index] = resMD5;
+			DEL_A(str);
+		}
+
+		RE_ECS_Pool* ret = new RE_ECS_Pool();
+		ret->DeserializeBinary(cursor, &resourcesIndex);
+		return ret;
+	}
+
+	bool LegacyBinaryCheckResources(char*& cursor)
+	{
+		bool ret = true;
+
+		size_t size = sizeof(uint);
+		uint resSize = 0;
+		memcpy(&resSize, cursor, size);
+		cursor += size;
+
+		for (uint r = 0; r < resSize && ret; r++)
+		{
+			size = sizeof(int);
+			int index = 0;
+			memcpy(&index, cursor, size);
+			cursor += size;
+
+			size = sizeof(ushort);
+			ushort typeI = 0;
+			memcpy(&typeI, cursor, size);
+			cursor += size;
+			auto rType = static_cast<ResourceContainer::Type>(typeI);
+
+			size = sizeof(size_t);
+			size_t strsize = 0;
+			memcpy(&strsize, cursor, size);
+			cursor += size;
+
+			char* str = new char[strsize + 1];
+			char* strCursor = str;
+			size = strsize * sizeof(char);
+			memcpy(str, cursor, size);
+			cursor += size;
+			strCursor += size;
+			char nullchar = '\0';
+			memcpy(strCursor, &nullchar, sizeof(char));
+
+			const char* resMD5 = nullptr;
+			resMD5 = (rType == ResourceContainer::Type::MESH) ?
+				RE_RES->CheckOrFindMeshOnLibrary(str) :
+				RE_RES->FindMD5ByMETAPath(str, rType);
+
+			if (!resMD5) ret = false;
+			DEL_A(str);
+		}
+		return ret;
+	}
+}
 
 void RE_ECS_Importer::JsonSerialize(RE_Json* node, RE_ECS_Pool* pool)
 {
@@ -42,60 +253,73 @@ void RE_ECS_Importer::JsonSerialize(RE_Json* node, RE_ECS_Pool* pool)
 char* RE_ECS_Importer::BinarySerialize(RE_ECS_Pool* pool, size_t* bufferSize)
 {
 	//Get resources
-	eastl::vector<const char*>  resGo = pool->GetAllResources();
-	eastl::vector<ResourceContainer*>  resC;
+	eastl::vector<const char*> resGo = pool->GetAllResources();
 	eastl::map<const char*, int> resourcesIndex;
-	int count = 0;
-	for (const char* res : resGo)
-	{
-		resourcesIndex.insert(eastl::pair<const char*, int>(res, count++));
-		resC.push_back(RE_RES->At(res));
-	}
-
-	*bufferSize = sizeof(uint) + ((sizeof(int) + sizeof(ushort) + sizeof(uint)) * resGo.size());
-	for (ResourceContainer* res : resC)
-		*bufferSize += eastl::CharStrlen((res->GetType() == ResourceContainer::Type::MESH) ? res->GetLibraryPath() : res->GetMetaPath()) * sizeof(char);
-	*bufferSize += pool->GetBinarySize();
-	*bufferSize += 1;
+	eastl::vector<const char*> paths;
+	eastl::vector<ResourceEntry> resources(resGo.size());
+	size_t stringsSize = 0;
 
-	char* buffer = new char[*bufferSize];
-	char* cursor = buffer;
-
-	size_t size = sizeof(uint);
-	eastl_size_t resSize = resGo.size();
-	memcpy(eastl::bit_cast<void*>(cursor), &resSize, size);
-	cursor += size;
-
-	for (int r = 0; r < static_cast<int>(resGo.size()); r++)
+	for (size_t r = 0; r < resGo.size(); r++)
 	{
-		ResourceContainer* res = resC.at(static_cast<unsigned int>(r));
-		ResourceContainer::Type rtype = res->GetType();
-
-		size = sizeof(int);
-		memcpy(cursor, &r, size);
-		cursor += size;
+		resourcesIndex.insert(eastl::pair<const char*, int>(resGo[r], static_cast<int>(r)));
 
-		size = sizeof(ushort);
-		auto typeI = static_cast<ushort>(rtype);
-		memcpy(cursor, &typeI, size);
-		cursor += size;
+		ResourceContainer* res = RE_RES->At(resGo[r]);
+		ResourceContainer::Type rtype = res->GetType();
+		const char* path = (rtype == ResourceContainer::Type::MESH) ? res->GetLibraryPath() : res->GetMetaPath();
+		paths.push_back(path);
+
+		ResourceEntry& entry = resources[r];
+		entry = {};
+		entry.pathOffset = static_cast<uint>(stringsSize);
+		entry.pathSize = static_cast<uint>(eastl::CharStrlen(path));
+		entry.type = static_cast<ushort>(rtype);
+		stringsSize += entry.pathSize + 1u;
+	}
 
-		const char* toCopy = (rtype == ResourceContainer::Type::MESH) ? res->GetLibraryPath() : res->GetMetaPath();
-		size_t strsize = eastl::CharStrlen(toCopy);
-		size = sizeof(size_t);
-		memcpy(cursor, &strsize, size);
-		cursor += size;
+	//Layout, empty component pools are left out
+	eastl::vector<BlockEntry> blocks;
+	for (uint b = 0; b < RE_ECS_Pool::GetBinaryBlockCount(); b++)
+	{
+		BlockEntry block = {};
+		block.block = b;
+		block.entries = pool->GetBinaryBlockEntries(b);
+		if (b > 0 && block.entries == 0) continue;
+
+		block.schema = pool->GetBinaryBlockSchema(b);
+		block.size = pool->GetBinaryBlockSize(b);
+		blocks.push_back(block);
+	}
 
-		size = sizeof(char) * strsize;
-		memcpy(cursor, toCopy, size);
-		cursor += size;
+	SceneHeader header = {};
+	memcpy(header.magic, sceneMagic, sizeof(sceneMagic));
+	header.version = sceneVersion;
+	header.resourceCount = static_cast<uint>(resources.size());
+	header.blockCount = static_cast<uint>(blocks.size());
+	header.resourcesOffset = Align(sizeof(SceneHeader));
+	header.blocksOffset = Align(header.resourcesOffset + sizeof(ResourceEntry) * resources.size());
+	header.stringsOffset = Align(header.blocksOffset + sizeof(BlockEntry) * blocks.size());
+
+	size_t offset = Align(header.stringsOffset + stringsSize);
+	for (BlockEntry& block : blocks)
+	{
+		block.offset = offset;
+		offset = Align(offset + block.size);
 	}
+	header.totalSize = offset;
 
-	//GOs Serialize
-	pool->SerializeBinary(cursor, &resourcesIndex);
+	//Write
+	*bufferSize = offset;
+	char* buffer = new char[offset];
+	memset(buffer, 0, offset);
+
+	memcpy(buffer, &header, sizeof(SceneHeader));
+	if (!resources.empty()) memcpy(buffer + header.resourcesOffset, resources.data(), sizeof(ResourceEntry) * resources.size());
+	memcpy(buffer + header.blocksOffset, blocks.data(), sizeof(BlockEntry) * blocks.size());
+	for (size_t r = 0; r < paths.size(); r++)
+		memcpy(buffer + header.stringsOffset + resources[r].pathOffset, paths[r], resources[r].pathSize);
 
-	char nullchar = '\0';
-	memcpy(cursor, &nullchar, sizeof(char));
+	for (const BlockEntry& block : blocks)
+		pool->SerializeBinaryBlock(block.block, buffer + block.offset, &resourcesIndex);
 
 	return buffer;
 }
@@ -103,156 +327,107 @@ char* RE_ECS_Importer::BinarySerialize(RE_ECS_Pool* pool, size_t* bufferSize)
 RE_ECS_Pool* RE_ECS_Importer::JsonDeserialize(RE_Json* node)
 {
 	//Get resources
-	RE_Json* resources = node->PullJObject("resources");
-	eastl::map< int, const char*> resourcesIndex;
+	RE_JsonCursor resources = node->GetCursor().Child("resources");
 
-	size_t resSize = resources->PullSizeT("resSize", 0);
+	size_t resSize = resources.PullSizeT("resSize", 0);
+	eastl::vector<const char*> resourcesIndex(resSize, nullptr);
+	char key[24];
 	for (uint r = 0; r < resSize; r++)
 	{
-		RE_Json* resN = resources->PullJObject(("r" + eastl::to_string(r)).c_str());
-
-		int index = resN->PullInt("index", -1);
-		auto type = static_cast<ResourceContainer::Type>(resN->PullUInt("type", static_cast<const uint>(ResourceContainer::Type::UNDEFINED)));
-		eastl::string mPath = resN->PullString("mPath", "");
+		snprintf(key, sizeof(key), "r%u", r);
+		RE_JsonCursor resN = resources.Child(key, r + 1);
 
-		const char* resMD5 = nullptr;
-		resMD5 = (type == ResourceContainer::Type::MESH) ?
-			RE_RES->CheckOrFindMeshOnLibrary(mPath.c_str()) :
-			RE_RES->FindMD5ByMETAPath(mPath.c_str(), type);
-
-		resourcesIndex.insert(eastl::pair< int, const char*>(r, resMD5));
-		DEL(resN)
+		auto type = static_cast<ResourceContainer::Type>(resN.PullUInt("type", static_cast<const uint>(ResourceContainer::Type::UNDEFINED)));
+		resourcesIndex[r] = ResolveResource(resN.PullString("mPath", ""), type);
 	}
 
-	DEL(resources)
 	RE_ECS_Pool* ret = new RE_ECS_Pool();
 	ret->DeserializeJson(node, &resourcesIndex);
 	return ret;
 }
 
-RE_ECS_Pool* RE_ECS_Importer::BinaryDeserialize(char*& cursor)
+RE_ECS_Pool* RE_ECS_Importer::BinaryDeserialize(char*& cursor, size_t size)
 {
-	//Get resources
-	eastl::map< int, const char*> resourcesIndex;
-	size_t size = sizeof(uint);
-	uint resSize = 0;
-	memcpy(&resSize, cursor, size);
-	cursor += size;
-
-	for (uint r = 0; r < resSize; r++)
-	{
-		size = sizeof(int);
-		int index = 0;
-		memcpy(&index, cursor, size);
-		cursor += size;
-
-		size = sizeof(ushort);
-		ushort typeI = 0;
-		memcpy(&typeI, cursor, size);
-		cursor += size;
-		auto rType = static_cast<ResourceContainer::Type>(typeI);
-
-		size = sizeof(size_t);
-		size_t strsize = 0;
-		memcpy(&strsize, cursor, size);
-		cursor += size;
-
-		char* str = new char[strsize + 1];
-		char* strCursor = str;
-		size = strsize * sizeof(char);
-		memcpy(str, cursor, size);
-		cursor += size;
-		strCursor += size;
-		char nullchar = '\0';
-		memcpy(strCursor, &nullchar, sizeof(char));
+	if (!IsSceneFormat(cursor, size)) return LegacyBinaryDeserialize(cursor);
 
-		const char* resMD5 = nullptr;
-		(rType == ResourceContainer::Type::MESH) ?
-			resMD5 = RE_RES->CheckOrFindMeshOnLibrary(str) :
-			resMD5= RE_RES->FindMD5ByMETAPath(str, rType);
+	char* scene = cursor;
+	SceneHeader header;
+	if (!ReadHeader(scene, size, header)) return nullptr;
 
-		resourcesIndex.insert(eastl::pair< int, const char*>(index, resMD5));
-		DEL_A(str);
+	//Resolve resources into an index array
+	eastl::vector<const char*> resourcesIndex(header.resourceCount, nullptr);
+	const char* strings = scene + header.stringsOffset;
+	for (uint r = 0; r < header.resourceCount; r++)
+	{
+		ResourceEntry entry = ReadResource(scene, header, r);
+		resourcesIndex[r] = ResolveResource(strings + entry.pathOffset, static_cast<ResourceContainer::Type>(entry.type));
 	}
 
+	//Gather the pool blocks, components decode concurrently once gameobjects are in
+	char* goBlock = nullptr;
+	size_t goCount = 0;
+	eastl::vector<ComponentsPool::BinaryBlock> compBlocks;
 	RE_ECS_Pool* ret = new RE_ECS_Pool();
-	ret->DeserializeBinary(cursor, &resourcesIndex);
+	for (uint b = 0; b < header.blockCount; b++)
+	{
+		BlockEntry block;
+		memcpy(&block, scene + header.blocksOffset + sizeof(BlockEntry) * b, sizeof(BlockEntry));
+
+		if (block.schema != ret->GetBinaryBlockSchema(block.block))
+		{
+			// Fails the whole load so the caller rebuilds it from the asset instead of losing the pool
+			RE_LOG_ERROR("Component pool %u was saved with an outdated layout", block.block);
+			DEL(ret)
+			return nullptr;
+		}
+
+		if (block.block == 0)
+		{
+			goBlock = scene + block.offset;
+			goCount = static_cast<size_t>(block.entries);
+		}
+		else compBlocks.push_back({ block.block - 1u, scene + block.offset, static_cast<size_t>(block.entries) });
+	}
+
+	if (goBlock) ret->DeserializeBinaryBlocks(goBlock, goCount, compBlocks, &resourcesIndex);
+
+	cursor += header.totalSize;
 	return ret;
 }
 
 bool RE_ECS_Importer::JsonCheckResources(RE_Json* node)
 {
 	bool ret = true;
-	RE_Json* resources = node->PullJObject("resources");
-	uint resSize = resources->PullUInt("resSize", 0);
-	eastl::string ref;
+	RE_JsonCursor resources = node->GetCursor().Child("resources");
+	uint resSize = resources.PullUInt("resSize", 0);
 
+	char key[24];
 	for (uint r = 0; r < resSize && ret; r++)
 	{
-		ref = "r";
-		ref += eastl::to_string(r);
-		RE_Json* resN = resources->PullJObject(ref.c_str());
-
-		int index = resN->PullInt("index", -1);
-		auto type = static_cast<ResourceContainer::Type>(resN->PullUInt("type", static_cast<unsigned int>(ResourceContainer::Type::UNDEFINED)));
-		eastl::string mPath = resN->PullString("mPath", "");
+		snprintf(key, sizeof(key), "r%u", r);
+		RE_JsonCursor resN = resources.Child(key, r + 1);
 
-		const char* resMD5 = nullptr;
-		resMD5 = (type == ResourceContainer::Type::MESH) ?
-			RE_RES->CheckOrFindMeshOnLibrary(mPath.c_str()) :
-			RE_RES->FindMD5ByMETAPath(mPath.c_str(), type);
-
-		if (!resMD5) ret = false;
-		DEL(resN)
+		auto type = static_cast<ResourceContainer::Type>(resN.PullUInt("type", static_cast<unsigned int>(ResourceContainer::Type::UNDEFINED)));
+		ret = ResolveResource(resN.PullString("mPath", ""), type) != nullptr;
 	}
 
-	DEL(resources)
 	return ret;
 }
 
-bool RE_ECS_Importer::BinaryCheckResources(char*& cursor)
+bool RE_ECS_Importer::BinaryCheckResources(char*& cursor, size_t size)
 {
-	bool ret = true;
+	if (!IsSceneFormat(cursor, size)) return LegacyBinaryCheckResources(cursor);
 
-	size_t size = sizeof(uint);
-	uint resSize = 0;
-	memcpy(&resSize, cursor, size);
-	cursor += size;
+	SceneHeader header;
+	if (!ReadHeader(cursor, size, header)) return false;
 
-	for (uint r = 0; r < resSize && ret; r++)
+	bool ret = true;
+	const char* strings = cursor + header.stringsOffset;
+	for (uint r = 0; r < header.resourceCount && ret; r++)
 	{
-		size = sizeof(int);
-		int index = 0;
-		memcpy(&index, cursor, size);
-		cursor += size;
-
-		size = sizeof(ushort);
-		ushort typeI = 0;
-		memcpy(&typeI, cursor, size);
-		cursor += size;
-		auto rType = static_cast<ResourceContainer::Type>(typeI);
-
-		size = sizeof(size_t);
-		size_t strsize = 0;
-		memcpy(&strsize, cursor, size);
-		cursor += size;
-
-		char* str = new char[strsize + 1];
-		char* strCursor = str;
-		size = strsize * sizeof(char);
-		memcpy(str, cursor, size);
-		cursor += size;
-		strCursor += size;
-		char nullchar = '\0';
-		memcpy(strCursor, &nullchar, sizeof(char));
-
-		const char* resMD5 = nullptr;
-		resMD5 = (rType == ResourceContainer::Type::MESH) ?
-			RE_RES->CheckOrFindMeshOnLibrary(str) :
-			RE_RES->FindMD5ByMETAPath(str, rType);
-
-		if (!resMD5) ret = false;
-		DEL_A(str);
+		ResourceEntry entry = ReadResource(cursor, header, r);
+		ret = ResolveResource(strings + entry.pathOffset, static_cast<ResourceContainer::Type>(entry.type)) != nullptr;
 	}
+
 	return ret;
 }
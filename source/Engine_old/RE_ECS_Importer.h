@@ -10,10 +10,10 @@ namespace RE_ECS_Importer
 	char* BinarySerialize(RE_ECS_Pool* pool, size_t* bufferSize);
 
 	RE_ECS_Pool* JsonDeserialize(RE_Json* node);
-	RE_ECS_Pool* BinaryDeserialize(char*& cursor);
+	RE_ECS_Pool* BinaryDeserialize(char*& cursor, size_t size);
 
 	bool JsonCheckResources(RE_Json* node);
-	bool BinaryCheckResources(char*& cursor);
+	bool BinaryCheckResources(char*& cursor, size_t size);
 };
 
 #endif // !__RE_RESOURCEANDGOIMPORTER_H__
\ No newline at end of file
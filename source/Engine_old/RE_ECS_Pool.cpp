@@ -222,10 +222,11 @@ void RE_ECS_Pool::SerializeJson(RE_Json* node, eastl::map<const char*, int>* res
 	componentsPool.SerializeJson(node, resources);
 }
 
-void RE_ECS_Pool::DeserializeJson(RE_Json* node, eastl::map<int, const char*>* resources)
+void RE_ECS_Pool::DeserializeJson(RE_Json* node, const eastl::vector<const char*>* resources)
 {
-	gameObjectsPool.DeserializeJson(node, &componentsPool);
-	componentsPool.DeserializeJson(&gameObjectsPool, node, resources);
+	RE_JsonCursor root = node->GetCursor();
+	gameObjectsPool.DeserializeJson(root, &componentsPool);
+	componentsPool.DeserializeJson(&gameObjectsPool, root, resources);
 }
 
 void RE_ECS_Pool::SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources)
@@ -234,8 +235,36 @@ void RE_ECS_Pool::SerializeBinary(char*& cursor, eastl::map<const char*, int>* r
 	componentsPool.SerializeBinary(cursor, resources);
 }
 
-void RE_ECS_Pool::DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources)
+void RE_ECS_Pool::DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources)
 {
 	gameObjectsPool.DeserializeBinary(cursor, &componentsPool);
 	componentsPool.DeserializeBinary(&gameObjectsPool, cursor, resources);
 }
+
+size_t RE_ECS_Pool::GetBinaryBlockSize(uint block) const
+{
+	return block ? componentsPool.GetBinaryBlockSize(block - 1) : gameObjectsPool.GetBinaryBlockSize();
+}
+
+size_t RE_ECS_Pool::GetBinaryBlockEntries(uint block) const
+{
+	return block ? componentsPool.GetBinaryBlockCount(block - 1) : gameObjectsPool.GetCount();
+}
+
+ulonglong RE_ECS_Pool::GetBinaryBlockSchema(uint block) const
+{
+	return block ? componentsPool.GetBinaryBlockSchema(block - 1) : 0ull;
+}
+
+void RE_ECS_Pool::SerializeBinaryBlock(uint block, char* cursor, eastl::map<const char*, int>* resources)
+{
+	if (block) componentsPool.SerializeBinaryBlock(block - 1, cursor, resources);
+	else gameObjectsPool.SerializeBinaryBlock(cursor);
+}
+
+void RE_ECS_Pool::DeserializeBinaryBlocks(char* goBlock, size_t goCount, const eastl::vector<ComponentsPool::BinaryBlock>& compBlocks, const eastl::vector<const char*>* resources)
+{
+	// Gameobjects, their transforms and parents have to exist before any component pool loads
+	gameObjectsPool.DeserializeBinaryBlock(goBlock, goCount, &componentsPool);
+	componentsPool.DeserializeBinaryBlocks(&gameObjectsPool, compBlocks, resources);
+}
@@ -65,9 +65,17 @@ public:
 
 	size_t GetBinarySize() const;
 	void SerializeBinary(char*& cursor, eastl::map<const char*, int>* resources);
-	void DeserializeBinary(char*& cursor, eastl::map<int, const char*>* resources);
+	void DeserializeBinary(char*& cursor, const eastl::vector<const char*>* resources);
 	void SerializeJson(class RE_Json* node, eastl::map<const char*, int>* resources);
-	void DeserializeJson(RE_Json* node, eastl::map<int, const char* >* resources);
+	void DeserializeJson(RE_Json* node, const eastl::vector<const char*>* resources);
+
+	// Binary scene blocks: block 0 holds the gameobjects, the rest one component pool each
+	static uint GetBinaryBlockCount() { return 1u + ComponentsPool::binaryPoolCount; }
+	size_t GetBinaryBlockSize(uint block) const;
+	size_t GetBinaryBlockEntries(uint block) const;
+	ulonglong GetBinaryBlockSchema(uint block) const;
+	void SerializeBinaryBlock(uint block, char* cursor, eastl::map<const char*, int>* resources);
+	void DeserializeBinaryBlocks(char* goBlock, size_t goCount, const eastl::vector<ComponentsPool::BinaryBlock>& compBlocks, const eastl::vector<const char*>* resources);
 
 	#pragma endregion
 
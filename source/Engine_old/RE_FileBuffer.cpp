@@ -2,9 +2,11 @@
 
 #include "Application.h"
 #include "RE_Memory.h"
+#include "RE_Compression.h"
 #include <MD5/md5.h>
 #include <PhysFS/physfs.h>
 #include <EASTL/bit.h>
+#include <new>
 
 RE_FileBuffer::RE_FileBuffer(const char* file_name) : buffer(nullptr), file_name(file_name) {}
 RE_FileBuffer::~RE_FileBuffer() { if (buffer != nullptr) delete[] buffer; }
@@ -18,6 +20,60 @@ bool RE_FileBuffer::Load()
 void RE_FileBuffer::Save() { HardSave(buffer); }
 void RE_FileBuffer::Save(char* buffer, size_t size) { HardSave(buffer, size); }
 
+bool RE_FileBuffer::LoadDecompressed()
+{
+	if (!Load()) return false;
+	if (!RE_Compression::IsCompressed(buffer, size)) return true;
+
+	size_t rawSize = 0;
+	if (!RE_Compression::GetRawSize(buffer, size, rawSize))
+	{
+		RE_LOG_ERROR("File System error: corrupt compression header in %s", file_name);
+		return false;
+	}
+
+	// Bounded by the payload, a corrupt entry can still ask for more memory than there is
+	char* raw = new (std::nothrow) char[rawSize + 1];
+	if (raw == nullptr || !RE_Compression::Decompress(buffer, size, raw, rawSize))
+	{
+		RE_LOG_ERROR("File System error while decompressing %s", file_name);
+		DEL_A(raw);
+		return false;
+	}
+
+	raw[rawSize] = '\0';
+	DEL_A(buffer);
+	buffer = raw;
+	size = rawSize;
+	return true;
+}
+
+void RE_FileBuffer::SaveCompressed(const char* toCompress, size_t toCompressSize)
+{
+	char* compressed = nullptr;
+	size_t compressedSize = RE_Compression::Compress(toCompress, toCompressSize, compressed);
+	HardSave(compressed, compressedSize);
+	DEL_A(compressed);
+}
+
+bool RE_FileBuffer::GetDecompressedSize(size_t& rawSize)
+{
+	if (!buffer && !Load()) return false;
+	if (RE_Compression::GetRawSize(buffer, size, rawSize)) return true;
+
+	RE_LOG_ERROR("File System error: corrupt compression header in %s", file_name);
+	return false;
+}
+
+bool RE_FileBuffer::DecompressInto(char* destination, size_t capacity)
+{
+	if (!buffer && !Load()) return false;
+
+	bool ret = RE_Compression::Decompress(buffer, size, destination, capacity);
+	if (!ret) RE_LOG_ERROR("File System error while decompressing %s", file_name);
+	return ret;
+}
+
 void RE_FileBuffer::Delete()
 {
 	if(PHYSFS_delete(file_name) == 0)
@@ -19,6 +19,15 @@ public:
 	virtual void Save();
 	virtual void Save(char* buffer, size_t size = 0);
 
+	// Library entries: compressed with an adaptive level, entries saved raw still load as they are.
+	// Every Library read goes through LoadDecompressed or DecompressInto, whichever way the entry was saved.
+	bool LoadDecompressed();
+	void SaveCompressed(const char* buffer, size_t size);
+
+	// Decompresses straight into caller memory, e.g. a resource's final storage, sized with GetDecompressedSize
+	bool GetDecompressedSize(size_t& rawSize);
+	bool DecompressInto(char* destination, size_t capacity);
+
 	virtual size_t GetSize();
 	virtual eastl::string GetMd5();
 
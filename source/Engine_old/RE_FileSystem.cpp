@@ -2,6 +2,9 @@
 
 #include "RE_Memory.h"
 #include "RE_FileBuffer.h"
+#include "RE_AssetDatabase.h"
+#include "RE_AssetWatcher.h"
+#include "RE_LibraryPack.h"
 #include "RE_Config.h"
 #include "RE_Json.h"
 
@@ -23,6 +26,7 @@
 #include "RE_CompPrimitive.h"
 #include "RE_Mesh.h"
 #include "RE_Shader.h"
+#include "RE_WorkerPool.h"
 
 #include <ImGui/imgui.h>
 #include <PhysFS/physfs.h>
@@ -30,8 +34,27 @@
 #include <EASTL/internal/char_traits.h>
 #include <EASTL/algorithm.h>
 #include <EASTL/iterator.h>
+#include <EASTL/sort.h>
 #include <EAStdC/EASprintf.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+	// PhysFS paths are UTF-8 whatever the platform
+	std::filesystem::path NativeFromUTF8(const char* utf8) { return std::filesystem::path(reinterpret_cast<const char8_t*>(utf8)); }
+
+	eastl::string UTF8FromNative(const std::filesystem::path& native)
+	{
+		std::u8string utf8 = native.u8string();
+		return eastl::string(reinterpret_cast<const char*>(utf8.c_str()), utf8.size());
+	}
+}
+
 bool RE_FileSystem::Init(int argc, char* argv[])
 {
 	RE_PROFILE(RE_ProfiledFunc::Init, RE_ProfiledClass::FileSystem);
@@ -82,6 +105,9 @@ bool RE_FileSystem::Init(int argc, char* argv[])
 			return false;
 		}
 
+		RE_LibraryPack::RegisterArchiver();
+		MountLibraryPack();
+
 		//PHYSFS_mount(zip_path.c_str(), NULL, 0);
 		//PHYSFS_mount((zip_path += "data.zip").c_str(), NULL, 0);
 
@@ -103,12 +129,20 @@ bool RE_FileSystem::Init(int argc, char* argv[])
 			if (!config->Load()) RE_LOG_WARNING("Can't load Settings/config.json - building module default configuration.");
 		}
 
+		assetDatabase = new RE_AssetDatabase();
+		if (!assetDatabase->Load((library_path + "/assets.db").c_str()))
+			RE_LOG("No asset database found - asset hashes will be rebuilt.");
+
 		rootAssetDirectory = new RE_Directory();
 		rootAssetDirectory->SetPath("Assets/");
 		assetsDirectories = rootAssetDirectory->MountTreeFolders();
 		assetsDirectories.push_front(rootAssetDirectory);
 		dirIter = assetsDirectories.begin();
 
+		assetWatcher = new RE_AssetWatcher();
+		if (assetWatcher->Init())
+			for (auto dir : assetsDirectories) assetWatcher->Watch(dir);
+
 		ret = true;
 	}
 	else RE_LOG_ERROR("PhysFS could not initialize! Error: %s\n", PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()));
@@ -118,6 +152,8 @@ bool RE_FileSystem::Init(int argc, char* argv[])
 
 void RE_FileSystem::Clear()
 {
+	DEL(assetWatcher)
+
 	for (auto dir : assetsDirectories)
 		for (auto p : dir->tree)
 			if (p->pType != PathType::FOLDER)
@@ -127,6 +163,9 @@ void RE_FileSystem::Clear()
 
 	DEL(config)
 
+	if (assetDatabase != nullptr) assetDatabase->Save((library_path + "/assets.db").c_str());
+	DEL(assetDatabase)
+
 	PHYSFS_deinit();
 }
 
@@ -138,6 +177,12 @@ unsigned int RE_FileSystem::ReadAssetChanges(unsigned int extra_ms, bool doAll)
 
 	if ((dirIter == assetsDirectories.begin()) && (!assets_to_process.empty() || !filesToFindMeta.empty() || !toImport.empty() || !toReImport.empty()))
 		dirIter = assetsDirectories.end();
+	else if (assetsScanned && assetWatcher->IsActive())
+	{
+		// Native notifications replace the periodic walk once the first full scan is done
+		QueueWatchedChanges();
+		dirIter = assetsDirectories.end();
+	}
 
 	while ((doAll || run) && dirIter != assetsDirectories.end())
 	{
@@ -157,6 +202,7 @@ unsigned int RE_FileSystem::ReadAssetChanges(unsigned int extra_ms, bool doAll)
 
 	if (dirIter == assetsDirectories.end())
 	{
+		assetsScanned = true;
 		dirIter = assetsDirectories.begin();
 
 		while ((doAll || run) && !assets_to_process.empty())
@@ -220,11 +266,22 @@ unsigned int RE_FileSystem::ReadAssetChanges(unsigned int extra_ms, bool doAll)
 				}
 
 				assetsDirectories.push_back(dir);
+				assetWatcher->Watch(dir);
+				break;
+			}
+			case PathProcess::DELETE:
+			{
+				RE_Path* path = process->toProcess;
+				RE_Directory* dir = (path->pType == PathType::FOLDER) ? path->AsDirectory()->parent : FindDirectory(path->path.c_str());
+				if (dir != nullptr) dir->tree.remove(path);
+
+				RE_LOG("Asset removed: %s", path->path.c_str());
+				RemoveFromTree(path);
 				break;
 			}
 			case PathProcess::REIMPORT:
 			{
-				toReImport.push(process->toProcess->AsFile());
+				if (process->toProcess->AsMeta()->resource != nullptr) toReImport.push(process->toProcess->AsFile());
 				break;
 			}
 			}
@@ -377,14 +434,15 @@ unsigned int RE_FileSystem::ReadAssetChanges(unsigned int extra_ms, bool doAll)
 
 				switch (RE_RES->At(meta->resource)->GetType())
 				{
-				case ResourceContainer::Type::SHADER:
-					RE_RES->At(meta->resource)->ReImport();
-					break;
 				case ResourceContainer::Type::PARTICLE_RENDER:
 				case ResourceContainer::Type::PARTICLE_EMISSION:
 					RE_RES->PushParticleResource(meta->resource);
 					particle_reimport = true;
 					break;
+				default:
+					// Shaders, and textures or models edited on disk
+					RE_RES->At(meta->resource)->ReImport();
+					break;
 				}
 
 				if (!doAll && extra_ms < time.Read())
@@ -420,6 +478,12 @@ void RE_FileSystem::DrawEditor()
 
 	ImGui::Text("Write Directory");
 	ImGui::TextWrappedV(write_path.c_str(), "");
+	ImGui::Separator();
+
+	ImGui::Text("Library Pack");
+	if (ImGui::Button("Repack Library")) RepackLibrary();
+	ImGui::SameLine();
+	if (ImGui::Button("Benchmark Library Load")) RE_LibraryPack::Benchmark((library_path + "/").c_str(), (library_path + ".bench.repack").c_str());
 }
 
 bool RE_FileSystem::AddPath(const char* path_or_zip, const char* mount_point)
@@ -581,6 +645,7 @@ void RE_FileSystem::DeleteUndefinedFile(const char* filePath)
 
 			RE_FileBuffer fileToDelete(filePath);
 			fileToDelete.Delete();
+			assetDatabase->Remove(filePath);
 			DEL(file)
 		}
 		else
@@ -669,11 +734,195 @@ signed long long RE_FileSystem::GetLastTimeModified(const char* path)
 	return 0;
 }
 
+void RE_FileSystem::QueueWatchedChanges()
+{
+	eastl::vector<RE_Directory*> changed;
+	eastl::vector<eastl::string> removed;
+	assetWatcher->Poll(changed, removed);
+
+	// Stacked first so removals are processed after anything added on the same poll
+	for (const auto& path : removed)
+	{
+		RE_Path* toRemove = (path.back() == '/') ? FindDirectory(path.c_str()) : FindPath(path.c_str());
+		if (toRemove != nullptr && toRemove != rootAssetDirectory)
+			assets_to_process.push(new RE_ProcessPath(PathProcess::DELETE, toRemove));
+	}
+
+	for (auto dir : changed)
+	{
+		eastl::stack<RE_ProcessPath*> toProcess = dir->CheckAndApply(&metaRecentlyAdded);
+		while (!toProcess.empty())
+		{
+			assets_to_process.push(toProcess.top());
+			toProcess.pop();
+		}
+	}
+}
+
+void RE_FileSystem::RemoveFromTree(RE_Path* path)
+{
+	if (path->pType == PathType::FOLDER)
+	{
+		RE_Directory* dir = path->AsDirectory();
+		for (auto child : dir->tree) RemoveFromTree(child);
+		dir->tree.clear();
+
+		assetWatcher->Unwatch(dir);
+		if (dirIter != assetsDirectories.end() && *dirIter == dir) dirIter++;
+		assetsDirectories.remove(dir);
+	}
+	else
+	{
+		RE_File* file = path->AsFile();
+		if (file->fType == FileType::META)
+		{
+			RE_Meta* meta = file->AsMeta();
+			if (meta->fromFile != nullptr) meta->fromFile->metaResource = nullptr;
+			metaToFindFile.erase(eastl::remove(metaToFindFile.begin(), metaToFindFile.end(), meta), metaToFindFile.end());
+			metaRecentlyAdded.erase(eastl::remove(metaRecentlyAdded.begin(), metaRecentlyAdded.end(), meta), metaRecentlyAdded.end());
+
+			auto& reloads = reloadResourceMeta.get_container();
+			reloads.erase(eastl::remove(reloads.begin(), reloads.end(), meta), reloads.end());
+
+			if (meta->resource != nullptr) RE_RES->AssetRemoved(meta->resource, true);
+		}
+		else
+		{
+			if (file->metaResource != nullptr)
+			{
+				file->metaResource->fromFile = nullptr;
+				if (file->metaResource->resource != nullptr) RE_RES->AssetRemoved(file->metaResource->resource, false);
+			}
+			filesToFindMeta.erase(eastl::remove(filesToFindMeta.begin(), filesToFindMeta.end(), file), filesToFindMeta.end());
+		}
+
+		DropQueued(file, toImport);
+		DropQueued(file, toReImport);
+		assetDatabase->Remove(file->path.c_str());
+	}
+
+	DropQueued(path, assets_to_process);
+	DropQueued(path, meta_to_process_last);
+	DEL(path)
+}
+
+void RE_FileSystem::DropQueued(RE_Path* path, eastl::stack<RE_ProcessPath*>& processes)
+{
+	// Queued work keeps raw pointers into the tree, none of it may outlive the path
+	auto& queued = processes.get_container();
+	for (auto it = queued.begin(); it != queued.end();)
+	{
+		if ((*it)->toProcess == path)
+		{
+			DEL(*it)
+			it = queued.erase(it);
+		}
+		else it++;
+	}
+}
+
+void RE_FileSystem::DropQueued(RE_File* file, eastl::priority_queue<RE_File*, eastl::vector<RE_File*>, AssetsPrioroty>& files)
+{
+	auto& queued = files.get_container();
+	auto removed = eastl::remove(queued.begin(), queued.end(), file);
+	if (removed == queued.end()) return;
+
+	queued.erase(removed, queued.end());
+	eastl::make_heap(queued.begin(), queued.end(), AssetsPrioroty());
+}
+
+bool RE_FileSystem::MountLibraryPack()
+{
+	eastl::string pack = library_path + "." + RE_LibraryPack::extension;
+	if (!Exists(pack.c_str())) return false;
+
+	// Appended, so loose files written after the last repack take precedence
+	library_pack_path = PHYSFS_getRealDir(pack.c_str());
+	if (library_pack_path.back() != '/' && library_pack_path.back() != '\\') library_pack_path += PHYSFS_getDirSeparator();
+	library_pack_path += pack;
+
+	if (PHYSFS_mount(library_pack_path.c_str(), (library_path + "/").c_str(), 1) == 0)
+	{
+		RE_LOG_ERROR("Can't mount Library pack %s: %s", library_pack_path.c_str(), PHYSFS_getLastError());
+		library_pack_path.clear();
+		return false;
+	}
+
+	RE_LOG("Mounted Library pack %s", library_pack_path.c_str());
+	return true;
+}
+
+bool RE_FileSystem::RepackLibrary()
+{
+	eastl::string libraryDir = library_path + "/";
+	eastl::string pack = library_path + "." + RE_LibraryPack::extension;
+	eastl::string tmpPack = pack + ".tmp";
+
+	eastl::string oldPack = pack + ".old";
+
+	// Reads through the mounted pack too, so the new pack merges old entries with loose ones
+	eastl::vector<eastl::string> files;
+	RE_LibraryPack::CollectFiles(libraryDir.c_str(), files);
+	if (files.empty() || !RE_LibraryPack::Write(libraryDir.c_str(), files, tmpPack.c_str())) return false;
+
+	eastl::vector<eastl::string> loose;
+	RE_LibraryPack::CollectFiles(libraryDir.c_str(), loose, true);
+
+	if (!library_pack_path.empty())
+	{
+		RemovePath(library_pack_path.c_str());
+		library_pack_path.clear();
+	}
+
+	// The old pack is kept aside until the new one is mounted, any failure puts it back
+	eastl::string writeDir(PHYSFS_getWriteDir());
+	if (writeDir.back() != '/' && writeDir.back() != '\\') writeDir += PHYSFS_getDirSeparator();
+	bool hadPack = Exists(pack.c_str());
+	if (hadPack && rename((writeDir + pack).c_str(), (writeDir + oldPack).c_str()) != 0)
+	{
+		RE_LOG_ERROR("Can't move aside Library pack %s", pack.c_str());
+		PHYSFS_delete(tmpPack.c_str());
+		MountLibraryPack();
+		return false;
+	}
+
+	if (rename((writeDir + tmpPack).c_str(), (writeDir + pack).c_str()) != 0 || !MountLibraryPack())
+	{
+		RE_LOG_ERROR("Can't replace Library pack %s, keeping the previous one", pack.c_str());
+		PHYSFS_delete(tmpPack.c_str());
+		if (hadPack)
+		{
+			PHYSFS_delete(pack.c_str());
+			rename((writeDir + oldPack).c_str(), (writeDir + pack).c_str());
+		}
+		MountLibraryPack();
+		return false;
+	}
+
+	// Only redundant once the new pack serves them
+	for (const auto& file : loose) PHYSFS_delete(file.c_str());
+	if (hadPack) PHYSFS_delete(oldPack.c_str());
+
+	return true;
+}
+
+RE_AssetDatabase* RE_FileSystem::GetAssetDatabase() const { return assetDatabase; }
+
+eastl::string RE_FileSystem::GetAssetMD5(const char* path, const char* buffer, size_t size)
+{
+	return assetDatabase->GetMD5(path, buffer, size);
+}
+
 RE_Json* RE_FileSystem::ConfigNode(const char* node) const
 {
 	return (config != nullptr && node != nullptr) ? config->GetRootNode(node) : nullptr;
 }
 
+RE_JsonCursor RE_FileSystem::ConfigCursor(const char* node) const
+{
+	return (config != nullptr) ? config->GetRootCursor(node) : nullptr;
+}
+
 void RE_FileSystem::SaveConfig() const
 {
 	config->Save();
@@ -775,59 +1024,196 @@ void RE_FileSystem::RE_Directory::SetPath(const char* _path)
 
 eastl::list< RE_FileSystem::RE_Directory*> RE_FileSystem::RE_Directory::MountTreeFolders()
 {
+	// Breadth first. PhysFS enumerates and stats under its global lock, so every folder of a level
+	// backed by a single mounted directory is listed natively on the worker pool. The rest, such as
+	// archives or folders merged from several mounts, go through PhysFS on this thread.
+	eastl::vector<RE_Directory*> level;
+	level.push_back(this);
+	while (!level.empty())
+	{
+		eastl::vector<eastl::string> nativePaths(level.size());
+		for (size_t i = 0; i < level.size(); i++) nativePaths[i] = level[i]->NativePath();
+
+		eastl::vector<eastl::vector<RE_DirectoryEntry>> scans(level.size());
+		std::atomic<size_t> next = 0;
+		RE_WorkerPool::Get().Run([&]()
+			{
+				for (size_t i = next++; i < level.size(); i = next++)
+					if (!nativePaths[i].empty()) scans[i] = level[i]->ScanNative(nativePaths[i].c_str());
+			});
+
+		// Each listing sits in its folder's slot, so the tree is linked in the same order every time
+		eastl::vector<RE_Directory*> nextLevel;
+		for (size_t i = 0; i < level.size(); i++)
+		{
+			RE_Directory* dir = level[i];
+			eastl::vector<RE_DirectoryEntry> scan = nativePaths[i].empty() ? dir->Scan() : eastl::move(scans[i]);
+			for (const RE_DirectoryEntry& entry : scan)
+			{
+				if (entry.pType != PathType::FOLDER) continue;
+
+				RE_Directory* newDirectory = new RE_Directory();
+				newDirectory->SetPath((entry.path + "/").c_str());
+				newDirectory->parent = dir;
+				newDirectory->pType = PathType::FOLDER;
+				dir->tree.push_back(newDirectory->AsPath());
+				nextLevel.push_back(newDirectory);
+			}
+
+			// First CheckAndApply reuses this listing instead of enumerating again
+			dir->mountScan = eastl::move(scan);
+			dir->hasMountScan = true;
+		}
+
+		level = eastl::move(nextLevel);
+	}
+
 	eastl::list< RE_Directory*> ret;
-	if (RE_FS->Exists(path.c_str()))
+	CollectSubdirectories(ret);
+	return ret;
+}
+
+void RE_FileSystem::RE_Directory::CollectSubdirectories(eastl::list<RE_Directory*>& ret) const
+{
+	for (RE_Path* path : tree)
+		if (path->pType == PathType::FOLDER)
+			ret.push_back(path->AsDirectory());
+
+	for (RE_Path* path : tree)
+		if (path->pType == PathType::FOLDER)
+			path->AsDirectory()->CollectSubdirectories(ret);
+}
+
+eastl::vector<RE_FileSystem::RE_DirectoryEntry> RE_FileSystem::RE_Directory::Scan() const
+{
+	eastl::vector<RE_DirectoryEntry> ret;
+	if (PHYSFS_exists(path.c_str()))
 	{
-		eastl::string iterPath(path);
-		char** rc = PHYSFS_enumerateFiles(iterPath.c_str());
+		char** rc = PHYSFS_enumerateFiles(path.c_str());
 		for (char** i = rc; *i != NULL; i++)
 		{
-			eastl::string inPath(iterPath);
-			inPath += *i;
+			RE_DirectoryEntry entry;
+			entry.path = path;
+			entry.path += *i;
 
 			PHYSFS_Stat fileStat;
-			if (PHYSFS_stat(inPath.c_str(), &fileStat) && fileStat.filetype == PHYSFS_FileType::PHYSFS_FILETYPE_DIRECTORY)
+			if (PHYSFS_stat(entry.path.c_str(), &fileStat))
 			{
-				RE_Directory* newDirectory = new RE_Directory();
-				newDirectory->SetPath((inPath += "/").c_str());
-				newDirectory->parent = this;
-				newDirectory->pType = PathType::FOLDER;
-				tree.push_back(newDirectory->AsPath());
-				ret.push_back(newDirectory);
+				if (fileStat.filetype == PHYSFS_FileType::PHYSFS_FILETYPE_DIRECTORY)
+					entry.pType = PathType::FOLDER;
+				else if (fileStat.filetype == PHYSFS_FileType::PHYSFS_FILETYPE_REGULAR)
+				{
+					entry.pType = PathType::FILE;
+					entry.fType = RE_File::DetectExtensionAndType(entry.path.c_str(), entry.extension);
+				}
+				entry.size = fileStat.filesize;
+				entry.modtime = fileStat.modtime;
 			}
+
+			ret.push_back(eastl::move(entry));
 		}
 		PHYSFS_freeList(rc);
+	}
+	return ret;
+}
+
+eastl::string RE_FileSystem::RE_Directory::NativePath() const
+{
+	eastl::string ret;
+	size_t sources = 0;
+
+	char** searchPath = PHYSFS_getSearchPath();
+	for (char** i = searchPath; *i != NULL && sources < 2; i++)
+	{
+		// Mount points are "/" for the root and end with a slash otherwise, as folder paths do
+		eastl::string mountPoint = PHYSFS_getMountPoint(*i);
+		if (mountPoint == "/") mountPoint.clear();
+
+		if (path.compare(0, mountPoint.size(), mountPoint) == 0)
+		{
+			std::error_code error;
+			std::filesystem::path native = NativeFromUTF8(*i) / NativeFromUTF8(path.c_str() + mountPoint.size());
+			if (std::filesystem::is_directory(native, error))
+			{
+				ret = UTF8FromNative(native);
+				sources++;
+			}
+		}
+		// Something mounted inside this folder only shows up through PhysFS
+		else if (mountPoint.compare(0, path.size(), path) == 0) sources = 2;
+	}
+	PHYSFS_freeList(searchPath);
+
+	if (sources != 1) ret.clear();
+	return ret;
+}
+
+eastl::vector<RE_FileSystem::RE_DirectoryEntry> RE_FileSystem::RE_Directory::ScanNative(const char* nativePath) const
+{
+	eastl::vector<RE_DirectoryEntry> ret;
+	const bool followLinks = PHYSFS_symbolicLinksPermitted() != 0;
+
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(NativeFromUTF8(nativePath), error), end; !error && it != end; it.increment(error))
+	{
+		// PhysFS leaves symbolic links out unless they were permitted
+		if (!followLinks && it->is_symlink(error)) continue;
 
-		if (!tree.empty())
+		RE_DirectoryEntry entry;
+		entry.path = path;
+		entry.path += UTF8FromNative(it->path().filename());
+
+		std::error_code statError;
+		std::filesystem::file_status status = it->status(statError);
+		if (!statError)
 		{
-			for (RE_Path* path : tree)
+			if (std::filesystem::is_directory(status))
+				entry.pType = PathType::FOLDER;
+			else if (std::filesystem::is_regular_file(status))
 			{
-				eastl::list< RE_Directory*> fromChild = path->AsDirectory()->MountTreeFolders();
-				if (!fromChild.empty()) ret.insert(ret.end(), fromChild.begin(), fromChild.end());
+				entry.pType = PathType::FILE;
+				entry.fType = RE_File::DetectExtensionAndType(entry.path.c_str(), entry.extension);
+				entry.size = static_cast<signed long long>(it->file_size(statError));
 			}
+
+			// Seconds since the epoch, as PHYSFS_stat reports them
+			std::filesystem::file_time_type modtime = it->last_write_time(statError);
+			if (!statError)
+				entry.modtime = std::chrono::duration_cast<std::chrono::seconds>(
+					std::chrono::clock_cast<std::chrono::system_clock>(modtime).time_since_epoch()).count();
 		}
+
+		ret.push_back(eastl::move(entry));
 	}
+
+	// PhysFS lists entries sorted byte by byte
+	eastl::sort(ret.begin(), ret.end(), [](const RE_DirectoryEntry& a, const RE_DirectoryEntry& b) { return strcmp(a.path.c_str(), b.path.c_str()) < 0; });
 	return ret;
 }
 
 eastl::stack<RE_FileSystem::RE_ProcessPath*> RE_FileSystem::RE_Directory::CheckAndApply(eastl::vector<RE_Meta*>* metaRecentlyAdded)
 {
 	eastl::stack<RE_ProcessPath*> ret;
-	if (RE_FS->Exists(path.c_str()))
+	eastl::vector<RE_DirectoryEntry> entries;
+	if (hasMountScan)
+	{
+		entries = eastl::move(mountScan);
+		mountScan.clear();
+		hasMountScan = false;
+	}
+	else entries = Scan();
+
+	if (!entries.empty())
 	{
-		eastl::string iterPath(path);
 		eastl::vector<RE_Meta*> toRemoveM;
-		char** rc = PHYSFS_enumerateFiles(iterPath.c_str());
 		auto iter = tree.begin();
-		for (char** i = rc; *i != NULL; i++)
+		for (const RE_DirectoryEntry& entry : entries)
 		{
 			PathType iterTreeType = (iter != tree.end()) ? (*iter)->pType : PathType::NONE;
-			eastl::string inPath(iterPath);
-			inPath += *i;
-			PHYSFS_Stat fileStat;
-			if (PHYSFS_stat(inPath.c_str(), &fileStat))
+			eastl::string inPath(entry.path);
+			if (entry.pType != PathType::NONE)
 			{
-				if (fileStat.filetype == PHYSFS_FileType::PHYSFS_FILETYPE_DIRECTORY)
+				if (entry.pType == PathType::FOLDER)
 				{
 					bool newFolder = (iterTreeType == PathType::NONE || iterTreeType != PathType::FOLDER || (*iter)->path != (inPath += "/"));
 					if (newFolder && iter != tree.end())
@@ -861,10 +1247,10 @@ eastl::stack<RE_FileSystem::RE_ProcessPath*> RE_FileSystem::RE_Directory::CheckA
 						ret.push(new RE_ProcessPath(PathProcess::ADDFOLDER, newDirectory->AsPath()));
 					}
 				}
-				else if (fileStat.filetype == PHYSFS_FileType::PHYSFS_FILETYPE_REGULAR)
+				else
 				{
-					const char* extension = nullptr;
-					FileType fileType = RE_File::DetectExtensionAndType(inPath.c_str(), extension);
+					const char* extension = entry.extension;
+					FileType fileType = entry.fType;
 					bool newFile = (iterTreeType == PathType::NONE || iterTreeType != PathType::FILE || (*iter)->path != inPath);
 					if (newFile && fileType == FileType::META && !metaRecentlyAdded->empty())
 					{
@@ -907,17 +1293,29 @@ eastl::stack<RE_FileSystem::RE_ProcessPath*> RE_FileSystem::RE_Directory::CheckA
 						RE_File* newFile = (fileType != FileType::META) ? new RE_File() : (RE_File*)new RE_Meta();
 						newFile->path = inPath;
 						newFile->filename = inPath.substr(inPath.find_last_of("/") + 1);
-						newFile->lastSize = fileStat.filesize;
+						newFile->lastSize = entry.size;
 						newFile->pType = PathType::FILE;
 						newFile->fType = fileType;
 						newFile->extension = extension;
-						newFile->lastModified = fileStat.modtime;
+						newFile->lastModified = entry.modtime;
 
 						ret.push(new RE_ProcessPath(PathProcess::ADDFILE, newFile->AsPath()));
 						AddBeforeOf(newFile->AsPath(), iter);
 						iter--;
 					}
-					else if ((*iter)->AsFile()->fType == FileType::META)
+					else if ((*iter)->AsFile()->fType != FileType::META)
+					{
+						// Only stat is tracked while walking, content is hashed again by the reimport
+						RE_File* file = (*iter)->AsFile();
+						if (file->path == inPath && (file->lastModified != entry.modtime || file->lastSize != entry.size))
+						{
+							file->lastModified = entry.modtime;
+							file->lastSize = entry.size;
+							if (file->metaResource != nullptr)
+								ret.push(new RE_ProcessPath(PathProcess::REIMPORT, file->metaResource->AsPath()));
+						}
+					}
+					else
 					{
 						bool reimport = false;
 						ResourceContainer* res = RE_RES->At((*iter)->AsFile()->AsMeta()->resource);
@@ -933,9 +1331,9 @@ eastl::stack<RE_FileSystem::RE_ProcessPath*> RE_FileSystem::RE_Directory::CheckA
 						case ResourceContainer::Type::PARTICLE_RENDER:
 						case ResourceContainer::Type::PARTICLE_EMISSION:
 						{
-							if ((*iter)->AsFile()->lastModified != fileStat.modtime)
+							if ((*iter)->AsFile()->lastModified != entry.modtime)
 							{
-								(*iter)->AsFile()->lastModified = fileStat.modtime;
+								(*iter)->AsFile()->lastModified = entry.modtime;
 								ret.push(new RE_ProcessPath(PathProcess::REIMPORT, *iter));
 							}
 							break;
@@ -946,7 +1344,6 @@ eastl::stack<RE_FileSystem::RE_ProcessPath*> RE_FileSystem::RE_Directory::CheckA
 			}
 			if (iter != tree.end()) iter++;
 		}
-		PHYSFS_freeList(rc);
 	}
 	return ret;
 }
@@ -10,7 +10,10 @@
 
 class Config;
 class RE_Json;
+class RE_JsonCursor;
 class RE_FileBuffer;
+class RE_AssetDatabase;
+class RE_AssetWatcher;
 class RE_GameObject;
 class ResourceContainer;
 struct Vertex;
@@ -100,6 +103,17 @@ public:
 		{}
 	};
 
+	// Listing of one directory entry, gathered before it's applied to the tree
+	struct RE_DirectoryEntry
+	{
+		eastl::string path;
+		PathType pType = PathType::NONE;
+		FileType fType = FileType::NONE;
+		const char* extension = nullptr;
+		signed long long size = 0;
+		signed long long modtime = 0;
+	};
+
 	struct RE_Directory : public RE_Path
 	{
 		eastl::string name;
@@ -113,11 +127,26 @@ public:
 		eastl::list<RE_Directory*> MountTreeFolders();
 		eastl::stack<RE_ProcessPath*> CheckAndApply(eastl::vector<RE_Meta*>* metaRecentlyAdded);
 
+		// Only enumerates and stats through PhysFS, the tree is left untouched
+		eastl::vector<RE_DirectoryEntry> Scan() const;
+
+		// Native directory behind the folder when a single mounted directory provides all of it, empty otherwise
+		eastl::string NativePath() const;
+		// Same listing as Scan read from the native directory, never touches PhysFS so workers can run it
+		eastl::vector<RE_DirectoryEntry> ScanNative(const char* nativePath) const;
+
 		eastl::stack<RE_Path*> GetDisplayingFiles() const;
 
 		eastl::list<RE_Directory*> FromParentToThis();
 
 		RE_Path* AsPath()const { return (RE_Path*)this; }
+
+	private:
+
+		void CollectSubdirectories(eastl::list<RE_Directory*>& ret) const;
+
+		eastl::vector<RE_DirectoryEntry> mountScan;
+		bool hasMountScan = false;
 	};
 
 public:
@@ -156,16 +185,27 @@ public:
 
 	signed long long GetLastTimeModified(const char* path);
 
+	bool MountLibraryPack();
+	bool RepackLibrary();
+
+	RE_AssetDatabase* GetAssetDatabase() const;
+	eastl::string GetAssetMD5(const char* path, const char* buffer = nullptr, size_t size = 0);
+
 	RE_Json* ConfigNode(const char* node) const;
+	RE_JsonCursor ConfigCursor(const char* node) const;
 	void SaveConfig() const;
 
 private:
 
 	void CopyDirectory(const char* origin, const char* dest);
 
+	void QueueWatchedChanges();
+	void RemoveFromTree(RE_Path* path);
+
 private:
 
 	eastl::string engine_path, project_path, library_path, assets_path, write_path, pref_directory;
+	eastl::string library_pack_path;
 
 	RE_Directory* rootAssetDirectory = nullptr;
 	eastl::list<RE_Directory*> assetsDirectories;
@@ -189,7 +229,13 @@ private:
 	eastl::priority_queue<RE_File*, eastl::vector<RE_File*>, AssetsPrioroty> toImport;
 	eastl::priority_queue<RE_File*, eastl::vector<RE_File*>, AssetsPrioroty> toReImport;
 
+	void DropQueued(RE_Path* path, eastl::stack<RE_ProcessPath*>& processes);
+	void DropQueued(RE_File* file, eastl::priority_queue<RE_File*, eastl::vector<RE_File*>, AssetsPrioroty>& files);
+
 	Config* config = nullptr;
+	RE_AssetDatabase* assetDatabase = nullptr;
+	RE_AssetWatcher* assetWatcher = nullptr;
+	bool assetsScanned = false;
 };
 
 #endif // !__FILESYSTEM_H__
\ No newline at end of file
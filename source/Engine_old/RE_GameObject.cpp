@@ -1053,14 +1053,14 @@ void RE_GameObject::SerializeJson(RE_Json * node)
 	node->PushFloatVector("scale", t->GetLocalScale());
 }
 
-void RE_GameObject::DeserializeJSON(RE_Json* node, GameObjectsPool* goPool, ComponentsPool* cmpsPool)
+void RE_GameObject::DeserializeJSON(const RE_JsonCursor& node, GameObjectsPool* goPool, ComponentsPool* cmpsPool)
 {
-	SetUp(goPool, cmpsPool, node->PullString("name", "GameObject"), node->PullUnsignedLongLong("Parent Pool ID", 0));
+	SetUp(goPool, cmpsPool, node.PullString("name", "GameObject"), node.PullUnsignedLongLong("Parent Pool ID", 0));
 
 	auto t = dynamic_cast<RE_CompTransform*>(CompPtr(transform, RE_Component::Type::TRANSFORM));
-	t->SetPosition(node->PullFloatVector("position", math::vec::zero));
-	t->SetRotation(node->PullFloatVector("rotation", math::vec::zero));
-	t->SetScale(node->PullFloatVector("scale", math::vec::one));
+	t->SetPosition(node.PullFloatVector("position", math::vec::zero));
+	t->SetRotation(node.PullFloatVector("rotation", math::vec::zero));
+	t->SetScale(node.PullFloatVector("scale", math::vec::one));
 }
 
 void RE_GameObject::SerializeBinary(char*& cursor)
@@ -159,7 +159,7 @@ public:
 	// Serialization
 	size_t GetBinarySize() const;
 	void SerializeJson(class RE_Json* node);
-	void DeserializeJSON(RE_Json* node, GameObjectsPool* goPool, ComponentsPool* cmpsPool);
+	void DeserializeJSON(const class RE_JsonCursor& node, GameObjectsPool* goPool, ComponentsPool* cmpsPool);
 	void SerializeBinary(char*& cursor);
 	void DeserializeBinary(char*& cursor, GameObjectsPool* goPool, ComponentsPool* compPool);
 
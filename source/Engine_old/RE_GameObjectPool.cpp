@@ -6,6 +6,8 @@
 #include "RE_Json.h"
 #include "RE_ComponentsPool.h"
 
+#include <stdio.h>
+
 void GameObjectsPool::Clear()
 {
 	key_map.clear();
@@ -117,6 +119,43 @@ void GameObjectsPool::DeserializeBinary(char*& cursor, ComponentsPool* cmpsPool)
 	}
 }
 
+size_t GameObjectsPool::GetBinaryBlockSize() const
+{
+	size_t size = lastAvaibleIndex * sizeof(GO_UID);
+	for (int i = 0; i < lastAvaibleIndex; i++)
+		size += pool_[i].GetBinarySize();
+	return size;
+}
+
+void GameObjectsPool::SerializeBinaryBlock(char* cursor)
+{
+	size_t goSize = GetCount();
+	for (size_t i = 0; i < goSize; i++)
+	{
+		memcpy(cursor, &pool_[i].go_uid, sizeof(GO_UID));
+		cursor += sizeof(GO_UID);
+	}
+
+	for (size_t i = 0; i < goSize; i++) pool_[i].SerializeBinary(cursor);
+}
+
+void GameObjectsPool::DeserializeBinaryBlock(char* cursor, size_t count, ComponentsPool* cmpsPool)
+{
+	RE_HashMap::Reserve(count);
+
+	const char* uids = cursor;
+	cursor += count * sizeof(GO_UID);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		RE_GameObject newGO; GO_UID goUID;
+		memcpy(&goUID, uids + i * sizeof(GO_UID), sizeof(GO_UID));
+		newGO.go_uid = goUID;
+		RE_HashMap::Push(newGO, goUID);
+		AtPtr(goUID)->DeserializeBinary(cursor, this, cmpsPool);
+	}
+}
+
 void GameObjectsPool::SerializeJson(RE_Json* node)
 {
 	RE_Json* goPool = node->PushJObject("gameobjects Pool");
@@ -132,23 +171,23 @@ void GameObjectsPool::SerializeJson(RE_Json* node)
 	DEL(goPool)
 }
 
-void GameObjectsPool::DeserializeJson(RE_Json* node, ComponentsPool* cmpsPool)
+void GameObjectsPool::DeserializeJson(const RE_JsonCursor& node, ComponentsPool* cmpsPool)
 {
-	eastl::map<GO_UID, RE_GameObject*> idGO;
-	RE_Json* goPool = node->PullJObject("gameobjects Pool");
-	auto goSize = goPool->PullSizeT("gameobjectsSize", 0);
+	RE_JsonCursor goPool = node.Child("gameobjects Pool");
+	auto goSize = goPool.PullSizeT("gameobjectsSize", 0);
+	RE_HashMap::Reserve(goSize);
 
+	char key[24];
 	for (size_t i = 0; i < goSize; i++)
 	{
-		RE_Json* goNode = goPool->PullJObject(eastl::to_string(i).c_str());
-		GO_UID goUID = goNode->PullUnsignedLongLong("GOUID", 0);
+		snprintf(key, sizeof(key), "%zu", i);
+		RE_JsonCursor goNode = goPool.Child(key, i + 1);
+		GO_UID goUID = goNode.PullUnsignedLongLong("GOUID", 0);
 		RE_GameObject newGO;
 		newGO.go_uid = goUID;
 		RE_HashMap::Push(newGO, goUID);
 		AtPtr(goUID)->DeserializeJSON(goNode, this, cmpsPool);
-		DEL(goNode)
 	}
-	DEL(goPool)
 }
 
 eastl::vector<GO_UID> GameObjectsPool::GetAllKeys() const
@@ -33,8 +33,12 @@ public:
 	void SerializeBinary(char*& cursor);
 	void DeserializeBinary(char*& cursor, ComponentsPool* cmpsPool);
 
+	size_t GetBinaryBlockSize() const;
+	void SerializeBinaryBlock(char* cursor);
+	void DeserializeBinaryBlock(char* cursor, size_t count, ComponentsPool* cmpsPool);
+
 	void SerializeJson(RE_Json* node);
-	void DeserializeJson(RE_Json* node, ComponentsPool* cmpsPool);
+	void DeserializeJson(const RE_JsonCursor& node, ComponentsPool* cmpsPool);
 
 	eastl::vector<GO_UID> GetAllKeys() const override;
 
@@ -53,11 +53,19 @@ public:
 
 	size_t GetCount() const { return key_map.size(); }
 
+	// Grows the array once to fit count more values, for bulk loads
+	void Reserve(const size_t count)
+	{
+		size_t needed = static_cast<size_t>(lastAvaibleIndex) + count;
+		if (needed > currentSize) Resize(static_cast<unsigned int>(needed));
+	}
+
 private:
 
-	void IncrementArray()
+	void IncrementArray() { Resize(currentSize + Increment); }
+
+	void Resize(unsigned int newSize)
 	{
-		unsigned int newSize = currentSize + Increment;
 		poolTmp_ = new TYPEVALUE[newSize];
 		eastl::copy(pool_, pool_ + currentSize, poolTmp_);
 		currentSize = newSize;
@@ -7,15 +7,25 @@ RE_Json::RE_Json(const char* path, Config* config, bool isArray) : pointerPath(p
 	if (isArray) rapidjson::Pointer(path).Get(config->document)->SetArray();
 }
 
+RE_Json::RE_Json(RE_JsonWriter* writer) : writer(writer) {}
 RE_Json::RE_Json(RE_Json& node) : pointerPath(node.pointerPath), config(node.config) {}
-RE_Json::~RE_Json() { config = nullptr; }
+RE_Json::~RE_Json()
+{
+	if (writer) writer->EndObject();
+	config = nullptr;
+}
 
 
 // Push ============================================================
 
 void RE_Json::PushSizeT(const char* name, const size_t value)
 {
-	if (name)
+	if (name && writer)
+	{
+		writer->Key(name);
+		writer->Value(static_cast<ulonglong>(value));
+	}
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Pointer(path.c_str()).Set(config->document, value);
@@ -24,7 +34,14 @@ void RE_Json::PushSizeT(const char* name, const size_t value)
 
 void RE_Json::PushSizeT(const char* name, const size_t* value, uint quantity)
 {
-	if (name)
+	if (name && writer)
+	{
+		writer->Key(name);
+		writer->StartArray();
+		for (uint i = 0; i < quantity; i++) writer->Value(static_cast<ulonglong>(value[i]));
+		writer->EndArray();
+	}
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value values_array(rapidjson::kArrayType);
@@ -35,7 +52,8 @@ void RE_Json::PushSizeT(const char* name, const size_t* value, uint quantity)
 
 void RE_Json::PushFloat2(const char* name, math::float2 value)
 {
-	if (name)
+	if (name && writer) writer->Floats(name, value.ptr(), 2);
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value float_array(rapidjson::kArrayType);
@@ -46,7 +64,8 @@ void RE_Json::PushFloat2(const char* name, math::float2 value)
 
 void RE_Json::PushFloatVector(const char* name, math::vec vector)
 {
-	if (name)
+	if (name && writer) writer->Floats(name, vector.ptr(), 3);
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value float_array(rapidjson::kArrayType);
@@ -57,7 +76,8 @@ void RE_Json::PushFloatVector(const char* name, math::vec vector)
 
 void RE_Json::PushFloat4(const char* name, math::float4 vector)
 {
-	if (name)
+	if (name && writer) writer->Floats(name, vector.ptr(), 4);
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value float_array(rapidjson::kArrayType);
@@ -68,7 +88,8 @@ void RE_Json::PushFloat4(const char* name, math::float4 vector)
 
 void RE_Json::PushMat3(const char* name, math::float3x3 mat3)
 {
-	if (name)
+	if (name && writer) writer->Floats(name, mat3.ptr(), 9);
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value float_array(rapidjson::kArrayType);
@@ -79,7 +100,8 @@ void RE_Json::PushMat3(const char* name, math::float3x3 mat3)
 
 void RE_Json::PushMat4(const char* name, math::float4x4 mat4)
 {
-	if (name)
+	if (name && writer) writer->Floats(name, mat4.ptr(), 16);
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		rapidjson::Value float_array(rapidjson::kArrayType);
@@ -90,6 +112,12 @@ void RE_Json::PushMat4(const char* name, math::float4x4 mat4)
 
 void RE_Json::PushValue(rapidjson::Value* val)
 {
+	if (writer)
+	{
+		writer->Value(*val);
+		return;
+	}
+
 	rapidjson::Value* val_push = rapidjson::Pointer(pointerPath.c_str()).Get(config->document);
 	if (val_push->IsArray()) val_push->PushBack(*val, config->document.GetAllocator());
 }
@@ -98,7 +126,13 @@ RE_Json* RE_Json::PushJObject(const char* name)
 {
 	RE_Json* ret = nullptr;
 
-	if (name)
+	if (name && writer)
+	{
+		writer->Key(name);
+		writer->StartObject();
+		ret = new RE_Json(writer);
+	}
+	else if (name)
 	{
 		eastl::string path = pointerPath + "/" + name;
 		ret = new RE_Json(path.c_str(), config);
@@ -460,6 +494,11 @@ RE_Json* RE_Json::PullJObject(const char* name)
 	return ret;
 }
 
+RE_JsonCursor RE_Json::GetCursor() const
+{
+	return config ? rapidjson::Pointer(pointerPath.c_str()).Get(config->document) : nullptr;
+}
+
 rapidjson::Value::Array RE_Json::PullValueArray() { return config->document.FindMember(pointerPath.c_str())->value.GetArray(); }
 inline bool RE_Json::operator!() const { return config || pointerPath.empty(); }
 const char* RE_Json::GetDocumentPath() const { return pointerPath.c_str(); }
@@ -3,6 +3,8 @@
 
 #include "RE_DataTypes.h"
 #include "RE_Config.h"
+#include "RE_JsonWriter.h"
+#include "RE_JsonCursor.h"
 #include <RapidJson/rapidjson.h>
 #include <RapidJson/document.h>
 #include <RapidJson/pointer.h>
@@ -20,6 +22,7 @@ class RE_Json
 public:
 
 	RE_Json(const char* path = nullptr, Config* config = nullptr, bool isArray = false);
+	RE_Json(RE_JsonWriter* writer); // Streaming node: pushes are written in order, pulls are not available
 	~RE_Json();
 
 	// Push
@@ -62,6 +65,9 @@ public:
 	RE_Json *				PullJObject(const char* name);
 	rapidjson::Value::Array	PullValueArray();
 
+	// Resolves the node once, for loads that walk many children
+	RE_JsonCursor			GetCursor() const;
+
 	// Utility
 	inline bool operator!() const;
 	const char* GetDocumentPath() const;
@@ -77,6 +83,7 @@ private:
 private:
 
 	Config* config = nullptr;
+	RE_JsonWriter* writer = nullptr;
 	eastl::string pointerPath;
 };
 
@@ -84,6 +91,12 @@ template<typename T>
 inline void RE_Json::Push(const char* name, const T value)
 {
 	if (!name) return;
+	if (writer)
+	{
+		writer->Key(name);
+		writer->Value(value);
+		return;
+	}
 	eastl::string path = pointerPath + "/" + name;
 	rapidjson::Pointer(path.c_str()).Set(config->document, value);
 }
@@ -92,6 +105,14 @@ template<typename T>
 inline void RE_Json::Push(const char* name, const T* value, uint quantity)
 {
 	if (!name) return;
+	if (writer)
+	{
+		writer->Key(name);
+		writer->StartArray();
+		for (uint i = 0; i < quantity; i++) writer->Value(value[i]);
+		writer->EndArray();
+		return;
+	}
 	eastl::string path = pointerPath + "/" + name;
 	rapidjson::Value values_array(rapidjson::kArrayType);
 	for (uint i = 0; i < quantity; i++) values_array.PushBack(value[i], config->document.GetAllocator());
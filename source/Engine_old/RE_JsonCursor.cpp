@@ -0,0 +1,158 @@
+#include "RE_JsonCursor.h"
+
+#include <string.h>
+
+size_t RE_JsonCursor::Size() const
+{
+	if (IsObject()) return value->MemberCount();
+	if (IsArray()) return value->Size();
+	return 0;
+}
+
+RE_JsonCursor RE_JsonCursor::Child(const char* name, size_t hint) const
+{
+	if (!IsObject() || !name) return nullptr;
+
+	if (hint < value->MemberCount())
+	{
+		auto member = value->MemberBegin() + hint;
+		if (strcmp(member->name.GetString(), name) == 0) return &member->value;
+	}
+
+	return Find(name);
+}
+
+RE_JsonCursor RE_JsonCursor::At(size_t index) const
+{
+	return (IsArray() && index < value->Size()) ? &(*value)[static_cast<rapidjson::SizeType>(index)] : nullptr;
+}
+
+const rapidjson::Value* RE_JsonCursor::Find(const char* name) const
+{
+	if (!IsObject() || !name) return nullptr;
+	auto member = value->FindMember(name);
+	return (member != value->MemberEnd()) ? &member->value : nullptr;
+}
+
+bool RE_JsonCursor::PullFloats(const char* name, float* values, uint quantity) const
+{
+	const rapidjson::Value* val = Find(name);
+	if (!val || !val->IsArray() || val->Size() < quantity) return false;
+
+	for (uint i = 0; i < quantity; i++)
+	{
+		const rapidjson::Value& element = (*val)[i];
+		if (!element.IsNumber()) return false;
+		values[i] = element.GetFloat();
+	}
+
+	return true;
+}
+
+// Pull ============================================================
+
+bool RE_JsonCursor::PullBool(const char* name, bool deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsBool()) ? val->GetBool() : deflt;
+}
+
+int RE_JsonCursor::PullInt(const char* name, int deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsInt()) ? val->GetInt() : deflt;
+}
+
+unsigned int RE_JsonCursor::PullUInt(const char* name, uint deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsUint()) ? val->GetUint() : deflt;
+}
+
+size_t RE_JsonCursor::PullSizeT(const char* name, size_t deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsUint64()) ? static_cast<size_t>(val->GetUint64()) : deflt;
+}
+
+float RE_JsonCursor::PullFloat(const char* name, float deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsNumber()) ? val->GetFloat() : deflt;
+}
+
+math::float2 RE_JsonCursor::PullFloat2(const char* name, math::float2 deflt) const
+{
+	math::float2 ret;
+	return PullFloats(name, ret.ptr(), 2) ? ret : deflt;
+}
+
+math::vec RE_JsonCursor::PullFloatVector(const char* name, math::vec deflt) const
+{
+	math::vec ret;
+	return PullFloats(name, ret.ptr(), 3) ? ret : deflt;
+}
+
+math::float4 RE_JsonCursor::PullFloat4(const char* name, math::float4 deflt) const
+{
+	math::float4 ret;
+	return PullFloats(name, ret.ptr(), 4) ? ret : deflt;
+}
+
+math::float3x3 RE_JsonCursor::PullMat3(const char* name, math::float3x3 deflt) const
+{
+	math::float3x3 ret;
+	return PullFloats(name, ret.ptr(), 9) ? ret : deflt;
+}
+
+math::float4x4 RE_JsonCursor::PullMat4(const char* name, math::float4x4 deflt) const
+{
+	math::float4x4 ret;
+	return PullFloats(name, ret.ptr(), 16) ? ret : deflt;
+}
+
+double RE_JsonCursor::PullDouble(const char* name, double deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsNumber()) ? val->GetDouble() : deflt;
+}
+
+signed long long RE_JsonCursor::PullSignedLongLong(const char* name, signed long long deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsInt64()) ? val->GetInt64() : deflt;
+}
+
+unsigned long long RE_JsonCursor::PullUnsignedLongLong(const char* name, unsigned long long deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsUint64()) ? val->GetUint64() : deflt;
+}
+
+const char* RE_JsonCursor::PullString(const char* name, const char* deflt) const
+{
+	const rapidjson::Value* val = Find(name);
+	return (val && val->IsString()) ? val->GetString() : deflt;
+}
+
+// Values ============================================================
+
+bool RE_JsonCursor::GetBool(bool deflt) const { return (value && value->IsBool()) ? value->GetBool() : deflt; }
+int RE_JsonCursor::GetInt(int deflt) const { return (value && value->IsInt()) ? value->GetInt() : deflt; }
+uint RE_JsonCursor::GetUInt(uint deflt) const { return (value && value->IsUint()) ? value->GetUint() : deflt; }
+float RE_JsonCursor::GetFloat(float deflt) const { return (value && value->IsNumber()) ? value->GetFloat() : deflt; }
+const char* RE_JsonCursor::GetString(const char* deflt) const { return (value && value->IsString()) ? value->GetString() : deflt; }
+
+// Iteration ============================================================
+
+RE_JsonCursor::Range<RE_JsonCursor::MemberIterator> RE_JsonCursor::Members() const
+{
+	if (!IsObject()) return { MemberIterator(rapidjson::Value::ConstMemberIterator()), MemberIterator(rapidjson::Value::ConstMemberIterator()) };
+	return { MemberIterator(value->MemberBegin()), MemberIterator(value->MemberEnd()) };
+}
+
+RE_JsonCursor::Range<RE_JsonCursor::ElementIterator> RE_JsonCursor::Elements() const
+{
+	if (!IsArray()) return { ElementIterator(nullptr), ElementIterator(nullptr) };
+	return { ElementIterator(value->Begin()), ElementIterator(value->End()) };
+}
@@ -0,0 +1,110 @@
+#ifndef __RE_JSON_CURSOR_H__
+#define __RE_JSON_CURSOR_H__
+
+#include "RE_DataTypes.h"
+#include <RapidJson/document.h>
+#include <MGL/Math/float2.h>
+#include <MGL/Math/float3.h>
+#include <MGL/Math/float4.h>
+#include <MGL/Math/float3x3.h>
+#include <MGL/Math/float4x4.h>
+
+// Read-only view of a value in a loaded document. It is meant to live on the stack and
+// points straight at the rapidjson value, so walking nested objects and arrays neither
+// allocates nor builds pointer strings. Pulls mirror RE_Json's: missing keys, values of
+// another type and invalid cursors all return the default.
+class RE_JsonCursor
+{
+public:
+
+	RE_JsonCursor(const rapidjson::Value* value = nullptr) : value(value) {}
+
+	bool IsValid() const { return value != nullptr; }
+	bool IsObject() const { return value && value->IsObject(); }
+	bool IsArray() const { return value && value->IsArray(); }
+
+	// Object members or array elements
+	size_t Size() const;
+
+	// Hint is the member's expected position, checked before searching every member
+	RE_JsonCursor Child(const char* name, size_t hint = 0) const;
+	RE_JsonCursor At(size_t index) const;
+
+	// Pull
+	bool				PullBool(const char* name, bool deflt) const;
+	int					PullInt(const char* name, int deflt) const;
+	unsigned int		PullUInt(const char* name, uint deflt) const;
+	size_t				PullSizeT(const char* name, size_t deflt) const;
+	float				PullFloat(const char* name, float deflt) const;
+	math::float2		PullFloat2(const char* name, math::float2 deflt) const;
+	math::vec			PullFloatVector(const char* name, math::vec deflt) const;
+	math::float4		PullFloat4(const char* name, math::float4 deflt) const;
+	math::float3x3		PullMat3(const char* name, math::float3x3 deflt) const;
+	math::float4x4		PullMat4(const char* name, math::float4x4 deflt) const;
+	double				PullDouble(const char* name, double deflt) const;
+	signed long long	PullSignedLongLong(const char* name, signed long long deflt) const;
+	unsigned long long	PullUnsignedLongLong(const char* name, unsigned long long deflt) const;
+	const char*			PullString(const char* name, const char* deflt) const;
+
+	// Value of the cursor itself, for array elements
+	bool		GetBool(bool deflt) const;
+	int			GetInt(int deflt) const;
+	uint		GetUInt(uint deflt) const;
+	float		GetFloat(float deflt) const;
+	const char*	GetString(const char* deflt) const;
+
+	// Iteration
+	//	for (RE_JsonCursor::Member member : node.Members())
+	//	for (RE_JsonCursor element : node.Elements())
+	struct Member
+	{
+		const char* name;
+		RE_JsonCursor value;
+	};
+
+	class MemberIterator
+	{
+	public:
+		MemberIterator(rapidjson::Value::ConstMemberIterator it) : it(it) {}
+		Member operator*() const { return { it->name.GetString(), &it->value }; }
+		MemberIterator& operator++() { ++it; return *this; }
+		bool operator!=(const MemberIterator& other) const { return it != other.it; }
+
+	private:
+		rapidjson::Value::ConstMemberIterator it;
+	};
+
+	class ElementIterator
+	{
+	public:
+		ElementIterator(rapidjson::Value::ConstValueIterator it) : it(it) {}
+		RE_JsonCursor operator*() const { return it; }
+		ElementIterator& operator++() { ++it; return *this; }
+		bool operator!=(const ElementIterator& other) const { return it != other.it; }
+
+	private:
+		rapidjson::Value::ConstValueIterator it;
+	};
+
+	template<class Iterator>
+	struct Range
+	{
+		Iterator first, last;
+		Iterator begin() const { return first; }
+		Iterator end() const { return last; }
+	};
+
+	Range<MemberIterator> Members() const;
+	Range<ElementIterator> Elements() const;
+
+private:
+
+	const rapidjson::Value* Find(const char* name) const;
+	bool PullFloats(const char* name, float* values, uint quantity) const;
+
+private:
+
+	const rapidjson::Value* value = nullptr;
+};
+
+#endif // !__RE_JSON_CURSOR_H__
@@ -0,0 +1,79 @@
+#include "RE_JsonWriter.h"
+
+#include "RE_Memory.h"
+#include "RE_Assert.h"
+#include "Application.h"
+#include "RE_Json.h"
+#include <PhysFS/physfs.h>
+#include <EASTL/string.h>
+
+RE_JsonWriter::RE_JsonWriter(const char* file_name, size_t chunk_size) : writer(stream)
+{
+	if (file_name)
+	{
+		eastl::string path(file_name);
+		eastl::string dir = path.substr(0, path.find_last_of("/"));
+		if (PHYSFS_exists(dir.c_str()) == 0) PHYSFS_mkdir(dir.c_str());
+
+		if (!stream.Open(file_name, chunk_size))
+			RE_LOG_ERROR("Error while opening save file %s: %s", file_name, PHYSFS_getLastError());
+	}
+}
+
+RE_JsonWriter::~RE_JsonWriter() { Close(); }
+
+bool RE_JsonWriter::IsValid() const { return !stream.failed; }
+
+RE_Json* RE_JsonWriter::GetRootNode(const char* member)
+{
+	RE_ASSERT(member != nullptr && !rootOpen);
+	rootOpen = true;
+	writer.StartObject();
+	writer.Key(member);
+	writer.StartObject();
+	return new RE_Json(this);
+}
+
+bool RE_JsonWriter::Close()
+{
+	if (rootOpen)
+	{
+		writer.EndObject();
+		rootOpen = false;
+	}
+
+	const bool opened = stream.file != nullptr;
+	if (!stream.Close() && opened)
+		RE_LOG_ERROR("Error while writing save file: %s", PHYSFS_getLastError());
+
+	return writer.IsComplete() && !stream.failed;
+}
+
+const char* RE_JsonWriter::GetBuffer() const { return stream.buffer.c_str(); }
+size_t RE_JsonWriter::GetSize() const { return stream.buffer.size(); }
+
+void RE_JsonWriter::Key(const char* name) { writer.Key(name); }
+void RE_JsonWriter::StartObject() { writer.StartObject(); }
+void RE_JsonWriter::EndObject() { writer.EndObject(); }
+void RE_JsonWriter::StartArray() { writer.StartArray(); }
+void RE_JsonWriter::EndArray() { writer.EndArray(); }
+
+void RE_JsonWriter::Value(bool value) { writer.Bool(value); }
+void RE_JsonWriter::Value(int value) { writer.Int(value); }
+void RE_JsonWriter::Value(uint value) { writer.Uint(value); }
+void RE_JsonWriter::Value(long value) { writer.Int64(static_cast<int64_t>(value)); }
+void RE_JsonWriter::Value(ulong value) { writer.Uint64(static_cast<uint64_t>(value)); }
+void RE_JsonWriter::Value(long long value) { writer.Int64(value); }
+void RE_JsonWriter::Value(ulonglong value) { writer.Uint64(value); }
+void RE_JsonWriter::Value(float value) { writer.Double(static_cast<double>(value)); }
+void RE_JsonWriter::Value(double value) { writer.Double(value); }
+void RE_JsonWriter::Value(const char* value) { writer.String(value); }
+void RE_JsonWriter::Value(const rapidjson::Value& value) { value.Accept(writer); }
+
+void RE_JsonWriter::Floats(const char* name, const float* values, uint count)
+{
+	writer.Key(name);
+	writer.StartArray();
+	for (uint i = 0; i < count; i++) writer.Double(static_cast<double>(values[i]));
+	writer.EndArray(count);
+}
@@ -0,0 +1,60 @@
+#ifndef __RE_JSON_WRITER_H__
+#define __RE_JSON_WRITER_H__
+
+#include "RE_DataTypes.h"
+#include "../Modules/RE_PhysFSWriteStream.h"
+#include <RapidJson/document.h>
+#include <RapidJson/writer.h>
+
+class RE_Json;
+
+// Emits JSON while it is pushed, without building a document. Output goes to a PhysFS
+// file in fixed size chunks or, without a file name, into a growable buffer.
+// Nodes from GetRootNode write through it and close their object when deleted,
+// so children must be deleted before their parent pushes again.
+class RE_JsonWriter
+{
+public:
+	RE_JsonWriter(const char* file_name = nullptr, size_t chunk_size = 64 * 1024);
+	~RE_JsonWriter();
+
+	bool IsValid() const;
+
+	// Opens the document and its member object every node writes under
+	RE_Json* GetRootNode(const char* member);
+
+	// Closes the document and the file, returns whether it was written whole
+	bool Close();
+
+	const char* GetBuffer() const;
+	size_t GetSize() const;
+
+	// Events written by streaming RE_Json nodes
+	void Key(const char* name);
+	void StartObject();
+	void EndObject();
+	void StartArray();
+	void EndArray();
+
+	void Value(bool value);
+	void Value(int value);
+	void Value(uint value);
+	void Value(long value);
+	void Value(ulong value);
+	void Value(long long value);
+	void Value(ulonglong value);
+	void Value(float value);
+	void Value(double value);
+	void Value(const char* value);
+	void Value(const rapidjson::Value& value);
+
+	void Floats(const char* name, const float* values, uint count);
+
+private:
+
+	PhysFSWriteStream stream;
+	rapidjson::Writer<PhysFSWriteStream> writer;
+	bool rootOpen = false;
+};
+
+#endif // !__RE_JSON_WRITER_H__
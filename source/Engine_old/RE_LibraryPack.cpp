@@ -0,0 +1,659 @@
+#include "RE_LibraryPack.h"
+
+#include "RE_AssetDatabase.h"
+#include "RE_ConsoleLog.h"
+#include "RE_Memory.h"
+
+#include <PhysFS/physfs.h>
+#include <EASTL/sort.h>
+
+#include <chrono>
+#include <ctime>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char* RE_LibraryPack::extension = "repack";
+
+namespace
+{
+	ulonglong Align(ulonglong offset, ulonglong alignment) { return (offset + alignment - 1) & ~(alignment - 1); }
+
+	// Whether count elements of elementSize starting at offset lie inside size, without overflowing
+	bool Fits(ulonglong offset, ulonglong count, ulonglong elementSize, ulonglong size)
+	{
+		return offset <= size && count <= (size - offset) / elementSize;
+	}
+
+	int ComparePath(const char* lhs, size_t lhsSize, const char* rhs, size_t rhsSize)
+	{
+		int ret = memcmp(lhs, rhs, lhsSize < rhsSize ? lhsSize : rhsSize);
+		if (ret == 0) ret = (lhsSize < rhsSize) ? -1 : (lhsSize > rhsSize ? 1 : 0);
+		return ret;
+	}
+
+	eastl::string RealPath(const char* path)
+	{
+		const char* realDir = PHYSFS_getRealDir(path);
+		if (realDir == nullptr) return "";
+
+		eastl::string ret(realDir);
+		if (!ret.empty() && ret.back() != '/' && ret.back() != '\\') ret += PHYSFS_getDirSeparator();
+		return ret += path;
+	}
+
+	void DropFromCache(const char* os_path)
+	{
+#ifdef __linux__
+		int fd = open(os_path, O_RDONLY);
+		if (fd >= 0)
+		{
+			posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+			close(fd);
+		}
+#endif
+	}
+
+	// PhysFS archiver callbacks
+
+	struct PackReader
+	{
+		const char* data;
+		PHYSFS_uint64 size;
+		PHYSFS_uint64 position;
+	};
+
+	PHYSFS_Io* CreateReader(const char* data, PHYSFS_uint64 size);
+
+	PHYSFS_sint64 ReaderRead(PHYSFS_Io* io, void* buffer, PHYSFS_uint64 len)
+	{
+		PackReader* reader = static_cast<PackReader*>(io->opaque);
+		PHYSFS_uint64 available = reader->size - reader->position;
+		if (len > available) len = available;
+		memcpy(buffer, reader->data + reader->position, static_cast<size_t>(len));
+		reader->position += len;
+		return static_cast<PHYSFS_sint64>(len);
+	}
+
+	PHYSFS_sint64 ReaderWrite(PHYSFS_Io*, const void*, PHYSFS_uint64)
+	{
+		PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+		return -1;
+	}
+
+	int ReaderSeek(PHYSFS_Io* io, PHYSFS_uint64 offset)
+	{
+		PackReader* reader = static_cast<PackReader*>(io->opaque);
+		if (offset > reader->size)
+		{
+			PHYSFS_setErrorCode(PHYSFS_ERR_PAST_EOF);
+			return 0;
+		}
+		reader->position = offset;
+		return 1;
+	}
+
+	PHYSFS_sint64 ReaderTell(PHYSFS_Io* io) { return static_cast<PHYSFS_sint64>(static_cast<PackReader*>(io->opaque)->position); }
+	PHYSFS_sint64 ReaderLength(PHYSFS_Io* io) { return static_cast<PHYSFS_sint64>(static_cast<PackReader*>(io->opaque)->size); }
+
+	PHYSFS_Io* ReaderDuplicate(PHYSFS_Io* io)
+	{
+		PackReader* reader = static_cast<PackReader*>(io->opaque);
+		return CreateReader(reader->data, reader->size);
+	}
+
+	int ReaderFlush(PHYSFS_Io*) { return 1; }
+
+	void ReaderDestroy(PHYSFS_Io* io)
+	{
+		delete static_cast<PackReader*>(io->opaque);
+		delete io;
+	}
+
+	PHYSFS_Io* CreateReader(const char* data, PHYSFS_uint64 size)
+	{
+		PHYSFS_Io* io = new PHYSFS_Io();
+		io->version = 0;
+		io->opaque = new PackReader({ data, size, 0 });
+		io->read = ReaderRead;
+		io->write = ReaderWrite;
+		io->seek = ReaderSeek;
+		io->tell = ReaderTell;
+		io->length = ReaderLength;
+		io->duplicate = ReaderDuplicate;
+		io->flush = ReaderFlush;
+		io->destroy = ReaderDestroy;
+		return io;
+	}
+
+	void* PackOpenArchive(PHYSFS_Io* io, const char* name, int forWrite, int* claimed)
+	{
+		RE_LibraryPack::Header header;
+		if (!io->seek(io, 0) || io->read(io, &header, sizeof(header)) != sizeof(header) || memcmp(header.magic, "REPK", 4) != 0)
+		{
+			PHYSFS_setErrorCode(PHYSFS_ERR_UNSUPPORTED);
+			return nullptr;
+		}
+
+		*claimed = 1;
+		if (forWrite)
+		{
+			PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+			return nullptr;
+		}
+
+		RE_LibraryPack* pack = new RE_LibraryPack();
+		if (!pack->Open(name))
+		{
+			// No mapping available, fall back to a single read of the whole pack
+			PHYSFS_sint64 length = io->length(io);
+			char* buffer = (length > 0) ? new char[length] : nullptr;
+			if (buffer == nullptr || !io->seek(io, 0) || io->read(io, buffer, length) != length)
+				DEL_A(buffer)
+
+			if (buffer == nullptr || !pack->OpenFromMemory(buffer, static_cast<size_t>(length)))
+			{
+				DEL(pack)
+				PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+				return nullptr;
+			}
+		}
+
+		io->destroy(io);
+		return pack;
+	}
+
+	PHYSFS_EnumerateCallbackResult PackEnumerate(void* opaque, const char* dirname, PHYSFS_EnumerateCallback cb, const char* origdir, void* callbackdata)
+	{
+		const RE_LibraryPack* pack = static_cast<const RE_LibraryPack*>(opaque);
+
+		eastl::string prefix(dirname);
+		if (!prefix.empty()) prefix += '/';
+
+		// Entries are sorted, every child of dirname is contiguous from here
+		eastl::string last;
+		for (uint i = pack->LowerBound(prefix.c_str(), prefix.size()); i < pack->GetCount(); i++)
+		{
+			const RE_LibraryPack::IndexEntry* entry = pack->GetEntry(i);
+			const char* path = pack->GetPath(entry);
+			if (entry->pathSize < prefix.size() || memcmp(path, prefix.c_str(), prefix.size()) != 0) break;
+
+			const char* child = path + prefix.size();
+			size_t childSize = entry->pathSize - prefix.size();
+			const char* slash = static_cast<const char*>(memchr(child, '/', childSize));
+			if (slash != nullptr) childSize = slash - child;
+
+			if (last.size() == childSize && memcmp(last.c_str(), child, childSize) == 0) continue;
+			last.assign(child, childSize);
+
+			PHYSFS_EnumerateCallbackResult result = cb(callbackdata, origdir, last.c_str());
+			if (result == PHYSFS_ENUM_ERROR)
+			{
+				PHYSFS_setErrorCode(PHYSFS_ERR_APP_CALLBACK);
+				return PHYSFS_ENUM_ERROR;
+			}
+			if (result == PHYSFS_ENUM_STOP) return PHYSFS_ENUM_STOP;
+		}
+
+		return PHYSFS_ENUM_OK;
+	}
+
+	PHYSFS_Io* PackOpenRead(void* opaque, const char* filename)
+	{
+		const RE_LibraryPack* pack = static_cast<const RE_LibraryPack*>(opaque);
+		const RE_LibraryPack::IndexEntry* entry = pack->Find(filename, strlen(filename));
+		if (entry == nullptr)
+		{
+			PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+			return nullptr;
+		}
+		return CreateReader(pack->GetData(entry), entry->size);
+	}
+
+	PHYSFS_Io* PackOpenWrite(void*, const char*)
+	{
+		PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+		return nullptr;
+	}
+
+	int PackModify(void*, const char*)
+	{
+		PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+		return 0;
+	}
+
+	int PackStat(void* opaque, const char* filename, PHYSFS_Stat* stat)
+	{
+		const RE_LibraryPack* pack = static_cast<const RE_LibraryPack*>(opaque);
+		size_t filenameSize = strlen(filename);
+
+		stat->modtime = stat->createtime = stat->accesstime = pack->GetModTime();
+		stat->readonly = 1;
+
+		if (const RE_LibraryPack::IndexEntry* entry = pack->Find(filename, filenameSize))
+		{
+			stat->filetype = PHYSFS_FILETYPE_REGULAR;
+			stat->filesize = static_cast<PHYSFS_sint64>(entry->size);
+			return 1;
+		}
+
+		eastl::string prefix(filename);
+		if (!prefix.empty()) prefix += '/';
+
+		uint first = pack->LowerBound(prefix.c_str(), prefix.size());
+		if (filenameSize == 0 || (first < pack->GetCount() && pack->GetEntry(first)->pathSize > prefix.size()
+			&& memcmp(pack->GetPath(pack->GetEntry(first)), prefix.c_str(), prefix.size()) == 0))
+		{
+			stat->filetype = PHYSFS_FILETYPE_DIRECTORY;
+			stat->filesize = 0;
+			return 1;
+		}
+
+		PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+		return 0;
+	}
+
+	void PackCloseArchive(void* opaque)
+	{
+		delete static_cast<RE_LibraryPack*>(opaque);
+	}
+}
+
+bool RE_LibraryPack::Open(const char* os_path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(os_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = GetFileSizeEx(file, &fileSize) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr)
+	{
+		if (mapping != nullptr) CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mapHandle = mapping;
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = open(os_path, O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat fileStat;
+	void* view = (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+		? mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	close(fd);
+	if (view == MAP_FAILED) return false;
+
+	size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	base = static_cast<const char*>(view);
+	mapped = true;
+
+	if (!Validate())
+	{
+		RE_LOG_ERROR("Library pack %s is corrupt", os_path);
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool RE_LibraryPack::OpenFromMemory(char* buffer, size_t _size)
+{
+	Close();
+	base = buffer;
+	size = _size;
+	mapped = false;
+
+	if (!Validate())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void RE_LibraryPack::Close()
+{
+	if (base != nullptr)
+	{
+		if (mapped)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(base);
+			CloseHandle(static_cast<HANDLE>(mapHandle));
+			CloseHandle(static_cast<HANDLE>(fileHandle));
+			mapHandle = fileHandle = nullptr;
+#else
+			munmap(const_cast<char*>(base), size);
+#endif
+		}
+		else delete[] base;
+	}
+
+	base = nullptr;
+	size = 0;
+	mapped = false;
+	header = nullptr;
+	entries = nullptr;
+	table = nullptr;
+	strings = nullptr;
+}
+
+bool RE_LibraryPack::Validate()
+{
+	if (size < sizeof(Header)) return false;
+
+	header = reinterpret_cast<const Header*>(base);
+	if (memcmp(header->magic, "REPK", 4) != 0 || header->version != version) return false;
+
+	// Open addressing needs at least one free slot, or Find never ends
+	if (!Fits(header->indexOffset, header->entryCount, sizeof(IndexEntry), size)
+		|| !Fits(header->tableOffset, header->tableSize, sizeof(uint), size)
+		|| header->indexOffset % alignof(IndexEntry) != 0 || header->tableOffset % alignof(uint) != 0
+		|| header->stringsOffset > header->dataOffset || header->dataOffset > size
+		|| header->tableSize == 0 || (header->tableSize & (header->tableSize - 1)) != 0
+		|| header->tableSize <= header->entryCount)
+		return false;
+
+	entries = reinterpret_cast<const IndexEntry*>(base + header->indexOffset);
+	table = reinterpret_cast<const uint*>(base + header->tableOffset);
+	strings = base + header->stringsOffset;
+
+	uint freeSlots = 0;
+	for (uint slot = 0; slot < header->tableSize; slot++)
+	{
+		if (table[slot] > header->entryCount) return false;
+		if (table[slot] == 0) freeSlots++;
+	}
+	if (freeSlots == 0) return false;
+
+	// Paths keep their null terminator inside the string blob, data lies after it
+	ulonglong stringsSize = header->dataOffset - header->stringsOffset;
+	for (uint i = 0; i < header->entryCount; i++)
+	{
+		const IndexEntry& entry = entries[i];
+		if (entry.offset < header->dataOffset || !Fits(entry.offset, entry.size, 1ull, size)
+			|| !Fits(entry.pathOffset, static_cast<ulonglong>(entry.pathSize) + 1ull, 1ull, stringsSize)
+			|| strings[entry.pathOffset + entry.pathSize] != '\0')
+			return false;
+	}
+
+	return true;
+}
+
+const RE_LibraryPack::IndexEntry* RE_LibraryPack::Find(const char* path, size_t pathSize) const
+{
+	if (header == nullptr || header->tableSize == 0) return nullptr;
+
+	ulonglong hash = RE_AssetDatabase::Hash(path, pathSize);
+	uint mask = header->tableSize - 1;
+	for (uint slot = static_cast<uint>(hash) & mask;; slot = (slot + 1) & mask)
+	{
+		uint index = table[slot];
+		if (index == 0) return nullptr;
+
+		const IndexEntry* entry = entries + (index - 1);
+		if (entry->hash == hash && entry->pathSize == pathSize && memcmp(strings + entry->pathOffset, path, pathSize) == 0)
+			return entry;
+	}
+}
+
+uint RE_LibraryPack::LowerBound(const char* path, size_t pathSize) const
+{
+	uint first = 0, count = GetCount();
+	while (count > 0)
+	{
+		uint step = count / 2;
+		const IndexEntry* entry = entries + first + step;
+		if (ComparePath(strings + entry->pathOffset, entry->pathSize, path, pathSize) < 0)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else count = step;
+	}
+	return first;
+}
+
+bool RE_LibraryPack::RegisterArchiver()
+{
+	static PHYSFS_Archiver archiver = {};
+	archiver.version = 0;
+	archiver.info.extension = extension;
+	archiver.info.description = "RedEye Library pack";
+	archiver.info.author = "RedEye Engine";
+	archiver.info.url = "https://github.com/juliamauri/RedEye-Engine";
+	archiver.info.supportsSymlinks = 0;
+	archiver.openArchive = PackOpenArchive;
+	archiver.enumerate = PackEnumerate;
+	archiver.openRead = PackOpenRead;
+	archiver.openWrite = PackOpenWrite;
+	archiver.openAppend = PackOpenWrite;
+	archiver.remove = PackModify;
+	archiver.mkdir = PackModify;
+	archiver.stat = PackStat;
+	archiver.closeArchive = PackCloseArchive;
+
+	if (PHYSFS_registerArchiver(&archiver) == 0)
+	{
+		RE_LOG_ERROR("Can't register Library pack archiver: %s", PHYSFS_getLastError());
+		return false;
+	}
+	return true;
+}
+
+bool RE_LibraryPack::Write(const char* library_dir, const eastl::vector<eastl::string>& files, const char* pack_file)
+{
+	size_t dirSize = strlen(library_dir);
+
+	eastl::vector<eastl::string> sorted(files);
+	eastl::sort(sorted.begin(), sorted.end(), [dirSize](const eastl::string& lhs, const eastl::string& rhs)
+		{ return ComparePath(lhs.c_str() + dirSize, lhs.size() - dirSize, rhs.c_str() + dirSize, rhs.size() - dirSize) < 0; });
+
+	uint count = static_cast<uint>(sorted.size());
+	uint tableSize = 1u;
+	while (tableSize < count * 2u) tableSize <<= 1;
+
+	eastl::vector<IndexEntry> index(count);
+	eastl::vector<uint> table(tableSize, 0u);
+	eastl::string stringBlob;
+
+	for (uint i = 0; i < count; i++)
+	{
+		const char* relative = sorted[i].c_str() + dirSize;
+		size_t relativeSize = sorted[i].size() - dirSize;
+
+		PHYSFS_Stat stat;
+		if (PHYSFS_stat(sorted[i].c_str(), &stat) == 0)
+		{
+			RE_LOG_ERROR("Can't pack %s: %s", sorted[i].c_str(), PHYSFS_getLastError());
+			return false;
+		}
+
+		IndexEntry& entry = index[i];
+		entry.hash = RE_AssetDatabase::Hash(relative, relativeSize);
+		entry.size = static_cast<ulonglong>(stat.filesize);
+		entry.pathOffset = static_cast<uint>(stringBlob.size());
+		entry.pathSize = static_cast<uint>(relativeSize);
+		stringBlob.append(relative, relativeSize);
+		stringBlob.push_back('\0');
+
+		uint slot = static_cast<uint>(entry.hash) & (tableSize - 1);
+		while (table[slot] != 0) slot = (slot + 1) & (tableSize - 1);
+		table[slot] = i + 1;
+	}
+
+	Header header = {};
+	memcpy(header.magic, "REPK", 4);
+	header.version = version;
+	header.entryCount = count;
+	header.tableSize = tableSize;
+	header.indexOffset = Align(sizeof(Header), 8ull);
+	header.tableOffset = header.indexOffset + count * sizeof(IndexEntry);
+	header.stringsOffset = header.tableOffset + tableSize * sizeof(uint);
+	header.dataOffset = Align(header.stringsOffset + stringBlob.size(), alignment);
+	header.modtime = static_cast<signed long long>(time(nullptr));
+
+	ulonglong offset = header.dataOffset;
+	for (IndexEntry& entry : index)
+	{
+		entry.offset = offset;
+		offset = Align(offset + entry.size, alignment);
+	}
+
+	PHYSFS_File* file = PHYSFS_openWrite(pack_file);
+	if (file == nullptr)
+	{
+		RE_LOG_ERROR("Can't write Library pack %s: %s", pack_file, PHYSFS_getLastError());
+		return false;
+	}
+
+	static const char padding[alignment] = {};
+	ulonglong written = 0;
+	auto write = [&](const void* data, ulonglong bytes)
+	{
+		if (PHYSFS_writeBytes(file, data, bytes) != static_cast<PHYSFS_sint64>(bytes)) return false;
+		written += bytes;
+		return true;
+	};
+	auto pad = [&](ulonglong to) { return write(padding, to - written); };
+
+	bool ret = write(&header, sizeof(Header))
+		&& pad(header.indexOffset)
+		&& write(index.data(), count * sizeof(IndexEntry))
+		&& write(table.data(), tableSize * sizeof(uint))
+		&& write(stringBlob.c_str(), stringBlob.size())
+		&& pad(header.dataOffset);
+
+	eastl::vector<char> buffer;
+	for (uint i = 0; ret && i < count; i++)
+	{
+		buffer.resize(static_cast<size_t>(index[i].size));
+
+		PHYSFS_File* entryFile = PHYSFS_openRead(sorted[i].c_str());
+		ret = entryFile != nullptr
+			&& PHYSFS_readBytes(entryFile, buffer.data(), index[i].size) == static_cast<PHYSFS_sint64>(index[i].size)
+			&& pad(index[i].offset)
+			&& write(buffer.data(), index[i].size);
+		if (entryFile != nullptr) PHYSFS_close(entryFile);
+
+		if (!ret) RE_LOG_ERROR("Error packing %s: %s", sorted[i].c_str(), PHYSFS_getLastError());
+	}
+
+	if (!PHYSFS_close(file)) ret = false;
+	if (!ret) PHYSFS_delete(pack_file);
+	else RE_LOG("Packed %u Library entries (%.2f MB) into %s", count, static_cast<double>(written) / (1024.0 * 1024.0), pack_file);
+
+	return ret;
+}
+
+void RE_LibraryPack::CollectFiles(const char* library_dir, eastl::vector<eastl::string>& files, bool loose_only)
+{
+	const char* writeDir = PHYSFS_getWriteDir();
+	eastl::vector<eastl::string> dirs;
+	dirs.push_back(library_dir);
+
+	for (size_t d = 0; d < dirs.size(); d++)
+	{
+		char** rc = PHYSFS_enumerateFiles(dirs[d].c_str());
+		for (char** i = rc; *i != NULL; i++)
+		{
+			eastl::string path(dirs[d]);
+			path += *i;
+
+			PHYSFS_Stat stat;
+			if (PHYSFS_stat(path.c_str(), &stat) == 0) continue;
+
+			if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY) dirs.push_back(path + "/");
+			else if (stat.filetype == PHYSFS_FILETYPE_REGULAR && d > 0)
+			{
+				const char* realDir = PHYSFS_getRealDir(path.c_str());
+				if (!loose_only || (realDir != nullptr && writeDir != nullptr && strcmp(realDir, writeDir) == 0))
+					files.push_back(path);
+			}
+		}
+		PHYSFS_freeList(rc);
+	}
+}
+
+void RE_LibraryPack::Benchmark(const char* library_dir, const char* bench_pack)
+{
+	eastl::vector<eastl::string> files;
+	CollectFiles(library_dir, files, true);
+	if (files.empty())
+	{
+		RE_LOG_WARNING("Library benchmark needs loose Library files to compare against. Skipping.");
+		return;
+	}
+
+	if (!Write(library_dir, files, bench_pack)) return;
+
+	eastl::vector<eastl::string> osPaths;
+	for (const auto& file : files) osPaths.push_back(RealPath(file.c_str()));
+	eastl::string osPack = RealPath(bench_pack);
+
+	using Clock = std::chrono::steady_clock;
+	auto elapsed = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+	eastl::vector<char> buffer;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		bool cold = (pass == 0);
+#ifndef __linux__
+		if (cold) continue; // Page cache can only be dropped per file on Linux
+#endif
+		if (cold)
+		{
+			for (const auto& path : osPaths) DropFromCache(path.c_str());
+			DropFromCache(osPack.c_str());
+		}
+
+		ulonglong bytes = 0;
+		Clock::time_point start = Clock::now();
+		for (const auto& file : files)
+		{
+			PHYSFS_File* fsFile = PHYSFS_openRead(file.c_str());
+			if (fsFile == nullptr) continue;
+			PHYSFS_sint64 length = PHYSFS_fileLength(fsFile);
+			buffer.resize(static_cast<size_t>(length));
+			bytes += static_cast<ulonglong>(PHYSFS_readBytes(fsFile, buffer.data(), length));
+			PHYSFS_close(fsFile);
+		}
+		double looseMs = elapsed(start);
+
+		start = Clock::now();
+		RE_LibraryPack pack;
+		if (pack.Open(osPack.c_str()))
+		{
+			for (uint i = 0; i < pack.GetCount(); i++)
+			{
+				const IndexEntry* entry = pack.GetEntry(i);
+				buffer.resize(static_cast<size_t>(entry->size));
+				memcpy(buffer.data(), pack.GetData(entry), static_cast<size_t>(entry->size));
+			}
+		}
+		double packMs = elapsed(start);
+
+		RE_LOG("Library benchmark (%s cache): %u files, %.2f MB | loose %.3f ms | packed %.3f ms",
+			cold ? "cold" : "warm", static_cast<uint>(files.size()), static_cast<double>(bytes) / (1024.0 * 1024.0), looseMs, packMs);
+	}
+
+	PHYSFS_delete(bench_pack);
+}
@@ -0,0 +1,91 @@
+#ifndef __RE_LIBRARY_PACK_H__
+#define __RE_LIBRARY_PACK_H__
+
+#include "RE_DataTypes.h"
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+// Single file holding the whole Library: header, index sorted by path, open addressing
+// path hash table and entry data aligned to cache lines. Read through a memory mapping,
+// mounted into PhysFS as a read only archive under the Library folder.
+class RE_LibraryPack
+{
+public:
+
+	struct Header
+	{
+		char magic[4];
+		uint version;
+		uint entryCount;
+		uint tableSize;
+		ulonglong indexOffset;
+		ulonglong tableOffset;
+		ulonglong stringsOffset;
+		ulonglong dataOffset;
+		signed long long modtime;
+	};
+
+	struct IndexEntry
+	{
+		ulonglong hash;
+		ulonglong offset;
+		ulonglong size;
+		uint pathOffset;
+		uint pathSize;
+	};
+
+	RE_LibraryPack() {}
+	~RE_LibraryPack() { Close(); }
+
+	bool Open(const char* os_path);
+	bool OpenFromMemory(char* buffer, size_t size); // Takes ownership of buffer
+	void Close();
+
+	const IndexEntry* Find(const char* path, size_t pathSize) const;
+	const IndexEntry* GetEntry(uint index) const { return entries + index; }
+	uint GetCount() const { return header != nullptr ? header->entryCount : 0u; }
+	uint LowerBound(const char* path, size_t pathSize) const;
+
+	const char* GetPath(const IndexEntry* entry) const { return strings + entry->pathOffset; }
+	const char* GetData(const IndexEntry* entry) const { return base + entry->offset; }
+	signed long long GetModTime() const { return header->modtime; }
+
+	// Makes packs mountable through PHYSFS_mount
+	static bool RegisterArchiver();
+
+	// Packs the given files (full PhysFS paths under library_dir) into pack_file at the write dir
+	static bool Write(const char* library_dir, const eastl::vector<eastl::string>& files, const char* pack_file);
+
+	// Every file inside library_dir subfolders; top level files like the asset database stay loose
+	static void CollectFiles(const char* library_dir, eastl::vector<eastl::string>& files, bool loose_only = false);
+
+	// Logs cold and warm cache load times of the loose Library against a pack of the same files
+	static void Benchmark(const char* library_dir, const char* bench_pack);
+
+	static const char* extension;
+
+private:
+
+	bool Validate();
+
+private:
+
+	static const uint version = 1u;
+	static const ulonglong alignment = 64ull;
+
+	const char* base = nullptr;
+	size_t size = 0;
+	bool mapped = false;
+
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mapHandle = nullptr;
+#endif
+
+	const Header* header = nullptr;
+	const IndexEntry* entries = nullptr;
+	const uint* table = nullptr;
+	const char* strings = nullptr;
+};
+
+#endif // !__RE_LIBRARY_PACK_H__
@@ -1262,7 +1262,7 @@ bool RE_Material::NeededResourcesReferencedTexturePull(RE_Json* texturesNode) co
 void RE_Material::BinaryDeserialize()
 {
 	RE_FileBuffer libraryFile(GetLibraryPath());
-	if (libraryFile.Load())
+	if (libraryFile.LoadDecompressed())
 	{
 		char* cursor = libraryFile.GetBuffer();
 
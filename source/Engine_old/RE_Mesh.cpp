@@ -26,6 +26,7 @@
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <new>
 
 
 RE_Mesh::RE_Mesh()
@@ -61,12 +62,17 @@ void RE_Mesh::UnloadMemory()
 	if (lVertexNormals) clearVertexNormals();
 	if (lFaceNormals) clearFaceNormals();
 
-	if (vertex) DEL_A(vertex);
-	if (normals) DEL_A(normals);
-	if (tangents) DEL_A(tangents);
-	if (bitangents) DEL_A(bitangents);
-	if (texturecoords) DEL_A(texturecoords);
-	if (index) DEL_A(index);
+	// Arrays loaded from the Library live in its decompressed block
+	if (libraryData) ClearLibraryData();
+	else
+	{
+		if (vertex) DEL_A(vertex);
+		if (normals) DEL_A(normals);
+		if (tangents) DEL_A(tangents);
+		if (bitangents) DEL_A(bitangents);
+		if (texturecoords) DEL_A(texturecoords);
+		if (index) DEL_A(index);
+	}
 
 	ResourceContainer::inMemory = false;
 }
@@ -172,7 +178,7 @@ const char* RE_Mesh::CheckAndSave(bool* exists)
 		ResourceContainer::SetLibraryPath(libraryPath.c_str());
 
 		RE_FileBuffer toSave(GetLibraryPath());
-		toSave.Save(buffer, size);
+		toSave.SaveCompressed(buffer, size);
 	}
 	else *exists = true;
 
@@ -564,81 +570,75 @@ void RE_Mesh::LibraryLoad()
 {
 	RE_FileBuffer toLoad(GetLibraryPath());
 
-	if (toLoad.Load())
+	// The entry is decompressed once into a block the mesh keeps, its arrays point straight into it
+	size_t rawSize = 0;
+	if (toLoad.GetDecompressedSize(rawSize))
 	{
-		char* cursor = toLoad.GetBuffer();
-
-		size_t cSize = sizeof(uint);
-		memcpy(&triangle_count, cursor, cSize);
-		cursor += cSize;
-
-		memcpy(&vertex_count, cursor, cSize);
-		cursor += cSize;
-
-		vertex = new float[vertex_count * 3];
-		cSize = sizeof(float) * 3 * vertex_count;
-		memcpy(vertex, cursor, cSize);
-		cursor += cSize;
-
-		bool toFill = false;
-		cSize = sizeof(bool);
-		memcpy(&toFill, cursor, cSize);
-		cursor += cSize;
-		if (toFill)
+		libraryData = new (std::nothrow) char[rawSize];
+		if (libraryData == nullptr || !toLoad.DecompressInto(libraryData, rawSize) || !MapLibraryData(rawSize))
 		{
-			normals = new float[vertex_count * 3];
-			cSize = sizeof(float) * 3 * vertex_count;
-			memcpy(normals, cursor, cSize);
-			cursor += cSize;
+			RE_LOG_ERROR("Mesh %s has a corrupt Library entry", GetName());
+			ClearLibraryData();
 		}
+	}
+	ResourceContainer::inMemory = true;
+}
 
-		toFill = false;
-		cSize = sizeof(bool);
-		memcpy(&toFill, cursor, cSize);
-		cursor += cSize;
-		if (toFill)
-		{
-			tangents = new float[vertex_count * 3];
-			cSize = sizeof(float) * 3 * vertex_count;
-			memcpy(tangents, cursor, cSize);
-			cursor += cSize;
-		}
+bool RE_Mesh::MapLibraryData(size_t size)
+{
+	char* cursor = libraryData;
+	const char* end = libraryData + size;
 
-		toFill = false;
-		cSize = sizeof(bool);
-		memcpy(&toFill, cursor, cSize);
+	auto take = [&cursor, end](size_t cSize) -> char*
+	{
+		if (cSize > static_cast<size_t>(end - cursor)) return nullptr;
+		char* ret = cursor;
 		cursor += cSize;
-		if (toFill)
-		{
-			bitangents = new float[vertex_count * 3];
-			size_t cSize = sizeof(float) * 3 * vertex_count;
-			memcpy(bitangents, cursor, cSize);
-			cursor += cSize;
-		}
+		return ret;
+	};
 
-		toFill = false;
-		cSize = sizeof(bool);
-		memcpy( &toFill, cursor, cSize);
-		cursor += cSize;
-		if (toFill)
-		{
-			texturecoords = new float[vertex_count * 2];
-			size_t cSize = sizeof(float) * 2 * vertex_count;
-			memcpy( texturecoords, cursor, cSize);
-			cursor += cSize;
-		}
+	// Optional arrays are preceded by a bool telling if they were saved
+	auto takeOptional = [&take](size_t cSize, char*& data)
+	{
+		const char* toFill = take(sizeof(bool));
+		if (toFill == nullptr) return false;
+
+		data = *toFill ? take(cSize) : nullptr;
+		return !*toFill || data != nullptr;
+	};
+
+	const char* counts = take(sizeof(uint) * 2);
+	if (counts == nullptr) return false;
+
+	uint count = 0;
+	memcpy(&count, counts, sizeof(uint));
+	triangle_count = count;
+	memcpy(&count, counts + sizeof(uint), sizeof(uint));
+	vertex_count = count;
+
+	char *vertexData = take(sizeof(float) * 3 * vertex_count), *normalsData = nullptr, *tangentsData = nullptr,
+		*bitangentsData = nullptr, *texturecoordsData = nullptr, *indexData = nullptr;
+	if (vertexData == nullptr ||
+		!takeOptional(sizeof(float) * 3 * vertex_count, normalsData) ||
+		!takeOptional(sizeof(float) * 3 * vertex_count, tangentsData) ||
+		!takeOptional(sizeof(float) * 3 * vertex_count, bitangentsData) ||
+		!takeOptional(sizeof(float) * 2 * vertex_count, texturecoordsData) ||
+		!takeOptional(sizeof(uint) * 3 * triangle_count, indexData))
+		return false;
+
+	vertex = reinterpret_cast<float*>(vertexData);
+	normals = reinterpret_cast<float*>(normalsData);
+	tangents = reinterpret_cast<float*>(tangentsData);
+	bitangents = reinterpret_cast<float*>(bitangentsData);
+	texturecoords = reinterpret_cast<float*>(texturecoordsData);
+	index = reinterpret_cast<uint*>(indexData);
+	return true;
+}
 
-		toFill = false;
-		cSize = sizeof(bool);
-		memcpy(&toFill, cursor, cSize);
-		cursor += cSize;
-		if (toFill)
-		{
-			index = new uint[triangle_count * 3];
-			cSize = sizeof(uint) * 3 * triangle_count;
-			memcpy( index, cursor, cSize);
-			cursor += cSize;
-		}
-	}
-	ResourceContainer::inMemory = true;
+void RE_Mesh::ClearLibraryData()
+{
+	DEL_A(libraryData);
+	vertex = normals = tangents = bitangents = texturecoords = nullptr;
+	index = nullptr;
+	triangle_count = vertex_count = 0;
 }
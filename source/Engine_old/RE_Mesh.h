@@ -53,6 +53,8 @@ private:
 	void ClearVertex();
 
 	void LibraryLoad();
+	bool MapLibraryData(size_t size);
+	void ClearLibraryData();
 
 private:
 
@@ -61,6 +63,9 @@ private:
 		*texturecoords = nullptr;
 	unsigned int* index = nullptr;
 
+	// Decompressed Library entry, owns the arrays above when the mesh was loaded from the Library
+	char* libraryData = nullptr;
+
 	size_t triangle_count = 0;
 	size_t vertex_count = 0;
 
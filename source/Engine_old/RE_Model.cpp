@@ -21,11 +21,11 @@
 
 void RE_Model::LoadInMemory()
 {
-	if (RE_FS->Exists(GetLibraryPath()))
-	{
-		LibraryLoad();
-	}
-	else if (RE_FS->Exists(GetAssetPath()))
+	if (RE_FS->Exists(GetLibraryPath())) LibraryLoad();
+
+	// Rebuilt from the asset when the Library entry is missing or fails to load
+	if (loaded != nullptr) return;
+	if (RE_FS->Exists(GetAssetPath()))
 	{
 		AssetLoad();
 		LibrarySave();
@@ -54,6 +54,15 @@ void RE_Model::Import(bool keepInMemory)
 	if(!keepInMemory) UnloadMemory();
 }
 
+void RE_Model::ReImport()
+{
+	bool unload = isInMemory();
+	if (unload) UnloadMemory();
+	AssetLoad();
+	LibrarySave();
+	if (!unload) UnloadMemory();
+}
+
 RE_ECS_Pool* RE_Model::GetPool()
 {
 	RE_ECS_Pool* ret;
@@ -222,7 +231,7 @@ void RE_Model::AssetLoad()
 	if (assetload.Load())
 	{
 		loaded = RE_ModelImporter::ProcessModel(assetload.GetBuffer(), assetload.GetSize(), GetAssetPath(), &modelSettings);
-		SetMD5(assetload.GetMd5().c_str());
+		SetMD5(RE_FS->GetAssetMD5(GetAssetPath(), assetload.GetBuffer(), assetload.GetSize()).c_str());
 		eastl::string libraryPath("Library/Models/");
 		libraryPath += GetMD5();
 		SetLibraryPath(libraryPath.c_str());
@@ -233,10 +242,10 @@ void RE_Model::AssetLoad()
 void RE_Model::LibraryLoad()
 {
 	RE_FileBuffer binaryLoad(GetLibraryPath());
-	if (binaryLoad.Load())
+	if (binaryLoad.LoadDecompressed())
 	{
 		char* cursor = binaryLoad.GetBuffer();
-		loaded = RE_ECS_Importer::BinaryDeserialize(cursor);
+		loaded = RE_ECS_Importer::BinaryDeserialize(cursor, binaryLoad.GetSize());
 		ResourceContainer::inMemory = true;
 	}
 }
@@ -260,10 +269,10 @@ bool RE_Model::CheckResourcesIsOnAssets()
 	bool ret = false;
 	RE_FileBuffer binaryLoad(GetLibraryPath());
 
-	if (binaryLoad.Load())
+	if (binaryLoad.LoadDecompressed())
 	{
 		char* cursor = binaryLoad.GetBuffer();
-		ret = RE_ECS_Importer::BinaryCheckResources(cursor);
+		ret = RE_ECS_Importer::BinaryCheckResources(cursor, binaryLoad.GetSize());
 	}
 
 	return ret;
@@ -18,6 +18,7 @@ public:
 	void SetAssetPath(const char* originPath) final;
 
 	void Import(bool keepInMemory = true) final;
+	void ReImport() final;
 	RE_ECS_Pool* GetPool();
 
 private:
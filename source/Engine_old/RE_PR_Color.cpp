@@ -46,74 +46,27 @@ bool RE_PR_Color::DrawEditor()
 
 void RE_PR_Color::JsonSerialize(RE_Json* node) const
 {
-	node->Push("Type", static_cast<int>(type));
-
-	node->PushFloatVector("Base", base);
-	node->PushFloatVector("Gradient", gradient);
-	node->Push("useCurve", useCurve);
-
-	curve.JsonSerialize(node->PushJObject("curve"));
-
+	RE_Reflection::JsonSerialize(*this, node);
 	DEL(node)
 }
 
 void RE_PR_Color::JsonDeserialize(RE_Json* node)
 {
-	type = static_cast<Type>(node->PullInt("Type", 0));
-
-	base = node->PullFloatVector("Base", math::vec::one);
-	gradient = node->PullFloatVector("Gradient", math::vec::zero);
-	useCurve = node->PullBool("useCurve", false);
-
-	curve.JsonDeserialize(node->PullJObject("curve"));
-
+	RE_Reflection::JsonDeserialize(*this, node);
 	DEL(node)
 }
 
 size_t RE_PR_Color::GetBinarySize() const
 {
-	return sizeof(ushort)
-		+ (sizeof(float) * 6)
-		+ sizeof(bool)
-		+ curve.GetBinarySize();
+	return RE_Reflection::GetBinarySize(*this);
 }
 
 void RE_PR_Color::BinarySerialize(char*& cursor) const
 {
-	size_t size = sizeof(Type);
-	memcpy(cursor, &type, size);
-	cursor += size;
-
-	size = sizeof(float) * 3;
-	memcpy(cursor, base.ptr(), size);
-	cursor += size;
-
-	memcpy(cursor, gradient.ptr(), size);
-	cursor += size;
-
-	size = sizeof(bool);
-	memcpy(cursor, &useCurve, size);
-	cursor += size;
-
-	curve.BinarySerialize(cursor);
+	RE_Reflection::BinarySerialize(*this, cursor);
 }
 
 void RE_PR_Color::BinaryDeserialize(char*& cursor)
 {
-	size_t size = sizeof(Type);
-	memcpy(&type, cursor, size);
-	cursor += size;
-
-	size = sizeof(float) * 3;
-	memcpy(base.ptr(), cursor, size);
-	cursor += size;
-
-	memcpy(gradient.ptr(), cursor, size);
-	cursor += size;
-
-	size = sizeof(bool);
-	memcpy(&useCurve, cursor, size);
-	cursor += size;
-
-	curve.BinaryDeserialize(cursor);
+	RE_Reflection::BinaryDeserialize(*this, cursor);
 }
\ No newline at end of file
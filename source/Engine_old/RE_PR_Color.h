@@ -3,6 +3,7 @@
 
 #include "RE_Serializable.h"
 #include "RE_DataTypes.h"
+#include "RE_Reflection.h"
 #include "RE_Curve.h"
 
 #include <MGL/Math/float3.h>
@@ -31,6 +32,16 @@ struct RE_PR_Color : RE_Serializable
 
 	bool DrawEditor();
 
+	static constexpr auto Reflection()
+	{
+		return RE_Reflection::Fields(
+			RE_FIELD("Type", &RE_PR_Color::type),
+			RE_FIELD("Base", &RE_PR_Color::base),
+			RE_FIELD("Gradient", &RE_PR_Color::gradient),
+			RE_FIELD("useCurve", &RE_PR_Color::useCurve),
+			RE_FIELD("curve", &RE_PR_Color::curve));
+	}
+
 	void JsonSerialize(RE_Json* node) const override;
 	void JsonDeserialize(RE_Json* node) override;
 
@@ -214,7 +214,7 @@ void RE_ParticleEmission::BinarySerialize() const
 void RE_ParticleEmission::BinaryDeserialize()
 {
 	RE_FileBuffer libraryFile(GetLibraryPath());
-	if (libraryFile.Load())
+	if (libraryFile.LoadDecompressed())
 	{
 		char* cursor = libraryFile.GetBuffer();
 
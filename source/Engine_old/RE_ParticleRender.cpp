@@ -233,7 +233,7 @@ void RE_ParticleRender::JsonSerialize(bool onlyMD5)
 void RE_ParticleRender::BinaryDeserialize()
 {
 	RE_FileBuffer libraryFile(GetLibraryPath());
-	if (libraryFile.Load())
+	if (libraryFile.LoadDecompressed())
 	{
 		char* cursor = libraryFile.GetBuffer();
 
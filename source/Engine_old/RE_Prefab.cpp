@@ -8,6 +8,7 @@
 #include "RE_FileBuffer.h"
 #include "RE_Config.h"
 #include "RE_Json.h"
+#include "RE_JsonWriter.h"
 #include "Application.h"
 #include "ModuleScene.h"
 #include "RE_ResourceManager.h"
@@ -23,11 +24,11 @@ RE_Prefab::~RE_Prefab() {}
 
 void RE_Prefab::LoadInMemory()
 {
-	if (RE_FS->Exists(GetLibraryPath()))
-	{
-		LibraryLoad();
-	}
-	else if (RE_FS->Exists(GetAssetPath()))
+	if (RE_FS->Exists(GetLibraryPath())) LibraryLoad();
+
+	// Rebuilt from the asset when the Library entry is missing or fails to load
+	if (loaded != nullptr) return;
+	if (RE_FS->Exists(GetAssetPath()))
 	{
 		AssetLoad();
 		LibrarySave();
@@ -92,22 +93,22 @@ RE_ECS_Pool* RE_Prefab::GetPool()
 
 void RE_Prefab::AssetSave()
 {
-	//Serialize
-	Config prefab_SaveFile(GetAssetPath());
+	//Serialize, streamed to the asset file without building a document
+	RE_JsonWriter prefab_SaveFile(GetAssetPath());
 	RE_Json* prefabNode = prefab_SaveFile.GetRootNode("prefab");
 
 	RE_ECS_Importer::JsonSerialize(prefabNode, toSave);
 	DEL(prefabNode)
 
+	if (!prefab_SaveFile.Close()) RE_LOG_ERROR("Error while saving prefab %s", GetAssetPath());
+
 	//Setting LibraryPath and MD5
-	eastl::string md5 = prefab_SaveFile.GetMd5();
+	RE_FileBuffer saved(GetAssetPath());
+	eastl::string md5 = saved.GetMd5();
 	SetMD5(md5.c_str());
 	eastl::string libraryPath("Library/Prefabs/");
 	libraryPath += md5;
 	SetLibraryPath(libraryPath.c_str());
-
-	//Save
-	prefab_SaveFile.Save();
 }
 
 void RE_Prefab::AssetLoad(bool generateLibraryPath)
@@ -136,10 +137,10 @@ void RE_Prefab::AssetLoad(bool generateLibraryPath)
 void RE_Prefab::LibraryLoad()
 {
 	RE_FileBuffer binaryLoad(GetLibraryPath());
-	if (binaryLoad.Load())
+	if (binaryLoad.LoadDecompressed())
 	{
 		char* cursor = binaryLoad.GetBuffer();
-		loaded = RE_ECS_Importer::BinaryDeserialize(cursor);
+		loaded = RE_ECS_Importer::BinaryDeserialize(cursor, binaryLoad.GetSize());
 	}
 	ResourceContainer::inMemory = true;
 }
@@ -0,0 +1,328 @@
+#ifndef __RE_REFLECTION_H__
+#define __RE_REFLECTION_H__
+
+#include "RE_DataTypes.h"
+#include "RE_Serializable.h"
+#include "RE_Json.h"
+
+#include <MGL/Math/float2.h>
+#include <MGL/Math/float3.h>
+#include <MGL/Math/float4.h>
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+
+// Compile-time field descriptors. A type lists its fields once in a public static function:
+//
+//	static constexpr auto Reflection()
+//	{
+//		return RE_Reflection::Fields(
+//			RE_FIELD("slices", &RE_CompWater::slices),
+//			RE_FIELD_FLAGS("direction", &RE_CompWater::direction, RE_Reflection::BINARY_ONLY));
+//	}
+//
+// and the functions below generate its JSON and binary codecs. Binary fields are packed in
+// declaration order; fields that also lie back to back in memory are copied with one memcpy.
+
+#define RE_FIELD(name, member) RE_Reflection::Field<member>{ name }
+#define RE_FIELD_FLAGS(name, member, flags) RE_Reflection::Field<member>{ name, flags }
+
+namespace RE_Reflection
+{
+	enum FieldFlags : uint
+	{
+		NONE = 0,
+		BINARY_ONLY = 1 << 0 // Serialized by hand in JSON, for keys that don't map to a single member
+	};
+
+	template<auto Member> struct Field;
+
+	template<class Class, class T, T Class::* Member>
+	struct Field<Member>
+	{
+		typedef Class ClassType;
+		typedef T ValueType;
+
+		const char* name;
+		uint flags = NONE;
+
+		static const T& Get(const Class& obj) { return obj.*Member; }
+		static T& Get(Class& obj) { return obj.*Member; }
+	};
+
+	template<class... F>
+	constexpr std::tuple<F...> Fields(F... fields) { return std::tuple<F...>(fields...); }
+
+	// Codecs ============================================================
+
+	// Arithmetic and enum values, enums are stored in JSON as int and in binary as their underlying type
+	template<class T, class Enable = void>
+	struct Codec
+	{
+		static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "No reflection codec for this field type");
+
+		static constexpr bool raw = true;
+		static constexpr ulonglong schema = ((std::is_enum<T>::value ? 1ull : std::is_floating_point<T>::value ? 2ull : 3ull) << 8) | sizeof(T);
+
+		static const void* Data(const T& value) { return &value; }
+		static void* Data(T& value) { return &value; }
+		static size_t Size(const T&) { return sizeof(T); }
+
+		static void JsonPush(RE_Json* node, const char* name, const T& value)
+		{
+			if constexpr (std::is_enum<T>::value) node->Push(name, static_cast<int>(value));
+			else node->Push(name, value);
+		}
+
+		template<class Node>
+		static void JsonPull(Node* node, const char* name, T& value)
+		{
+			if constexpr (std::is_enum<T>::value) value = static_cast<T>(node->PullInt(name, static_cast<int>(value)));
+			else if constexpr (std::is_same<T, bool>::value) value = node->PullBool(name, value);
+			else if constexpr (std::is_same<T, float>::value) value = node->PullFloat(name, value);
+			else if constexpr (std::is_floating_point<T>::value) value = static_cast<T>(node->PullDouble(name, value));
+			else if constexpr (std::is_signed<T>::value && sizeof(T) > sizeof(int)) value = static_cast<T>(node->PullSignedLongLong(name, value));
+			else if constexpr (std::is_signed<T>::value) value = static_cast<T>(node->PullInt(name, value));
+			else if constexpr (sizeof(T) > sizeof(uint)) value = static_cast<T>(node->PullUnsignedLongLong(name, value));
+			else value = static_cast<T>(node->PullUInt(name, value));
+		}
+
+		static void Write(char*& cursor, const T& value) { memcpy(cursor, &value, sizeof(T)); cursor += sizeof(T); }
+		static void Read(char*& cursor, T& value) { memcpy(&value, cursor, sizeof(T)); cursor += sizeof(T); }
+	};
+
+	template<class T, uint Kind>
+	struct MathCodec
+	{
+		static constexpr bool raw = true;
+		static constexpr ulonglong schema = (static_cast<ulonglong>(Kind) << 8) | sizeof(T);
+
+		static const void* Data(const T& value) { return value.ptr(); }
+		static void* Data(T& value) { return value.ptr(); }
+		static size_t Size(const T&) { return sizeof(T); }
+
+		static void Write(char*& cursor, const T& value) { memcpy(cursor, value.ptr(), sizeof(T)); cursor += sizeof(T); }
+		static void Read(char*& cursor, T& value) { memcpy(value.ptr(), cursor, sizeof(T)); cursor += sizeof(T); }
+	};
+
+	template<>
+	struct Codec<math::float2> : MathCodec<math::float2, 4u>
+	{
+		static void JsonPush(RE_Json* node, const char* name, const math::float2& value) { node->PushFloat2(name, value); }
+		template<class Node> static void JsonPull(Node* node, const char* name, math::float2& value) { value = node->PullFloat2(name, value); }
+	};
+
+	template<>
+	struct Codec<math::vec> : MathCodec<math::vec, 5u>
+	{
+		static void JsonPush(RE_Json* node, const char* name, const math::vec& value) { node->PushFloatVector(name, value); }
+		template<class Node> static void JsonPull(Node* node, const char* name, math::vec& value) { value = node->PullFloatVector(name, value); }
+	};
+
+	template<>
+	struct Codec<math::float4> : MathCodec<math::float4, 6u>
+	{
+		static void JsonPush(RE_Json* node, const char* name, const math::float4& value) { node->PushFloat4(name, value); }
+		template<class Node> static void JsonPull(Node* node, const char* name, math::float4& value) { value = node->PullFloat4(name, value); }
+	};
+
+	// Shader bound values, only the value is serialized
+	template<class P, class T>
+	struct Codec<eastl::pair<P, T>>
+	{
+		typedef Codec<T> Inner;
+
+		static constexpr bool raw = Inner::raw;
+		static constexpr ulonglong schema = Inner::schema;
+
+		static const void* Data(const eastl::pair<P, T>& value) { return Inner::Data(value.second); }
+		static void* Data(eastl::pair<P, T>& value) { return Inner::Data(value.second); }
+		static size_t Size(const eastl::pair<P, T>& value) { return Inner::Size(value.second); }
+
+		static void JsonPush(RE_Json* node, const char* name, const eastl::pair<P, T>& value) { Inner::JsonPush(node, name, value.second); }
+		template<class Node> static void JsonPull(Node* node, const char* name, eastl::pair<P, T>& value) { Inner::JsonPull(node, name, value.second); }
+
+		static void Write(char*& cursor, const eastl::pair<P, T>& value) { Inner::Write(cursor, value.second); }
+		static void Read(char*& cursor, eastl::pair<P, T>& value) { Inner::Read(cursor, value.second); }
+	};
+
+	// Nested serializables keep their own codecs, their JSON goes into a child object.
+	// They only load from RE_Json nodes, not from cursors.
+	template<class T>
+	struct Codec<T, typename std::enable_if<std::is_base_of<RE_Serializable, T>::value>::type>
+	{
+		static constexpr bool raw = false;
+		static constexpr ulonglong schema = 7ull << 8;
+
+		static size_t Size(const T& value) { return value.GetBinarySize(); }
+
+		static void JsonPush(RE_Json* node, const char* name, const T& value) { value.JsonSerialize(node->PushJObject(name)); }
+		static void JsonPull(RE_Json* node, const char* name, T& value) { value.JsonDeserialize(node->PullJObject(name)); }
+
+		static void Write(char*& cursor, const T& value) { value.BinarySerialize(cursor); }
+		static void Read(char*& cursor, T& value) { value.BinaryDeserialize(cursor); }
+	};
+
+	// Binary plan ============================================================
+
+	// Either a raw span of the object or a field with its own codec
+	template<class Class>
+	struct Step
+	{
+		size_t offset = 0;
+		size_t size = 0;
+		size_t(*sizeOf)(const Class&) = nullptr;
+		void(*write)(const Class&, char*&) = nullptr;
+		void(*read)(Class&, char*&) = nullptr;
+	};
+
+	template<class F> size_t SizeOfField(const typename F::ClassType& obj) { return Codec<typename F::ValueType>::Size(F::Get(obj)); }
+	template<class F> void WriteField(const typename F::ClassType& obj, char*& cursor) { Codec<typename F::ValueType>::Write(cursor, F::Get(obj)); }
+	template<class F> void ReadField(typename F::ClassType& obj, char*& cursor) { Codec<typename F::ValueType>::Read(cursor, F::Get(obj)); }
+
+	template<class Class, class F>
+	void AddStep(eastl::vector<Step<Class>>& plan, const Class& obj, F)
+	{
+		typedef Codec<typename F::ValueType> C;
+		Step<Class> step;
+
+		if constexpr (C::raw)
+		{
+			const auto& value = F::Get(obj);
+			step.offset = static_cast<size_t>(static_cast<const char*>(C::Data(value)) - reinterpret_cast<const char*>(&obj));
+			step.size = C::Size(value);
+
+			// Merge with the previous span when both are contiguous in memory
+			if (!plan.empty() && plan.back().write == nullptr && plan.back().offset + plan.back().size == step.offset)
+			{
+				plan.back().size += step.size;
+				return;
+			}
+		}
+		else
+		{
+			step.sizeOf = &SizeOfField<F>;
+			step.write = &WriteField<F>;
+			step.read = &ReadField<F>;
+		}
+
+		plan.push_back(step);
+	}
+
+	// Member offsets are the same for every instance, so the plan is built once from the first one
+	template<class Class>
+	const eastl::vector<Step<Class>>& GetPlan(const Class& obj)
+	{
+		static const eastl::vector<Step<Class>> plan = [&obj]()
+		{
+			eastl::vector<Step<Class>> ret;
+			std::apply([&](auto... fields) { (AddStep(ret, obj, fields), ...); }, Class::Reflection());
+			return ret;
+		}();
+		return plan;
+	}
+
+	// Codecs ============================================================
+
+	template<class Class>
+	void JsonSerialize(const Class& obj, RE_Json* node)
+	{
+		std::apply([&](auto... fields)
+			{
+				((fields.flags & BINARY_ONLY ? void() : Codec<typename decltype(fields)::ValueType>::JsonPush(node, fields.name, decltype(fields)::Get(obj))), ...);
+			}, Class::Reflection());
+	}
+
+	// Node is RE_Json or RE_JsonCursor, both pull with the same calls
+	template<class Class, class Node>
+	void JsonDeserialize(Class& obj, Node* node)
+	{
+		std::apply([&](auto... fields)
+			{
+				((fields.flags & BINARY_ONLY ? void() : Codec<typename decltype(fields)::ValueType>::JsonPull(node, fields.name, decltype(fields)::Get(obj))), ...);
+			}, Class::Reflection());
+	}
+
+	template<class Class>
+	size_t GetBinarySize(const Class& obj)
+	{
+		size_t ret = 0;
+		for (const auto& step : GetPlan(obj)) ret += step.sizeOf ? step.sizeOf(obj) : step.size;
+		return ret;
+	}
+
+	template<class Class>
+	void BinarySerialize(const Class& obj, char*& cursor)
+	{
+		const char* base = reinterpret_cast<const char*>(&obj);
+		for (const auto& step : GetPlan(obj))
+		{
+			if (step.write) step.write(obj, cursor);
+			else
+			{
+				memcpy(cursor, base + step.offset, step.size);
+				cursor += step.size;
+			}
+		}
+	}
+
+	template<class Class>
+	void BinaryDeserialize(Class& obj, char*& cursor)
+	{
+		char* base = reinterpret_cast<char*>(&obj);
+		for (const auto& step : GetPlan(obj))
+		{
+			if (step.read) step.read(obj, cursor);
+			else
+			{
+				memcpy(base + step.offset, cursor, step.size);
+				cursor += step.size;
+			}
+		}
+	}
+
+	// Schema ============================================================
+
+	constexpr ulonglong HashName(ulonglong hash, const char* name)
+	{
+		for (; *name; name++) hash = (hash ^ static_cast<unsigned char>(*name)) * 1099511628211ull;
+		return hash;
+	}
+
+	constexpr ulonglong HashValue(ulonglong hash, ulonglong value)
+	{
+		for (uint i = 0; i < 8u; i++) hash = (hash ^ ((value >> (i * 8u)) & 0xFFull)) * 1099511628211ull;
+		return hash;
+	}
+
+	// FNV-1a over every field name, codec kind and size in declaration order.
+	// Changes whenever a field is added, removed, renamed, reordered or retyped.
+	template<class Class>
+	constexpr ulonglong LayoutHash()
+	{
+		ulonglong hash = 14695981039346656037ull;
+		std::apply([&hash](auto... fields)
+			{
+				((hash = HashValue(HashName(hash, fields.name), Codec<typename decltype(fields)::ValueType>::schema)), ...);
+			}, Class::Reflection());
+		return hash;
+	}
+
+	template<class T, class Enable = void>
+	struct HasReflection : std::false_type {};
+
+	template<class T>
+	struct HasReflection<T, std::void_t<decltype(T::Reflection())>> : std::true_type {};
+
+	// Layout hash of reflected types, 0 for types still serialized by hand
+	template<class T>
+	constexpr ulonglong SchemaHash()
+	{
+		if constexpr (HasReflection<T>::value) return LayoutHash<T>();
+		else return 0ull;
+	}
+}
+
+#endif // !__RE_REFLECTION_H__
@@ -6,6 +6,7 @@
 #include "RE_Profiler.h"
 #include "Application.h"
 #include "RE_FileSystem.h"
+#include "RE_FileBuffer.h"
 #include "ModuleInput.h"
 #include "ModuleScene.h"
 #include "ModuleEditor.h"
@@ -517,6 +518,28 @@ ResourceContainer* RE_ResourceManager::DeleteResource(const char* res, eastl::ve
 	return resource;
 }
 
+void RE_ResourceManager::AssetRemoved(const char* res, bool metaRemoved)
+{
+	ResourceIter resource = resources.find(res);
+	if (resource == resources.end()) return;
+
+	// Without its meta the resource can't be referenced again, release it as the editor would
+	if (metaRemoved)
+	{
+		RE_LOG("Meta removed, releasing resource %s", resource->second->GetName());
+		eastl::string libraryPath = resource->second->GetLibraryPath();
+		ResourceContainer* removed = DeleteResource(res, WhereIsUsed(res), true);
+		if (!libraryPath.empty() && RE_FS->Exists(libraryPath.c_str()))
+		{
+			RE_FileBuffer libraryFile(libraryPath.c_str());
+			libraryFile.Delete();
+		}
+		DEL(removed)
+	}
+	else
+		RE_LOG_WARNING("Asset %s removed, resource %s keeps its Library data until its meta is removed", resource->second->GetAssetPath(), resource->second->GetName());
+}
+
 eastl::vector<ResourceContainer*> RE_ResourceManager::GetResourcesByType(ResourceContainer::Type type) const
 {
 	eastl::vector<ResourceContainer*> ret;
@@ -29,6 +29,7 @@ public:
 	eastl::vector<const char*> WhereUndefinedFileIsUsed(const char* assetPath);
 	eastl::vector<const char*> WhereIsUsed(const char* res);
 	ResourceContainer* DeleteResource(const char* res, eastl::vector<const char*> resourcesWillChange, bool resourceOnScene);
+	void AssetRemoved(const char* res, bool metaRemoved);
 
 	const char* ImportModel(const char* assetPath);
 	const char* ImportTexture(const char* assetPath);
@@ -8,6 +8,7 @@
 #include "RE_FileBuffer.h"
 #include "RE_Config.h"
 #include "RE_Json.h"
+#include "RE_JsonWriter.h"
 #include "Application.h"
 #include "ModuleScene.h"
 #include "RE_ResourceManager.h"
@@ -18,11 +19,11 @@
 
 void RE_Scene::LoadInMemory()
 {
-	if (RE_FS->Exists(GetLibraryPath()))
-	{
-		LibraryLoad();
-	}
-	else if (RE_FS->Exists(GetAssetPath()))
+	if (RE_FS->Exists(GetLibraryPath())) LibraryLoad();
+
+	// Rebuilt from the asset when the Library entry is missing or fails to load
+	if (loaded != nullptr) return;
+	if (RE_FS->Exists(GetAssetPath()))
 	{
 		AssetLoad();
 		LibrarySave(true);
@@ -81,22 +82,22 @@ void RE_Scene::Draw()
 
 void RE_Scene::AssetSave()
 {
-	//Serialize
-	Config scene_SaveFile(GetAssetPath());
+	//Serialize, streamed to the asset file without building a document
+	RE_JsonWriter scene_SaveFile(GetAssetPath());
 	RE_Json* scenebNode = scene_SaveFile.GetRootNode("scene");
 
 	if (toSave->TotalGameObjects() > 0) RE_ECS_Importer::JsonSerialize(scenebNode, toSave);
 	DEL(scenebNode)
 
+	if (!scene_SaveFile.Close()) RE_LOG_ERROR("Error while saving scene %s", GetAssetPath());
+
 	//Setting LibraryPath and MD5
-	eastl::string md5 = scene_SaveFile.GetMd5();
+	RE_FileBuffer saved(GetAssetPath());
+	eastl::string md5 = saved.GetMd5();
 	SetMD5(md5.c_str());
 	eastl::string libraryPath("Library/Scenes/");
 	libraryPath += md5;
 	SetLibraryPath(libraryPath.c_str());
-
-	//Save
-	scene_SaveFile.Save();
 }
 
 void RE_Scene::AssetLoad(bool generateLibraryPath)
@@ -123,10 +124,10 @@ void RE_Scene::AssetLoad(bool generateLibraryPath)
 void RE_Scene::LibraryLoad()
 {
 	RE_FileBuffer binaryLoad(GetLibraryPath());
-	if (binaryLoad.Load())
+	if (binaryLoad.LoadDecompressed())
 	{
 		char* cursor = binaryLoad.GetBuffer();
-		loaded = RE_ECS_Importer::BinaryDeserialize(cursor);
+		loaded = RE_ECS_Importer::BinaryDeserialize(cursor, binaryLoad.GetSize());
 	}
 	ResourceContainer::inMemory = true;
 }
@@ -136,6 +137,6 @@ void RE_Scene::LibrarySave(bool fromLoaded)
 	size_t size = 0;
 	char* buffer = RE_ECS_Importer::BinarySerialize((fromLoaded) ? loaded : toSave, &size);
 	RE_FileBuffer toLibrarySave(GetLibraryPath());
-	toLibrarySave.Save(buffer, size);
+	toLibrarySave.SaveCompressed(buffer, size);
 	DEL_A(buffer);
 }
\ No newline at end of file
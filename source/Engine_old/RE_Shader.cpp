@@ -370,7 +370,7 @@ void RE_Shader::AssetLoad()
 void RE_Shader::LibraryLoad()
 {
 	RE_FileBuffer libraryLoad(GetLibraryPath());
-	if (libraryLoad.Load())
+	if (libraryLoad.LoadDecompressed())
 	{
 		if (!RE_ShaderImporter::LoadFromBinary(libraryLoad.GetBuffer(), libraryLoad.GetSize(), &ID))
 		{
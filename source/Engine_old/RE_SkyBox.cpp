@@ -428,7 +428,7 @@ void RE_SkyBox::LibraryLoad()
 {
 	RE_FileBuffer fileLibray(GetLibraryPath());
 
-	if (fileLibray.Load())
+	if (fileLibray.LoadDecompressed())
 	{
 		char* cursor = fileLibray.GetBuffer();
 		size_t size = sizeof(float);
@@ -29,7 +29,7 @@ void RE_SkyboxImporter::LoadSkyBoxInMemory(RE_SkyBoxSettings& settings, unsigned
 		else texPath = settings.textures[i].path.c_str();
 
 		RE_FileBuffer librayTexture(texPath);
-		if (librayTexture.Load())
+		if (librayTexture.LoadDecompressed())
 		{
 			ILuint imageID = 0;
 			ilGenImages(1, &imageID);
@@ -15,8 +15,7 @@
 const char* RE_Texture::GenerateMD5()
 {
 	const char* ret = nullptr;
-	RE_FileBuffer generateMD5(GetAssetPath());
-	eastl::string newMD5 = generateMD5.GetMd5();
+	eastl::string newMD5 = RE_FS->GetAssetMD5(GetAssetPath());
 	if (!newMD5.empty())
 	{
 		SetMD5(newMD5.c_str());
@@ -318,7 +317,7 @@ void RE_Texture::AssetLoad()
 			&height,
 			texSettings);
 		
-		SetMD5(assetFile.GetMd5().c_str());
+		SetMD5(RE_FS->GetAssetMD5(GetAssetPath(), assetFile.GetBuffer(), assetFile.GetSize()).c_str());
 		eastl::string libraryPath("Library/Textures/");
 		libraryPath += GetMD5();
 		SetLibraryPath(libraryPath.c_str());
@@ -330,7 +329,7 @@ void RE_Texture::AssetLoad()
 void RE_Texture::LibraryLoad()
 {
 	RE_FileBuffer libraryFile(GetLibraryPath());
-	if (libraryFile.Load())
+	if (libraryFile.LoadDecompressed())
 	{
 		RE_TextureImporter::LoadTextureInMemory(
 			libraryFile.GetBuffer(),
@@ -153,7 +153,7 @@ void RE_TextureImporter::SaveOwnFormat(const void* assetBuffer, ILuint assetSize
 		ILuint   size = ilSaveL(IL_DDS, NULL, 0); // Get the size of the data buffer
 		ILubyte *data = new ILubyte[size];
 		ilSaveL(IL_DDS, data, size); // Save with the ilSaveIL function
-		toSave->Save((char*)data, size);
+		toSave->SaveCompressed((char*)data, size);
 		DEL_A(data);
 		ilBindImage(0);
 		/* Delete used resources*/
@@ -0,0 +1,97 @@
+#ifndef __RE_WORKER_POOL_H__
+#define __RE_WORKER_POOL_H__
+
+#include <EASTL/functional.h>
+#include <EASTL/vector.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Threads kept alive for the engine's scene loads and asset scans. Run hands the same job to every
+// worker and the calling thread and returns once all of them finished it.
+class RE_WorkerPool
+{
+public:
+
+	static RE_WorkerPool& Get()
+	{
+		static RE_WorkerPool workers;
+		return workers;
+	}
+
+	void Run(const eastl::function<void()>& job)
+	{
+		// A job started from inside another one runs on the calling thread alone
+		std::unique_lock<std::mutex> running(runMutex, std::try_to_lock);
+		if (!running.owns_lock() || threads.empty())
+		{
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			current = &job;
+			pending = threads.size();
+			generation++;
+		}
+		wake.notify_all();
+
+		job();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() { return pending == 0; });
+		current = nullptr;
+	}
+
+private:
+
+	RE_WorkerPool()
+	{
+		unsigned int count = std::thread::hardware_concurrency();
+		for (unsigned int i = 1; i < count; i++) threads.push_back(std::thread([this]() { Work(); }));
+	}
+
+	~RE_WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+		for (auto& thread : threads) thread.join();
+	}
+
+	void Work()
+	{
+		size_t seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;)
+		{
+			wake.wait(lock, [&]() { return stop || generation != seen; });
+			if (stop) return;
+
+			seen = generation;
+			const eastl::function<void()>* job = current;
+			lock.unlock();
+			(*job)();
+			lock.lock();
+
+			if (--pending == 0) done.notify_one();
+		}
+	}
+
+private:
+
+	eastl::vector<std::thread> threads;
+	std::mutex runMutex;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const eastl::function<void()>* current = nullptr;
+	size_t pending = 0;
+	size_t generation = 0;
+	bool stop = false;
+};
+
+#endif // !__RE_WORKER_POOL_H__
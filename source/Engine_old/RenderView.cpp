@@ -74,17 +74,13 @@ void RenderView::Save(RE_Json* node) const
 }
 
 
-void RenderView::Load(RE_Json* node)
+void RenderView::Load(const RE_JsonCursor& node)
 {
 	RE_PROFILE(RE_ProfiledFunc::Load, RE_ProfiledClass::RenderView);
 
-	if (node == nullptr) return;
-
-	light = static_cast<LightMode>(node->PullUInt("Light Mode", static_cast<uint>(LightMode::DEFERRED)));
-	clear_color = node->PullFloat4("Clear Color", { 0.0f, 0.0f, 0.0f, 1.0f });
-	clip_distance = node->PullFloat4("Clip Distance", math::float4::zero);
+	light = static_cast<LightMode>(node.PullUInt("Light Mode", static_cast<uint>(LightMode::DEFERRED)));
+	clear_color = node.PullFloat4("Clear Color", { 0.0f, 0.0f, 0.0f, 1.0f });
+	clip_distance = node.PullFloat4("Clip Distance", math::float4::zero);
 
-	flags = static_cast<ushort>(node->PullUInt("Flags", 0));
-
-	DEL(node)
+	flags = static_cast<ushort>(node.PullUInt("Flags", 0));
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <EASTL/array.h>
 
 class RE_Json;
+class RE_JsonCursor;
 
 struct RenderView
 {
@@ -69,7 +70,7 @@ struct RenderView
 
 	void DrawEditor();
 	void Save(RE_Json* node) const;
-	void Load(RE_Json* node);
+	void Load(const RE_JsonCursor& node);
 };
 
 #endif // !__RENDER_VIEW_H__
\ No newline at end of file
@@ -207,13 +207,9 @@ void RL_Projects::DrawGUI()
 
 void RL_Projects::Load()
 {
-    uint32_t _projectsIn = 0;
-    {
-        std::string data = RE::FileSystem::Read(PROJECTS_FILE);
-        if (data.empty())
-            return;
-        _projectsIn = RE::JSON::Parse(data);
-    }
+    uint32_t _projectsIn = RE::JSON::ParseFile(PROJECTS_FILE);
+    if (_projectsIn == 0)
+        return;
     _projects.clear();
 
     RE::JSON::PushSelected(_projectsIn);
@@ -261,16 +257,14 @@ void RL_Projects::Save() const
 
 bool RL_Projects::GenerateProject(const char* _name, const char* _path)
 {
-    uint32_t _template = 0;
     std::string _templateDir(TEMPLATE_PATH);
     std::string _buffer;
-    {
-        // Todo, sometimes the template is not found
-        std::string _tempate_str = RE::FileSystem::Read((_templateDir + PROJECT_CONFIG_TEMPLATE).c_str());
-        if (_tempate_str.empty())
-            return false;
-        _template = RE::JSON::Parse(_tempate_str);
-    }
+
+    // Todo, sometimes the template is not found
+    uint32_t _template = RE::JSON::ParseFile((_templateDir + PROJECT_CONFIG_TEMPLATE).c_str());
+    if (_template == 0)
+        return false;
+
     RE::JSON::PushSelected(_template);
     {
         using namespace RE::JSON::Value;
@@ -291,12 +285,12 @@ bool RL_Projects::GenerateProject(const char* _name, const char* _path)
     name += ".reproject";
     std::string path(_path);
     path += '\\';
-    RE::FileSystem::WriteOutside(path.c_str(), name.c_str(), _buffer.c_str(), _buffer.size());
+    RE::FileSystem::WriteNative((path + name).c_str(), _buffer.c_str(), _buffer.size());
 
     std::string _imgui = RE::FileSystem::Read((_templateDir + IMGUI_CONFIG_TEMPLATE).c_str());
     if (_imgui.empty())
         return false;
-    RE::FileSystem::WriteOutside(path.c_str(), IMGUI_CONFIG_TEMPLATE, _imgui.c_str(), _imgui.size());
+    RE::FileSystem::WriteNative((path + IMGUI_CONFIG_TEMPLATE).c_str(), _imgui.c_str(), _imgui.size());
 
     return true;
 }
@@ -306,7 +300,7 @@ bool RL_Projects::LoadProject(const char* path, std::string& outName)
     uint32_t _project = 0;
     std::string _buffer;
     {
-        std::string _tempate_str = RE::FileSystem::ReadOutside(path);
+        std::string _tempate_str = RE::FileSystem::ReadNative(path);
         if (_tempate_str.empty())
             return false;
         _project = RE::JSON::Parse(_tempate_str);
@@ -18,16 +18,218 @@
 
 module;
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <physfs.h>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 export module FileSystem;
 
 std::string _exec_directory;
 std::string _pref_directory;
 
+/**
+ * @brief Reads a whole open file straight into the string's storage.
+ * @param file The open file handle.
+ * @param out The string to fill, resized to the bytes read.
+ * @return True if the file was read completely, false otherwise.
+ */
+bool ReadFile(PHYSFS_File* file, std::string& out)
+{
+    PHYSFS_sint64 file_size = PHYSFS_fileLength(file);
+    if (file_size < 0)
+    {
+        out.clear();
+        return false;
+    }
+
+    // Sized without zero filling, the read writes every byte that is kept
+    out.resize_and_overwrite(static_cast<size_t>(file_size), [file](char* data, size_t size) {
+        PHYSFS_sint64 length_readed = PHYSFS_readBytes(file, data, static_cast<PHYSFS_uint64>(size));
+        return length_readed > 0 ? static_cast<size_t>(length_readed) : size_t(0);
+    });
+    return out.size() == static_cast<size_t>(file_size);
+}
+
+/**
+ * @brief Resolves a mounted path to its path on disk.
+ * @param filepath The path inside the mounted directories.
+ * @return The native path, or an empty string if the file lives inside an archive.
+ */
+std::string NativePath(const char* filepath)
+{
+    const char* real_dir = PHYSFS_getRealDir(filepath);
+    if (real_dir == nullptr)
+        return {};
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(real_dir, error))
+        return {};
+
+    std::string relative(filepath);
+    const char* mount_point = PHYSFS_getMountPoint(real_dir);
+    if (mount_point != nullptr)
+    {
+        std::string mount(mount_point);
+        if (mount != "/" && relative.compare(0, mount.size(), mount) == 0)
+            relative.erase(0, mount.size());
+    }
+    while (!relative.empty() && relative.front() == '/')
+        relative.erase(0, 1);
+
+    return (std::filesystem::path(real_dir) / relative).string();
+}
+
+/**
+ * @brief Worker pool running queued file system tasks, highest priority first.
+ *
+ * Workers start on the first submission and drain every queued task before stopping,
+ * so no future is left without a value. Once stopped, submissions are rejected until
+ * the service is resumed: their tasks are dropped unrun and their futures report a
+ * broken promise, as PhysFS may already be deinitialized.
+ */
+class IOService
+{
+  public:
+    static constexpr size_t priorities = 3;
+    using Task = std::move_only_function<void()>;
+
+    ~IOService()
+    {
+        Stop();
+    }
+
+    bool Submit(size_t priority, Task&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping)
+                return false;
+            StartLocked();
+            _queues[std::min(priority, priorities - 1)].push_back(std::move(task));
+        }
+        _wake.notify_one();
+        return true;
+    }
+
+    bool Submit(size_t priority, std::vector<Task>&& tasks)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping)
+                return false;
+            StartLocked();
+            auto& queue = _queues[std::min(priority, priorities - 1)];
+            for (auto& task : tasks)
+                queue.push_back(std::move(task));
+        }
+        _wake.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Sets how many workers start with the next submission, 0 picks it from the hardware.
+     */
+    void SetWorkerCount(unsigned int count)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _workerCount = count;
+    }
+
+    void Stop()
+    {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            workers.swap(_workers);
+        }
+        _wake.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Accepts submissions again after Stop returned.
+     */
+    void Resume()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = false;
+    }
+
+  private:
+    void StartLocked()
+    {
+        if (!_workers.empty())
+            return;
+
+        unsigned int count = _workerCount ? _workerCount : std::clamp(std::thread::hardware_concurrency() / 2, 2u, 4u);
+        for (unsigned int i = 0; i < count; ++i)
+            _workers.emplace_back([this]() { Run(); });
+    }
+
+    void Run()
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this]() { return _stopping || !Empty(); });
+                if (Empty())
+                    return;
+
+                for (auto& queue : _queues)
+                    if (!queue.empty())
+                    {
+                        task = std::move(queue.front());
+                        queue.pop_front();
+                        break;
+                    }
+            }
+            task();
+        }
+    }
+
+    bool Empty() const
+    {
+        return std::all_of(std::begin(_queues), std::end(_queues), [](const auto& queue) { return queue.empty(); });
+    }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::deque<Task> _queues[priorities];
+    std::vector<std::thread> _workers;
+    unsigned int _workerCount = 0;
+    bool _stopping = false;
+};
+
+IOService _io_service;
+
 export namespace RE
 {
     namespace FileSystem
@@ -43,6 +245,7 @@ export namespace RE
         {
             if (PHYSFS_init(argv[0]) != 0)
             {
+                _io_service.Resume();
 
                 _pref_directory = PHYSFS_getPrefDir(org, app);
                 _exec_directory = argv[0];
@@ -72,10 +275,12 @@ export namespace RE
         }
 
         /**
-         * @brief Cleans up the file system.
+         * @brief Cleans up the file system. Queued requests finish first, later ones are
+         * rejected until the next Init.
          */
         void CleanUp()
         {
+            _io_service.Stop();
             PHYSFS_deinit();
         }
 
@@ -120,6 +325,78 @@ export namespace RE
             PHYSFS_close(myfile);
         }
 
+        /**
+         * @brief Writes data to a file on disk, bypassing the mounted directories.
+         *
+         * Uses the native file API only, so it never touches the PhysFS mount table and can be
+         * called from several threads at once, as long as they write different files.
+         * @param filepath The native path to the file. Missing parent directories are created.
+         * @param buff The buffer containing the data to write.
+         * @param buff_size The size of the buffer.
+         * @return True if all the data was written, false otherwise.
+         */
+        bool WriteNative(const char* filepath, const char* buff, size_t buff_size)
+        {
+            std::filesystem::path native(filepath);
+            std::error_code error;
+            if (native.has_parent_path())
+                std::filesystem::create_directories(native.parent_path(), error);
+
+            std::ofstream file(native, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+            file.write(buff, static_cast<std::streamsize>(buff_size));
+            return static_cast<bool>(file);
+        }
+
+        /**
+         * @brief Reads data from a file on disk into an existing string, bypassing the mounted directories.
+         * @param filepath The native path to the file.
+         * @param out The string to fill with the contents of the file.
+         * @return True if the file was read completely, false otherwise.
+         */
+        bool ReadNative(const char* filepath, std::string& out)
+        {
+            out.clear();
+            std::error_code error;
+            std::uintmax_t file_size = std::filesystem::file_size(filepath, error);
+            if (error)
+                return false;
+
+            std::ifstream file(filepath, std::ios::binary);
+            if (!file)
+                return false;
+
+            out.resize_and_overwrite(static_cast<size_t>(file_size), [&file](char* data, size_t size) {
+                file.read(data, static_cast<std::streamsize>(size));
+                return static_cast<size_t>(file.gcount());
+            });
+            return out.size() == file_size;
+        }
+
+        /**
+         * @brief Reads data from a file on disk, bypassing the mounted directories.
+         * @param filepath The native path to the file.
+         * @return The contents of the file as a string.
+         */
+        std::string ReadNative(const char* filepath)
+        {
+            std::string ret("");
+            ReadNative(filepath, ret);
+            return ret;
+        }
+
+        /**
+         * @brief Checks if a file or directory exists on disk, bypassing the mounted directories.
+         * @param filepath The native path to check.
+         * @return True if the file or directory exists, false otherwise.
+         */
+        bool ExistNative(const char* filepath)
+        {
+            std::error_code error;
+            return std::filesystem::exists(filepath, error);
+        }
+
         /**
          * @brief Writes data to a file outside the mounted directories.
          * @param path The path to the directory.
@@ -129,46 +406,27 @@ export namespace RE
          */
         void WriteOutside(const char* path, const char* file, const char* buff, uint32_t buff_size)
         {
-            if (PHYSFS_unmount(".") == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
-            if (PHYSFS_mount(path, 0, 0) == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
-            if (PHYSFS_setWriteDir(path) == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
+            WriteNative((std::filesystem::path(path) / file).string().c_str(), buff, buff_size);
+        }
+
+        /**
+         * @brief Reads data from a file into an existing string, reusing its capacity.
+         * @param filepath The path to the file.
+         * @param out The string to fill with the contents of the file.
+         * @return True if the file was read completely, false otherwise.
+         */
+        bool Read(const char* filepath, std::string& out)
+        {
+            out.clear();
+            if (PHYSFS_exists(filepath) == 0)
+                return false;
 
-            PHYSFS_file* myfile = PHYSFS_openWrite(file);
+            PHYSFS_file* myfile = PHYSFS_openRead(filepath);
             if (myfile == NULL)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
-            int length_writed = PHYSFS_writeBytes(myfile, buff, buff_size);
+                return false;
+            bool ret = ReadFile(myfile, out);
             PHYSFS_close(myfile);
-
-            if (PHYSFS_unmount(path) == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
-            if (PHYSFS_mount(".", 0, 0) == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
-            if (PHYSFS_setWriteDir(_pref_directory.c_str()) == 0)
-            {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
-            }
+            return ret;
         }
 
         /**
@@ -179,65 +437,219 @@ export namespace RE
         std::string Read(const char* filepath)
         {
             std::string ret("");
-            if (PHYSFS_exists(filepath) != 0)
-            {
-                PHYSFS_file* myfile = PHYSFS_openRead(filepath);
-                PHYSFS_sint64 file_size = PHYSFS_fileLength(myfile);
-                char* myBuf = new char[file_size];
-                long long length_readed = PHYSFS_readBytes(myfile, myBuf, file_size);
-                ret.assign(myBuf, file_size);
-                delete[] myBuf;
-                PHYSFS_close(myfile);
-                return ret;
-            }
+            Read(filepath, ret);
             return ret;
         }
 
         /**
-         * @brief Reads data from a file outside the mounted directories.
+         * @brief Gets the size of a file.
          * @param filepath The path to the file.
-         * @return The contents of the file as a string.
+         * @return The size of the file in bytes, or -1 if it can't be opened.
          */
-        std::string ReadOutside(const char* filepath)
+        int64_t FileSize(const char* filepath)
         {
-            if (PHYSFS_unmount(".") == 0)
+            PHYSFS_Stat stat;
+            if (PHYSFS_stat(filepath, &stat) == 0 || stat.filetype != PHYSFS_FILETYPE_REGULAR)
+                return -1;
+            return stat.filesize;
+        }
+
+        /**
+         * @brief Reads data from a file into a caller-provided buffer.
+         * @param filepath The path to the file.
+         * @param buff The buffer to fill, see FileSize to size it.
+         * @param buff_size The size of the buffer.
+         * @return The number of bytes read, at most buff_size.
+         */
+        size_t ReadInto(const char* filepath, char* buff, size_t buff_size)
+        {
+            PHYSFS_file* myfile = PHYSFS_openRead(filepath);
+            if (myfile == NULL)
+                return 0;
+
+            PHYSFS_sint64 length_readed = PHYSFS_readBytes(myfile, buff, static_cast<PHYSFS_uint64>(buff_size));
+            PHYSFS_close(myfile);
+            return length_readed > 0 ? static_cast<size_t>(length_readed) : 0;
+        }
+
+        /**
+         * @brief Read-only view of a whole file.
+         *
+         * Files on a native directory mount are memory mapped, so the contents are paged in
+         * on first touch and never copied. Files inside archives fall back to a single read
+         * into an owned buffer. The view stays valid until the object is closed or destroyed.
+         */
+        class MappedFile
+        {
+          public:
+            MappedFile() = default;
+            explicit MappedFile(const char* filepath)
             {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
+                Open(filepath);
+            }
+            ~MappedFile()
+            {
+                Close();
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            MappedFile(MappedFile&& other) noexcept
+            {
+                *this = std::move(other);
+            }
+            MappedFile& operator=(MappedFile&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Close();
+                    _data = std::exchange(other._data, nullptr);
+                    _size = std::exchange(other._size, 0);
+                    _mapped = std::exchange(other._mapped, false);
+                    _valid = std::exchange(other._valid, false);
+                    _buffer = std::move(other._buffer);
+                }
+                return *this;
             }
-            std::string _path(filepath);
-            std::string _dir(_path);
-            std::string _file;
+
+            /**
+             * @brief Opens a view of a file, closing any previous one.
+             * @param filepath The path to the file.
+             * @return True if the contents are available, false otherwise.
+             */
+            bool Open(const char* filepath)
+            {
+                Close();
+
+                std::string native = NativePath(filepath);
+                if (!native.empty() && Map(native.c_str()))
+                    return _valid = true;
+
+                int64_t file_size = FileSize(filepath);
+                if (file_size < 0)
+                    return false;
+
+                _buffer.resize(static_cast<size_t>(file_size));
+                _size = ReadInto(filepath, _buffer.data(), _buffer.size());
+                _data = _buffer.data();
+                return _valid = (_size == _buffer.size());
+            }
+
+            /**
+             * @brief Releases the view.
+             */
+            void Close()
+            {
+                if (_mapped)
+                {
 #ifdef _WIN32
-            _dir = _path.substr(0, _path.find_last_of('\\') + 1);
+                    UnmapViewOfFile(_data);
 #else
-            _dir = _path.substr(0, _path.find_last_of('/') + 1);
+                    munmap(const_cast<char*>(_data), _size);
 #endif
-            _file = _path.substr(_dir.size());
-            PHYSFS_mount(_dir.c_str(), "Read/", 0);
+                }
+                _buffer.clear();
+                _buffer.shrink_to_fit();
+                _data = nullptr;
+                _size = 0;
+                _mapped = false;
+                _valid = false;
+            }
 
-            std::string _read_path("Read/");
-            _read_path += _file;
-            std::string ret("");
-            if (PHYSFS_exists(_read_path.c_str()) != 0)
+            bool IsValid() const
+            {
+                return _valid;
+            }
+            bool IsMapped() const
             {
-                PHYSFS_file* myfile = PHYSFS_openRead(_read_path.c_str());
-                PHYSFS_sint64 file_size = PHYSFS_fileLength(myfile);
-                char* myBuf = new char[file_size];
-                long long length_readed = PHYSFS_readBytes(myfile, myBuf, file_size);
-                ret.assign(myBuf, file_size);
-                delete[] myBuf;
-                PHYSFS_close(myfile);
-                return ret;
+                return _mapped;
+            }
+            const char* Data() const
+            {
+                return _data;
+            }
+            size_t Size() const
+            {
+                return _size;
             }
 
-            PHYSFS_unmount(_dir.c_str());
-            if (PHYSFS_mount(".", 0, 0) == 0)
+          private:
+            bool Map(const char* native)
             {
-                PHYSFS_ErrorCode _direrr = PHYSFS_getLastErrorCode();
-                int i = 0;
+#ifdef _WIN32
+                HANDLE file = CreateFileA(native, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                    return false;
+
+                LARGE_INTEGER file_size;
+                if (GetFileSizeEx(file, &file_size) == 0)
+                {
+                    CloseHandle(file);
+                    return false;
+                }
+                if (file_size.QuadPart == 0)
+                {
+                    CloseHandle(file);
+                    return true;
+                }
+
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if (mapping)
+                    CloseHandle(mapping);
+                CloseHandle(file);
+                if (view == nullptr)
+                    return false;
+
+                _size = static_cast<size_t>(file_size.QuadPart);
+#else
+                int file = open(native, O_RDONLY);
+                if (file < 0)
+                    return false;
+
+                struct stat file_stat;
+                if (fstat(file, &file_stat) != 0)
+                {
+                    close(file);
+                    return false;
+                }
+                if (file_stat.st_size == 0)
+                {
+                    close(file);
+                    return true;
+                }
+
+                void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                close(file);
+                if (view == MAP_FAILED)
+                    return false;
+
+                _size = static_cast<size_t>(file_stat.st_size);
+                madvise(view, _size, MADV_SEQUENTIAL);
+#endif
+                _data = static_cast<const char*>(view);
+                _mapped = true;
+                return true;
             }
-            return ret;
+
+          private:
+            const char* _data = nullptr;
+            size_t _size = 0;
+            bool _mapped = false;
+            bool _valid = false;
+            std::vector<char> _buffer;
+        };
+
+        /**
+         * @brief Reads data from a file outside the mounted directories.
+         * @param filepath The path to the file.
+         * @return The contents of the file as a string.
+         */
+        std::string ReadOutside(const char* filepath)
+        {
+            return ReadNative(filepath);
         }
 
         /**
@@ -300,5 +712,114 @@ export namespace RE
             }
             return ret;
         }
+
+        /**
+         * @brief Order in which queued asynchronous requests are served.
+         */
+        enum class Priority : uint8_t
+        {
+            Interactive = 0, ///< Loads the user is waiting on.
+            Normal,
+            Background ///< Imports and prefetches.
+        };
+
+        /**
+         * @brief Sets how many I/O workers serve asynchronous requests. Applied when they next
+         * start, on the first request after Init.
+         * @param count The number of workers, 0 picks it from the hardware concurrency.
+         */
+        void SetIOWorkerCount(unsigned int count)
+        {
+            _io_service.SetWorkerCount(count);
+        }
+
+        /**
+         * @brief Reads data from a file on an I/O worker.
+         * @param filepath The path to the file.
+         * @param priority The queue the request is served from.
+         * @return A future holding the contents of the file.
+         */
+        std::future<std::string> ReadAsync(const char* filepath, Priority priority = Priority::Normal)
+        {
+            std::packaged_task<std::string()> task([path = std::string(filepath)]() { return Read(path.c_str()); });
+            std::future<std::string> ret = task.get_future();
+            _io_service.Submit(static_cast<size_t>(priority), std::move(task));
+            return ret;
+        }
+
+        /**
+         * @brief Reads data from a file on an I/O worker and hands it to a callback.
+         * @param filepath The path to the file.
+         * @param callback Called on the I/O worker with the contents of the file.
+         * @param priority The queue the request is served from.
+         * @return False if the I/O service is stopped, the callback is then never called.
+         */
+        bool ReadAsync(const char* filepath, std::move_only_function<void(std::string)> callback,
+                       Priority priority = Priority::Normal)
+        {
+            return _io_service.Submit(static_cast<size_t>(priority),
+                                      [path = std::string(filepath), callback = std::move(callback)]() mutable {
+                                          callback(Read(path.c_str()));
+                                      });
+        }
+
+        /**
+         * @brief Queues reads for several files at once.
+         * @param filepaths The paths to the files.
+         * @param priority The queue the requests are served from.
+         * @return One future per file, in the same order.
+         */
+        std::vector<std::future<std::string>> ReadBatch(const std::vector<std::string>& filepaths,
+                                                        Priority priority = Priority::Normal)
+        {
+            std::vector<std::future<std::string>> ret;
+            std::vector<IOService::Task> tasks;
+            ret.reserve(filepaths.size());
+            tasks.reserve(filepaths.size());
+            for (const auto& filepath : filepaths)
+            {
+                std::packaged_task<std::string()> task([path = filepath]() { return Read(path.c_str()); });
+                ret.push_back(task.get_future());
+                tasks.push_back(std::move(task));
+            }
+            _io_service.Submit(static_cast<size_t>(priority), std::move(tasks));
+            return ret;
+        }
+
+        /**
+         * @brief Writes data to a file on an I/O worker.
+         * @param path The path to the directory.
+         * @param file The name of the file.
+         * @param buff The data to write, owned by the request until it completes.
+         * @param priority The queue the request is served from.
+         * @return A future that becomes ready once the file is written.
+         */
+        std::future<void> WriteAsync(const char* path, const char* file, std::string buff,
+                                     Priority priority = Priority::Normal)
+        {
+            std::packaged_task<void()> task(
+                [path = std::string(path), file = std::string(file), buff = std::move(buff)]() {
+                    Write(path.c_str(), file.c_str(), buff.data(), static_cast<uint32_t>(buff.size()));
+                });
+            std::future<void> ret = task.get_future();
+            _io_service.Submit(static_cast<size_t>(priority), std::move(task));
+            return ret;
+        }
+
+        /**
+         * @brief Gets the file paths from a directory on an I/O worker.
+         * @param _path The path to the directory.
+         * @param priority The queue the request is served from.
+         * @return A future holding the file paths.
+         */
+        std::future<std::vector<std::string>> GetFilespathFromAsync(const char* _path,
+                                                                    Priority priority = Priority::Normal)
+        {
+            std::packaged_task<std::vector<std::string>()> task(
+                [path = std::string(_path)]() { return GetFilespathFrom(path.c_str()); });
+            std::future<std::vector<std::string>> ret = task.get_future();
+            _io_service.Submit(static_cast<size_t>(priority), std::move(task));
+            return ret;
+        }
     } // namespace FileSystem
 } // namespace RE
\ No newline at end of file
@@ -18,31 +18,105 @@
 
 module;
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <physfs.h>
 #include <rapidjson/document.h>
 #include <rapidjson/pointer.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+
+#include "RE_PhysFSWriteStream.h"
 
 export module JSON;
 
+/**
+ * @brief Value storage for a document. Starts on an inline buffer and is reset,
+ * not freed, when its document is destroyed so the next document reuses it.
+ */
+struct JsonArena
+{
+    static constexpr size_t bufferSize = 64 * 1024;
+
+    std::unique_ptr<char[]> buffer = std::make_unique<char[]>(bufferSize);
+    rapidjson::MemoryPoolAllocator<> allocator{buffer.get(), bufferSize};
+};
+
+std::vector<std::unique_ptr<JsonArena>> _arenaPool;
+std::mutex _arenaMutex;
+constexpr size_t _arenaPoolLimit = 64;
+
+/**
+ * @brief Takes an arena from the pool, creating one when the pool is empty.
+ * @return A reset arena.
+ */
+std::unique_ptr<JsonArena> AcquireArena()
+{
+    {
+        std::lock_guard lock(_arenaMutex);
+        if (!_arenaPool.empty())
+        {
+            std::unique_ptr<JsonArena> arena = std::move(_arenaPool.back());
+            _arenaPool.pop_back();
+            return arena;
+        }
+    }
+    return std::make_unique<JsonArena>();
+}
+
+/**
+ * @brief Returns an arena to the pool once its document is gone.
+ */
+struct ArenaRelease
+{
+    void operator()(JsonArena* arena) const
+    {
+        // Frees overflow chunks and rewinds the inline buffer
+        arena->allocator.Clear();
+
+        std::lock_guard lock(_arenaMutex);
+        if (_arenaPool.size() < _arenaPoolLimit)
+            _arenaPool.emplace_back(arena);
+        else
+            delete arena;
+    }
+};
+
+/**
+ * @brief A document and every piece of state used to walk it. Containers don't share
+ * anything, so different documents can be used from different threads at once.
+ */
 struct JsonContainer
 {
+    // Declared before the document so it is released after the document is destroyed
+    std::unique_ptr<JsonArena, ArenaRelease> arena;
     rapidjson::Document document;
     std::string pointer = "";
+
+    bool isArray = false;
+    rapidjson::Value* array = nullptr;
+    bool isArrayObject = false;
+    rapidjson::Value arrayObject;
+    rapidjson::Value* arrayIter = nullptr;
+
+    JsonContainer() : arena(AcquireArena().release()), document(&arena->allocator)
+    {
+    }
 };
-std::unordered_map<uint32_t, JsonContainer> _jsons;
-uint32_t _nextId = 1;
-std::optional<uint32_t> _selected = std::nullopt;
 
-bool _isArray = false;
-rapidjson::Value* _array = nullptr;
-bool _isArrayObject = false;
-rapidjson::Value _arrayObject;
-rapidjson::Value* _arrayIter = nullptr;
+std::unordered_map<uint32_t, JsonContainer> _jsons;
+std::shared_mutex _jsonsMutex;
+std::atomic<uint32_t> _nextId = 1;
+thread_local std::optional<uint32_t> _selected = std::nullopt;
 
 /**
  * @brief Gets the ID of the JSON container to use.
@@ -56,14 +130,188 @@ inline uint32_t GetID(const uint32_t id)
 }
 
 /**
- * @brief Gets the JSON pointer string.
+ * @brief Creates a JSON container.
+ * @return The ID and the newly created JSON container.
+ */
+std::pair<uint32_t, JsonContainer&> CreateContainer()
+{
+    uint32_t id = _nextId++;
+    std::unique_lock lock(_jsonsMutex);
+    return {id, _jsons.try_emplace(id).first->second};
+}
+
+/**
+ * @brief Gets a JSON container. Containers are never moved once created, so the
+ * reference stays valid while other threads create or destroy theirs.
+ * @param id The ID of the JSON container.
+ * @return The JSON container.
+ */
+JsonContainer& GetContainer(const uint32_t id)
+{
+    uint32_t key = GetID(id);
+    {
+        std::shared_lock lock(_jsonsMutex);
+        auto it = _jsons.find(key);
+        if (it != _jsons.end())
+            return it->second;
+    }
+    std::unique_lock lock(_jsonsMutex);
+    return _jsons.try_emplace(key).first->second;
+}
+
+/**
+ * @brief rapidjson read stream over a PhysFS file, filled chunk by chunk so a file
+ * is parsed without ever being held whole in memory.
+ */
+class PhysFSReadStream
+{
+  public:
+    typedef char Ch;
+
+    PhysFSReadStream(PHYSFS_File* file, char* buffer, size_t bufferSize)
+        : file(file), buffer(buffer), bufferSize(bufferSize), current(buffer)
+    {
+        Read();
+    }
+
+    Ch Peek() const
+    {
+        return *current;
+    }
+
+    Ch Take()
+    {
+        Ch c = *current;
+        Read();
+        return c;
+    }
+
+    size_t Tell() const
+    {
+        return count + static_cast<size_t>(current - buffer);
+    }
+
+    const Ch* Peek4() const
+    {
+        return (current + 4 - !eof <= bufferLast) ? current : nullptr;
+    }
+
+    // Read only
+    void Put(Ch)
+    {
+        RAPIDJSON_ASSERT(false);
+    }
+    void Flush()
+    {
+        RAPIDJSON_ASSERT(false);
+    }
+    Ch* PutBegin()
+    {
+        RAPIDJSON_ASSERT(false);
+        return nullptr;
+    }
+    size_t PutEnd(Ch*)
+    {
+        RAPIDJSON_ASSERT(false);
+        return 0;
+    }
+
+  private:
+    void Read()
+    {
+        if (current < bufferLast)
+        {
+            ++current;
+        }
+        else if (!eof)
+        {
+            count += readCount;
+            PHYSFS_sint64 read = PHYSFS_readBytes(file, buffer, bufferSize);
+            readCount = read > 0 ? static_cast<size_t>(read) : 0;
+            bufferLast = buffer + readCount - 1;
+            current = buffer;
+
+            if (readCount < bufferSize)
+            {
+                // Null terminates the stream, bufferSize is never read whole at the end
+                buffer[readCount] = '\0';
+                ++bufferLast;
+                eof = true;
+            }
+        }
+    }
+
+  private:
+    PHYSFS_File* file;
+    char* buffer;
+    size_t bufferSize;
+    char* current;
+    char* bufferLast = nullptr;
+    size_t readCount = 0;
+    size_t count = 0;
+    bool eof = false;
+};
+
+/**
+ * @brief Hashes the JSON pointer formed by a base pointer and an optional child name.
+ * @param pointer The current JSON pointer.
+ * @param name The name to append to the pointer, or null.
+ * @return FNV-1a hash of "pointer/name", computed without building the string.
+ */
+inline uint64_t HashPointer(std::string_view pointer, std::string_view name, bool hasName)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto feed = [&hash](std::string_view bytes) {
+        for (const char c : bytes)
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    };
+    feed(pointer);
+    if (hasName)
+    {
+        feed("/");
+        feed(name);
+    }
+    return hash;
+}
+
+/**
+ * @brief Gets a compiled JSON pointer, tokenizing its source only when it is not cached.
+ * The cache is a fixed size table per thread, so a lookup never allocates and old pointers
+ * are replaced instead of accumulating.
  * @param pointer The current JSON pointer.
- * @param name The name to append to the pointer.
- * @return The updated JSON pointer string.
+ * @param name The name to append to the pointer, or null.
+ * @return The compiled JSON pointer.
  */
-inline std::string GetPointer(std::string& pointer, const char* name)
+const rapidjson::Pointer& GetCompiledPointer(std::string_view pointer, const char* name = nullptr)
 {
-    return name ? pointer + "/" + name : pointer;
+    struct Slot
+    {
+        uint64_t hash = 0;
+        std::string source;
+        std::optional<rapidjson::Pointer> compiled;
+    };
+    static constexpr size_t cacheSize = 256;
+    thread_local std::array<Slot, cacheSize> cache;
+
+    const std::string_view child = name ? std::string_view(name) : std::string_view();
+    const uint64_t hash = HashPointer(pointer, child, name != nullptr);
+    Slot& slot = cache[hash % cacheSize];
+
+    const size_t length = pointer.size() + (name ? child.size() + 1 : 0);
+    const std::string_view source = slot.source;
+    if (slot.compiled && slot.hash == hash && source.size() == length && source.starts_with(pointer) &&
+        (!name || (source[pointer.size()] == '/' && source.ends_with(child))))
+        return *slot.compiled;
+
+    slot.hash = hash;
+    slot.source.assign(pointer);
+    if (name)
+    {
+        slot.source += '/';
+        slot.source += child;
+    }
+    slot.compiled.emplace(slot.source.c_str(), slot.source.size());
+    return *slot.compiled;
 }
 
 export namespace RE
@@ -76,9 +324,7 @@ export namespace RE
          */
         uint32_t Create()
         {
-            uint32_t id = _nextId++;
-            _jsons.emplace(id, JsonContainer());
-            return id;
+            return CreateContainer().first;
         }
 
         /**
@@ -89,8 +335,7 @@ export namespace RE
          */
         uint32_t Parse(const char* buffer, int32_t size)
         {
-            uint32_t id = _nextId++;
-            auto& jc = _jsons[id];
+            auto [id, jc] = CreateContainer();
             jc.document.Parse(buffer, size);
             return id;
         }
@@ -102,9 +347,54 @@ export namespace RE
          */
         uint32_t Parse(const std::string& buffer)
         {
-            uint32_t id = _nextId++;
-            auto& jc = _jsons[id];
-            jc.document.Parse(buffer.c_str());
+            auto [id, jc] = CreateContainer();
+            jc.document.Parse(buffer.c_str(), buffer.size());
+            return id;
+        }
+
+        /**
+         * @brief Parses a JSON buffer in place and creates a JSON container. Strings
+         * reference the buffer instead of being copied into the document.
+         * @param buffer The null-terminated JSON buffer to parse. It is modified and must
+         * outlive the JSON container.
+         * @return The ID of the newly created JSON container.
+         */
+        uint32_t ParseInsitu(char* buffer)
+        {
+            auto [id, jc] = CreateContainer();
+            jc.document.ParseInsitu(buffer);
+            return id;
+        }
+
+        /**
+         * @brief Parses a JSON file straight from its PhysFS handle and creates a JSON container.
+         * @param filepath The PhysFS path of the JSON file.
+         * @param chunkSize The size of the chunks the file is read in, at least 4 bytes.
+         * @return The ID of the newly created JSON container, 0 if the file can't be opened or parsed.
+         */
+        uint32_t ParseFile(const char* filepath, size_t chunkSize = 64 * 1024)
+        {
+            // The stream needs room for Peek4 and the EOF sentinel
+            chunkSize = std::max<size_t>(chunkSize, 4);
+
+            PHYSFS_File* file = PHYSFS_openRead(filepath);
+            if (file == nullptr)
+                return 0;
+
+            auto [id, jc] = CreateContainer();
+            {
+                std::unique_ptr<char[]> buffer = std::make_unique<char[]>(chunkSize);
+                PhysFSReadStream stream(file, buffer.get(), chunkSize);
+                jc.document.ParseStream(stream);
+            }
+            PHYSFS_close(file);
+
+            if (jc.document.HasParseError())
+            {
+                std::unique_lock lock(_jsonsMutex);
+                _jsons.erase(id);
+                return 0;
+            }
             return id;
         }
 
@@ -115,10 +405,10 @@ export namespace RE
          */
         std::string GetBuffer(const uint32_t id = 0)
         {
-            rapidjson::StringBuffer buffer;
-            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-            _jsons[GetID(id)].document.Accept(writer);
-            return buffer.GetString();
+            PhysFSWriteStream stream;
+            rapidjson::Writer<PhysFSWriteStream> writer(stream);
+            GetContainer(id).document.Accept(writer);
+            return std::move(stream.buffer);
         }
 
         /**
@@ -127,11 +417,12 @@ export namespace RE
          */
         void Destroy(const uint32_t id = 0)
         {
+            std::unique_lock lock(_jsonsMutex);
             _jsons.erase(GetID(id));
         }
 
         /**
-         * @brief Sets the selected JSON container.
+         * @brief Sets the selected JSON container for the calling thread.
          * @param id The ID of the JSON container to select.
          */
         void PushSelected(const uint32_t id = 0)
@@ -140,13 +431,474 @@ export namespace RE
         }
 
         /**
-         * @brief Deselects the current JSON container.
+         * @brief Deselects the current JSON container of the calling thread.
          */
         void PopSelected()
         {
             _selected.reset();
         }
 
+        /**
+         * @brief Handle to an object scope resolved once. Members are read and written through
+         * rapidjson::Value lookups instead of a JSON pointer per call.
+         * @note Adding members to an ancestor scope may relocate this one, so resolve child
+         * cursors after their siblings have been written.
+         */
+        class Cursor
+        {
+          public:
+            Cursor() = default;
+
+            /**
+             * @brief Resolves a scope of a JSON container.
+             * @param id The ID of the JSON container.
+             * @param scope JSON pointer of the scope, relative to the document root. Uses the
+             * container's current pointer when null.
+             * @param create Whether to create the scope as an object when missing.
+             */
+            explicit Cursor(const uint32_t id, const char* scope = nullptr, bool create = true)
+            {
+                JsonContainer& jc = GetContainer(id);
+                const rapidjson::Pointer& pointer =
+                    GetCompiledPointer(scope ? std::string_view(scope) : std::string_view(jc.pointer));
+                value = create ? &pointer.Create(jc.document) : pointer.Get(jc.document);
+                if (value && !value->IsObject())
+                {
+                    if (create)
+                        value->SetObject();
+                    else
+                        value = nullptr;
+                }
+                allocator = &jc.document.GetAllocator();
+            }
+
+            /**
+             * @brief Checks whether the cursor references an object.
+             * @return True if the cursor can be read or written, false otherwise.
+             */
+            bool IsValid() const
+            {
+                return value != nullptr;
+            }
+
+            /**
+             * @brief Checks whether the scope has a member.
+             * @param name The name of the member.
+             * @return True if the member exists, false otherwise.
+             */
+            bool Has(const char* name) const
+            {
+                return Find(name) != nullptr;
+            }
+
+            /**
+             * @brief Resolves a child object scope.
+             * @param name The name of the child object.
+             * @param create Whether to create the child object when missing.
+             * @return The cursor of the child object, invalid if missing and not created.
+             */
+            Cursor Child(const char* name, bool create = true)
+            {
+                rapidjson::Value* child = create ? &Member(name) : Find(name);
+                if (child && !child->IsObject())
+                {
+                    if (create)
+                        child->SetObject();
+                    else
+                        child = nullptr;
+                }
+                return Cursor(child, allocator);
+            }
+
+            /**
+             * @brief Sets a string member.
+             * @param name The name of the member.
+             * @param val The string value to set.
+             */
+            void PushString(const char* name, const char* val)
+            {
+                Member(name).SetString(val, *allocator);
+            }
+
+            /**
+             * @brief Sets an integer member.
+             * @param name The name of the member.
+             * @param val The integer value to set.
+             */
+            void PushInt(const char* name, int32_t val)
+            {
+                Member(name).SetInt(val);
+            }
+
+            /**
+             * @brief Sets a float member.
+             * @param name The name of the member.
+             * @param val The float value to set.
+             */
+            void PushFloat(const char* name, float val)
+            {
+                Member(name).SetFloat(val);
+            }
+
+            /**
+             * @brief Sets a boolean member.
+             * @param name The name of the member.
+             * @param val The boolean value to set.
+             */
+            void PushBool(const char* name, bool val)
+            {
+                Member(name).SetBool(val);
+            }
+
+            /**
+             * @brief Sets an integer array member.
+             * @param name The name of the member.
+             * @param values The integers to set.
+             * @param count The number of integers.
+             */
+            void PushInts(const char* name, const int32_t* values, size_t count)
+            {
+                rapidjson::Value& arr = Member(name).SetArray();
+                arr.Reserve(static_cast<rapidjson::SizeType>(count), *allocator);
+                for (size_t i = 0; i < count; ++i)
+                    arr.PushBack(values[i], *allocator);
+            }
+
+            /**
+             * @brief Sets a float array member.
+             * @param name The name of the member.
+             * @param values The floats to set.
+             * @param count The number of floats.
+             */
+            void PushFloats(const char* name, const float* values, size_t count)
+            {
+                rapidjson::Value& arr = Member(name).SetArray();
+                arr.Reserve(static_cast<rapidjson::SizeType>(count), *allocator);
+                for (size_t i = 0; i < count; ++i)
+                    arr.PushBack(values[i], *allocator);
+            }
+
+            /**
+             * @brief Gets a string member.
+             * @param name The name of the member.
+             * @param deflt The default value to return if the member is missing or not a string.
+             * @return The string value of the member.
+             */
+            std::string PullString(const char* name, const char* deflt) const
+            {
+                const rapidjson::Value* val = Find(name);
+                return val && val->IsString() ? std::string(val->GetString(), val->GetStringLength()) : deflt;
+            }
+
+            /**
+             * @brief Gets an integer member.
+             * @param name The name of the member.
+             * @param deflt The default value to return if the member is missing or not an integer.
+             * @return The integer value of the member.
+             */
+            int32_t PullInt(const char* name, int32_t deflt) const
+            {
+                const rapidjson::Value* val = Find(name);
+                return val && val->IsInt() ? val->GetInt() : deflt;
+            }
+
+            /**
+             * @brief Gets an unsigned 64-bit integer member, such as an UID or a size.
+             * @param name The name of the member.
+             * @param deflt The default value to return if the member is missing or not an unsigned integer.
+             * @return The integer value of the member.
+             */
+            uint64_t PullUInt64(const char* name, uint64_t deflt) const
+            {
+                const rapidjson::Value* val = Find(name);
+                return val && val->IsUint64() ? val->GetUint64() : deflt;
+            }
+
+            /**
+             * @brief Gets a float member.
+             * @param name The name of the member.
+             * @param deflt The default value to return if the member is missing or not a number.
+             * @return The float value of the member.
+             */
+            float PullFloat(const char* name, float deflt) const
+            {
+                const rapidjson::Value* val = Find(name);
+                return val && val->IsNumber() ? val->GetFloat() : deflt;
+            }
+
+            /**
+             * @brief Gets a boolean member.
+             * @param name The name of the member.
+             * @param deflt The default value to return if the member is missing or not a boolean.
+             * @return The boolean value of the member.
+             */
+            bool PullBool(const char* name, bool deflt) const
+            {
+                const rapidjson::Value* val = Find(name);
+                return val && val->IsBool() ? val->GetBool() : deflt;
+            }
+
+            /**
+             * @brief Gets an integer array member.
+             * @param name The name of the member.
+             * @param values Destination for the integers.
+             * @param count The capacity of the destination.
+             * @return The number of integers read.
+             */
+            size_t PullInts(const char* name, int32_t* values, size_t count) const
+            {
+                const rapidjson::Value* val = Find(name);
+                if (!val || !val->IsArray())
+                    return 0;
+
+                size_t read = 0;
+                for (auto it = val->Begin(); it != val->End() && read < count; ++it)
+                    if (it->IsInt())
+                        values[read++] = it->GetInt();
+                return read;
+            }
+
+            /**
+             * @brief Gets a float array member.
+             * @param name The name of the member.
+             * @param values Destination for the floats.
+             * @param count The capacity of the destination.
+             * @return The number of floats read.
+             */
+            size_t PullFloats(const char* name, float* values, size_t count) const
+            {
+                const rapidjson::Value* val = Find(name);
+                if (!val || !val->IsArray())
+                    return 0;
+
+                size_t read = 0;
+                for (auto it = val->Begin(); it != val->End() && read < count; ++it)
+                    if (it->IsNumber())
+                        values[read++] = it->GetFloat();
+                return read;
+            }
+
+          private:
+            Cursor(rapidjson::Value* value, rapidjson::Document::AllocatorType* allocator)
+                : value(value), allocator(allocator)
+            {
+            }
+
+            rapidjson::Value* Find(const char* name) const
+            {
+                if (!value)
+                    return nullptr;
+                auto member = value->FindMember(name);
+                return member != value->MemberEnd() ? &member->value : nullptr;
+            }
+
+            rapidjson::Value& Member(const char* name)
+            {
+                if (rapidjson::Value* val = Find(name))
+                    return *val;
+                value->AddMember(rapidjson::Value(name, *allocator), rapidjson::Value(), *allocator);
+                return (value->MemberEnd() - 1)->value;
+            }
+
+          private:
+            rapidjson::Value* value = nullptr;
+            rapidjson::Document::AllocatorType* allocator = nullptr;
+        };
+
+        /**
+         * @brief Streaming writer that emits JSON as it is pushed, without building a document.
+         * Output goes to a PhysFS file in fixed size chunks or into a growable buffer.
+         * @note Objects and arrays must be closed in the reverse order they were started.
+         * Values pushed inside arrays take a null name.
+         */
+        class Writer
+        {
+          public:
+            /**
+             * @brief Creates a writer into a growable buffer.
+             */
+            Writer() : writer(stream)
+            {
+            }
+
+            /**
+             * @brief Creates a writer into a file of the PhysFS write directory.
+             * @param filepath The path of the file to write.
+             * @param chunkSize The size of the chunks written to the file.
+             */
+            explicit Writer(const char* filepath, size_t chunkSize = 64 * 1024)
+                : writer(stream)
+            {
+                stream.Open(filepath, chunkSize);
+            }
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            ~Writer()
+            {
+                Close();
+            }
+
+            /**
+             * @brief Checks whether everything written so far reached its destination. A file
+             * that failed to open or write drops further output instead of buffering it.
+             * @return True if the file is open and no write failed, false otherwise.
+             */
+            bool IsValid() const
+            {
+                return !stream.failed;
+            }
+
+            /**
+             * @brief Starts an object.
+             * @param name The member name of the object, null inside arrays and at the root.
+             */
+            void StartObject(const char* name = nullptr)
+            {
+                Key(name);
+                writer.StartObject();
+            }
+
+            /**
+             * @brief Ends the last started object.
+             */
+            void EndObject()
+            {
+                writer.EndObject();
+            }
+
+            /**
+             * @brief Starts an array.
+             * @param name The member name of the array, null inside arrays and at the root.
+             */
+            void StartArray(const char* name = nullptr)
+            {
+                Key(name);
+                writer.StartArray();
+            }
+
+            /**
+             * @brief Ends the last started array.
+             */
+            void EndArray()
+            {
+                writer.EndArray();
+            }
+
+            /**
+             * @brief Writes a string value.
+             * @param name The member name, null inside arrays.
+             * @param val The string value to write.
+             */
+            void PushString(const char* name, const char* val)
+            {
+                Key(name);
+                writer.String(val);
+            }
+
+            /**
+             * @brief Writes an integer value.
+             * @param name The member name, null inside arrays.
+             * @param val The integer value to write.
+             */
+            void PushInt(const char* name, int32_t val)
+            {
+                Key(name);
+                writer.Int(val);
+            }
+
+            /**
+             * @brief Writes an unsigned 64-bit integer value, such as an UID or a size.
+             * @param name The member name, null inside arrays.
+             * @param val The integer value to write.
+             */
+            void PushUInt64(const char* name, uint64_t val)
+            {
+                Key(name);
+                writer.Uint64(val);
+            }
+
+            /**
+             * @brief Writes a float value.
+             * @param name The member name, null inside arrays.
+             * @param val The float value to write.
+             */
+            void PushFloat(const char* name, float val)
+            {
+                Key(name);
+                writer.Double(static_cast<double>(val));
+            }
+
+            /**
+             * @brief Writes a boolean value.
+             * @param name The member name, null inside arrays.
+             * @param val The boolean value to write.
+             */
+            void PushBool(const char* name, bool val)
+            {
+                Key(name);
+                writer.Bool(val);
+            }
+
+            /**
+             * @brief Writes an integer array.
+             * @param name The member name, null inside arrays.
+             * @param values The integers to write.
+             * @param count The number of integers.
+             */
+            void PushInts(const char* name, const int32_t* values, size_t count)
+            {
+                StartArray(name);
+                for (size_t i = 0; i < count; ++i)
+                    writer.Int(values[i]);
+                writer.EndArray(static_cast<rapidjson::SizeType>(count));
+            }
+
+            /**
+             * @brief Writes a float array.
+             * @param name The member name, null inside arrays.
+             * @param values The floats to write.
+             * @param count The number of floats.
+             */
+            void PushFloats(const char* name, const float* values, size_t count)
+            {
+                StartArray(name);
+                for (size_t i = 0; i < count; ++i)
+                    writer.Double(static_cast<double>(values[i]));
+                writer.EndArray(static_cast<rapidjson::SizeType>(count));
+            }
+
+            /**
+             * @brief Gets the JSON written into the buffer.
+             * @return The written JSON, empty when writing to a file.
+             */
+            std::string_view GetBuffer() const
+            {
+                return stream.file ? std::string_view() : std::string_view(stream.buffer);
+            }
+
+            /**
+             * @brief Flushes the pending chunk and closes the file. Called on destruction.
+             * @return True if a complete JSON value was written and stored, false otherwise.
+             */
+            bool Close()
+            {
+                return stream.Close() && writer.IsComplete();
+            }
+
+          private:
+            void Key(const char* name)
+            {
+                if (name)
+                    writer.Key(name);
+            }
+
+          private:
+            PhysFSWriteStream stream;
+            rapidjson::Writer<PhysFSWriteStream> writer;
+        };
+
         namespace Value
         {
             /**
@@ -156,7 +908,7 @@ export namespace RE
              */
             void Push(const char* name, const uint32_t id = 0)
             {
-                std::string& pointer = _jsons[GetID(id)].pointer;
+                std::string& pointer = GetContainer(id).pointer;
                 pointer += "/";
                 pointer += name;
             }
@@ -167,7 +919,7 @@ export namespace RE
              */
             void Pop(const uint32_t id = 0)
             {
-                JsonContainer& jc = _jsons[GetID(id)];
+                JsonContainer& jc = GetContainer(id);
                 jc.pointer = jc.pointer.substr(0, jc.pointer.find_last_of('/'));
             }
 
@@ -177,8 +929,8 @@ export namespace RE
              */
             void SetObject(const uint32_t id = 0)
             {
-                JsonContainer& jc = _jsons[GetID(id)];
-                rapidjson::Pointer(jc.pointer.c_str()).Get(jc.document)->SetObject();
+                JsonContainer& jc = GetContainer(id);
+                GetCompiledPointer(jc.pointer).Get(jc.document)->SetObject();
             }
 
             /**
@@ -187,8 +939,8 @@ export namespace RE
              */
             void SetArray(const uint32_t id = 0)
             {
-                JsonContainer& jc = _jsons[GetID(id)];
-                rapidjson::Pointer(jc.pointer.c_str()).Get(jc.document)->SetArray();
+                JsonContainer& jc = GetContainer(id);
+                GetCompiledPointer(jc.pointer).Get(jc.document)->SetArray();
             }
 
             namespace Array
@@ -200,14 +952,14 @@ export namespace RE
                  */
                 void Enable(bool pushObjects, const uint32_t id = 0)
                 {
-                    _isArray = true;
-                    JsonContainer& jc = _jsons[GetID(id)];
-                    _array = rapidjson::Pointer(jc.pointer.c_str()).Get(jc.document);
+                    JsonContainer& jc = GetContainer(id);
+                    jc.isArray = true;
+                    jc.array = GetCompiledPointer(jc.pointer).Get(jc.document);
                     if (pushObjects)
                     {
-                        _isArrayObject = true;
-                        _arrayObject = rapidjson::Value();
-                        _arrayObject.SetObject();
+                        jc.isArrayObject = true;
+                        jc.arrayObject = rapidjson::Value();
+                        jc.arrayObject.SetObject();
                     }
                 }
 
@@ -219,28 +971,30 @@ export namespace RE
                  */
                 bool PullMode(const char* name = nullptr, const uint32_t id = 0)
                 {
-                    JsonContainer& jc = _jsons[GetID(id)];
-                    rapidjson::Value* val = rapidjson::Pointer(GetPointer(jc.pointer, name).c_str()).Get(jc.document);
+                    JsonContainer& jc = GetContainer(id);
+                    rapidjson::Value* val = GetCompiledPointer(jc.pointer, name).Get(jc.document);
                     if (val->IsArray() == false)
                     {
                         return false;
                     }
-                    _isArray = true;
-                    _array = val;
+                    jc.isArray = true;
+                    jc.array = val;
                     return true;
                 }
 
                 /**
                  * @brief Disables array mode for the current JSON container.
+                 * @param id The ID of the JSON container.
                  */
-                void Disable()
+                void Disable(const uint32_t id = 0)
                 {
-                    _isArray = false;
-                    _array = nullptr;
-                    _isArrayObject = false;
-                    _arrayIter = nullptr;
-                    _arrayObject = rapidjson::Value();
-                    _arrayObject.SetObject();
+                    JsonContainer& jc = GetContainer(id);
+                    jc.isArray = false;
+                    jc.array = nullptr;
+                    jc.isArrayObject = false;
+                    jc.arrayIter = nullptr;
+                    jc.arrayObject = rapidjson::Value();
+                    jc.arrayObject.SetObject();
                 }
 
                 /**
@@ -249,14 +1003,14 @@ export namespace RE
                  */
                 void PushObject(const uint32_t id = 0)
                 {
-                    if (_isArray && _isArrayObject)
+                    JsonContainer& jc = GetContainer(id);
+                    if (jc.isArray && jc.isArrayObject)
                     {
-                        // ASSERT: _isArray == true && _isArrayObject == true
+                        // ASSERT: jc.isArray == true && jc.isArrayObject == true
                         // TODO: how to handle value types
-                        JsonContainer& jc = _jsons[GetID(id)];
-                        _array->PushBack(_arrayObject, jc.document.GetAllocator());
-                        _arrayObject = rapidjson::Value();
-                        _arrayObject.SetObject();
+                        jc.array->PushBack(jc.arrayObject, jc.document.GetAllocator());
+                        jc.arrayObject = rapidjson::Value();
+                        jc.arrayObject.SetObject();
                     }
                 }
 
@@ -267,20 +1021,21 @@ export namespace RE
                  */
                 bool PullObject(const uint32_t id = 0)
                 {
-                    // ASSERT: _isArray == true
-                    if (_isArray)
+                    // ASSERT: jc.isArray == true
+                    JsonContainer& jc = GetContainer(id);
+                    if (jc.isArray)
                     {
-                        if (_arrayIter == nullptr)
+                        if (jc.arrayIter == nullptr)
                         {
-                            _arrayIter = _array->Begin();
+                            jc.arrayIter = jc.array->Begin();
                         }
                         else
                         {
-                            _arrayIter++;
+                            jc.arrayIter++;
                         }
-                        // ASSERT: _arrayIter->IsObject() == true
+                        // ASSERT: jc.arrayIter->IsObject() == true
 
-                        return _arrayIter != _array->End();
+                        return jc.arrayIter != jc.array->End();
                     }
                     return false;
                 }
@@ -294,16 +1049,16 @@ export namespace RE
              */
             void PushString(const char* value, const char* name = nullptr, const uint32_t id = 0)
             {
-                JsonContainer& jc = _jsons[GetID(id)];
-                if (_isArray && _isArrayObject)
+                JsonContainer& jc = GetContainer(id);
+                if (jc.isArray && jc.isArrayObject)
                 {
-                    _arrayObject.AddMember(rapidjson::Value().SetString(name, jc.document.GetAllocator()),
+                    jc.arrayObject.AddMember(rapidjson::Value().SetString(name, jc.document.GetAllocator()),
                                            rapidjson::Value().SetString(value, jc.document.GetAllocator()),
                                            jc.document.GetAllocator());
                 }
                 else
                 {
-                    rapidjson::Pointer(GetPointer(jc.pointer, name).c_str()).Set(jc.document, value);
+                    GetCompiledPointer(jc.pointer, name).Set(jc.document, value);
                 }
             }
 
@@ -316,15 +1071,15 @@ export namespace RE
              */
             std::string PullString(const char* name, const char* deflt, const uint32_t id = 0)
             {
-                if (_isArray && _array && _arrayIter)
+                JsonContainer& jc = GetContainer(id);
+                if (jc.isArray && jc.array && jc.arrayIter)
                 {
-                    // ASSERT: _arrayIter != _array->End()
-                    return _arrayIter->FindMember(name)->value.GetString();
+                    // ASSERT: jc.arrayIter != jc.array->End()
+                    return jc.arrayIter->FindMember(name)->value.GetString();
                 }
                 else
                 {
-                    JsonContainer& jc = _jsons[GetID(id)];
-                    rapidjson::Value* val = rapidjson::Pointer(GetPointer(jc.pointer, name).c_str()).Get(jc.document);
+                    rapidjson::Value* val = GetCompiledPointer(jc.pointer, name).Get(jc.document);
                     return val ? val->GetString() : deflt;
                 }
             }
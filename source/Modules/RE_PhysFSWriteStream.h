@@ -0,0 +1,127 @@
+/*
+ * RedEye Engine - A 3D Game Engine written in C++.
+ * Copyright (C) 2018-2024 Julia Mauri and Ruben Sardon
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#if __has_include(<physfs.h>)
+#include <physfs.h>
+#else
+#include <PhysFS/physfs.h>
+#endif
+#if __has_include(<rapidjson/rapidjson.h>)
+#include <rapidjson/rapidjson.h>
+#else
+#include <RapidJson/rapidjson.h>
+#endif
+
+/**
+ * @brief rapidjson write stream into a growable buffer. When opened on a PhysFS file, the buffer
+ * only holds one chunk and is flushed to the file whenever it fills up. Shared by RE::JSON::Writer
+ * and the legacy RE_JsonWriter.
+ */
+class PhysFSWriteStream
+{
+  public:
+    typedef char Ch;
+
+    /**
+     * @brief Opens a file of the PhysFS write directory to stream into.
+     * @param filepath The path of the file to write.
+     * @param size The size of the chunks written to the file.
+     * @return True if the file was opened. Otherwise the stream is failed and drops its output.
+     */
+    bool Open(const char* filepath, size_t size)
+    {
+        file = PHYSFS_openWrite(filepath);
+        chunkSize = size;
+        failed = file == nullptr;
+        if (!failed)
+            buffer.reserve(chunkSize);
+        return !failed;
+    }
+
+    /**
+     * @brief Flushes the pending chunk and closes the file.
+     * @return True if every byte reached the file, false otherwise.
+     */
+    bool Close()
+    {
+        if (file)
+        {
+            Flush();
+            if (PHYSFS_close(file) == 0)
+                failed = true;
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+    void Put(Ch c)
+    {
+        if (failed)
+            return;
+        buffer.push_back(c);
+        if (file && buffer.size() >= chunkSize)
+            Flush();
+    }
+
+    void Flush()
+    {
+        if (file && !buffer.empty())
+        {
+            if (PHYSFS_writeBytes(file, buffer.data(), buffer.size()) != static_cast<PHYSFS_sint64>(buffer.size()))
+                failed = true;
+            buffer.clear();
+        }
+    }
+
+    // Write only
+    Ch Peek() const
+    {
+        RAPIDJSON_ASSERT(false);
+        return 0;
+    }
+    Ch Take()
+    {
+        RAPIDJSON_ASSERT(false);
+        return 0;
+    }
+    size_t Tell() const
+    {
+        RAPIDJSON_ASSERT(false);
+        return 0;
+    }
+    Ch* PutBegin()
+    {
+        RAPIDJSON_ASSERT(false);
+        return nullptr;
+    }
+    size_t PutEnd(Ch*)
+    {
+        RAPIDJSON_ASSERT(false);
+        return 0;
+    }
+
+  public:
+    PHYSFS_File* file = nullptr;
+    size_t chunkSize = 0;
+    std::string buffer;
+    bool failed = false;
+};
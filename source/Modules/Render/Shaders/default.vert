@@ -0,0 +1,19 @@
+#version 450
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+layout(location = 0) out vec3 fragColor;
+
+layout(set = 0, binding = 0) uniform TransfomMatrices {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(push_constant) uniform DrawConstants {
+    mat4 model;
+} draw;
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * draw.model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+}
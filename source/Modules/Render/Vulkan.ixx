@@ -21,13 +21,30 @@ module;
 #include <SDL2/SDL.h>
 #include <SDL_vulkan.h>
 #include <vulkan/vulkan.h>
-
+#ifdef ENABLE_SHADERC
+#include <shaderc/shaderc.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <set>
 
 export module Vulkan;
 
+import FileSystem;
+
 std::vector<VkLayerProperties> availableLayers{};
 
 // TODO: Setup Allocation Callbacks for memory management
@@ -56,6 +73,24 @@ namespace Criteria
             "VK_LAYER_NV_optimus" // Ensures discrete NVIDIA GPU usage instead of default integrated GPU
                                   // Improves Nvidia performance on laptops
         };
+
+        // Frames recorded while the GPU still works on previous ones
+        const uint32_t frames_in_flight = 2;
+
+        // Size of each vkAllocateMemory block the sub-allocator carves resources from
+        const VkDeviceSize memory_block_size = 64ull * 1024 * 1024;
+
+        // Persistent host visible ring that staged uploads are copied through
+        const VkDeviceSize staging_ring_size = 32ull * 1024 * 1024;
+
+        // Uniform data each frame in flight can write before wrapping its slice of the uniform ring
+        const VkDeviceSize uniform_ring_size = 1024 * 1024;
+
+        // Fewest draws worth handing to another recording thread
+        const uint32_t draws_per_record_thread = 64;
+
+        // Pipeline cache file, stored in the preference directory
+        const char* pipeline_cache_file = "vulkan_pipeline.cache";
     } // namespace Prefered
 
     namespace Required
@@ -93,50 +128,201 @@ namespace Criteria
     } // namespace Swapchain
 } // namespace Criteria
 
+// Overrides where the caches are written, set through SetCacheDirectory
+std::string cache_directory;
+
+// Pipeline and shader caches live in the directory set with SetCacheDirectory, else in the
+// preference directory. Without an initialized FileSystem module they go next to the executable,
+// as SDL reports it, and in the working directory if SDL can't tell.
+std::string CacheDirectory()
+{
+    if (!cache_directory.empty())
+        return cache_directory;
+
+    std::string directory = RE::FileSystem::GetPrefDirectory();
+    if (directory.empty())
+        directory = RE::FileSystem::GetExecutableDirectory();
+    if (directory.empty())
+    {
+        if (char* base_path = SDL_GetBasePath())
+        {
+            directory = base_path;
+            SDL_free(base_path);
+        }
+        else
+        {
+            std::error_code error;
+            directory = (std::filesystem::current_path(error) / "").string();
+        }
+    }
+    return directory;
+}
+
 namespace Shaders
 {
+    struct Source
+    {
+        const char* name = nullptr;
+        VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+        const char* glsl = nullptr;
+        const uint32_t* spirv = nullptr; // Compiled at build time, without defines
+        size_t spirv_size = 0;           // In bytes
+    };
+
+    using Defines = std::vector<std::pair<std::string, std::string>>;
+
     namespace Default
     {
-        const char* Vertex = R"(
-            #version 450
-            layout(location = 0) in vec3 inPosition;
-            layout(location = 1) in vec3 inColor;
-            
-            layout(location = 0) out vec3 fragColor;
-            
-            layout(set = 0, binding = 0) uniform TransfomMatrices {
-                mat4 model;
-                mat4 view;
-                mat4 proj;
-            } ubo;
-            
-            void main() {
-                gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
-                fragColor = inColor;
-            }
-        )";
+        // Generated from Render/Shaders at configure and build time
+        const char* VertexGLSL =
+#include "default.vert.glsl.inc"
+            ;
+        const char* FragmentGLSL =
+#include "default.frag.glsl.inc"
+            ;
+
+#ifdef RE_PRECOMPILED_SHADERS
+        const uint32_t VertexSPIRV[] = {
+#include "default.vert.spv.inc"
+        };
+        const uint32_t FragmentSPIRV[] = {
+#include "default.frag.spv.inc"
+        };
+
+        const Source Vertex = {"default.vert", VK_SHADER_STAGE_VERTEX_BIT, VertexGLSL, VertexSPIRV, sizeof(VertexSPIRV)};
+        const Source Fragment = {"default.frag", VK_SHADER_STAGE_FRAGMENT_BIT, FragmentGLSL, FragmentSPIRV,
+                                 sizeof(FragmentSPIRV)};
+#else
+        const Source Vertex = {"default.vert", VK_SHADER_STAGE_VERTEX_BIT, VertexGLSL};
+        const Source Fragment = {"default.frag", VK_SHADER_STAGE_FRAGMENT_BIT, FragmentGLSL};
+#endif
+    } // namespace Default
 
-        const char* Fragment = R"(
-            #version 450
-            layout(location = 0) in vec3 fragColor;
-            layout(location = 0) out vec4 outColor;
+    const uint32_t spirv_magic = 0x07230203;
 
-            void main() {
-                outColor = vec4(fragColor, 1.0);
+    // FNV-1a over the stage, the GLSL and the defines, names the cached SPIR-V of a variant
+    uint64_t Hash(const Source& source, const Defines& defines)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t size) {
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= static_cast<const uint8_t*>(data)[i];
+                hash *= 1099511628211ull;
             }
-        )";
-    } // namespace Default
+        };
+
+        mix(&source.stage, sizeof(source.stage));
+        mix(source.glsl, strlen(source.glsl));
+        for (const auto& [name, value] : defines) // Terminators keep {"AB", ""} and {"A", "B"} apart
+        {
+            mix(name.c_str(), name.size() + 1);
+            mix(value.c_str(), value.size() + 1);
+        }
+        return hash;
+    }
+
+    std::string CachePath(const Source& source, const Defines& defines)
+    {
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(Hash(source, defines)));
+        return CacheDirectory() + "shaders/" + source.name + "-" + hash + ".spv";
+    }
+
+#ifdef ENABLE_SHADERC
+    bool Compile(const Source& source, const Defines& defines, std::vector<uint32_t>& spirv)
+    {
+        shaderc_shader_kind kind;
+        switch (source.stage)
+        {
+            case VK_SHADER_STAGE_VERTEX_BIT:
+                kind = shaderc_vertex_shader;
+                break;
+            case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT:
+                kind = shaderc_tess_control_shader;
+                break;
+            case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT:
+                kind = shaderc_tess_evaluation_shader;
+                break;
+            case VK_SHADER_STAGE_GEOMETRY_BIT:
+                kind = shaderc_geometry_shader;
+                break;
+            case VK_SHADER_STAGE_FRAGMENT_BIT:
+                kind = shaderc_fragment_shader;
+                break;
+            case VK_SHADER_STAGE_COMPUTE_BIT:
+                kind = shaderc_compute_shader;
+                break;
+            default:
+                std::cerr << "Unsupported shader stage for " << source.name << "!" << std::endl;
+                return false;
+        }
+
+        shaderc::CompileOptions options;
+        options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        for (const auto& [name, value] : defines)
+            options.AddMacroDefinition(name, value);
+
+        std::cout << "Compiling " << source.name << " to SPIR-V." << std::endl;
+        shaderc::Compiler compiler;
+        shaderc::SpvCompilationResult result =
+            compiler.CompileGlslToSpv(source.glsl, strlen(source.glsl), kind, source.name, options);
+        if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+        {
+            std::cerr << "Failed to compile " << source.name << ": " << result.GetErrorMessage() << std::endl;
+            return false;
+        }
+
+        spirv.assign(result.cbegin(), result.cend());
+        return true;
+    }
+#endif
+
+    // Build time SPIR-V first, then the disk cache, and only then compiling and caching the result
+    bool Load(const Source& source, const Defines& defines, std::vector<uint32_t>& spirv)
+    {
+        if (defines.empty() && source.spirv != nullptr)
+        {
+            spirv.assign(source.spirv, source.spirv + source.spirv_size / sizeof(uint32_t));
+            return true;
+        }
+
+        const std::string path = CachePath(source, defines);
+        std::string file{};
+        if (RE::FileSystem::ReadNative(path.c_str(), file) && file.size() >= 5 * sizeof(uint32_t) &&
+            file.size() % sizeof(uint32_t) == 0)
+        {
+            spirv.resize(file.size() / sizeof(uint32_t));
+            memcpy(spirv.data(), file.data(), file.size());
+            if (spirv[0] == spirv_magic)
+                return true;
+        }
 
-    bool CreateModule(VkDevice logical_device, const char* code, VkShaderModule& shaderModule)
+#ifdef ENABLE_SHADERC
+        if (!Compile(source, defines, spirv))
+            return false;
+
+        if (!RE::FileSystem::WriteNative(path.c_str(), reinterpret_cast<const char*>(spirv.data()),
+                                         spirv.size() * sizeof(uint32_t)))
+            std::cerr << "Failed to cache " << source.name << " SPIR-V to " << path << std::endl;
+        return true;
+#else
+        std::cerr << "No SPIR-V for " << source.name << " and runtime shader compilation is disabled!" << std::endl;
+        return false;
+#endif
+    }
+
+    bool CreateModule(VkDevice logical_device, const Source& source, VkShaderModule& shaderModule,
+                      const Defines& defines = {})
     {
-        size_t codeSize = strlen(code);
-        std::vector<uint32_t> codeBytes((codeSize + 3) / 4);
-        memcpy(codeBytes.data(), code, codeSize);
+        std::vector<uint32_t> code{};
+        if (!Load(source, defines, code))
+            return false;
 
         VkShaderModuleCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = codeBytes.size() * sizeof(uint32_t);
-        createInfo.pCode = codeBytes.data();
+        createInfo.codeSize = code.size() * sizeof(uint32_t);
+        createInfo.pCode = code.data();
 
         if (vkCreateShaderModule(logical_device, &createInfo, allocation_callbacks, &shaderModule) != VK_SUCCESS)
         {
@@ -176,20 +362,34 @@ namespace Shaders
 
     // Uniforms
 
+    // Written once per frame into the uniform ring, bound through a dynamic offset
     struct TransfomMatrices
     {
-        float model[16] = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f};
         float view[16] = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f};
         float proj[16] = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f};
 
         static inline VkDescriptorSetLayoutBinding LayoutBinding()
         {
-            return {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
+            return {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
         }
     };
 
+    // Per draw data, recorded straight into the command buffer
+    struct DrawConstants
+    {
+        float model[16] = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f};
+
+        static inline VkPushConstantRange Range()
+        {
+            return {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawConstants)};
+        }
+    };
+    // 128 bytes is the smallest maxPushConstantsSize a device may report
+    static_assert(sizeof(DrawConstants) <= 128, "DrawConstants must fit the guaranteed push constant space");
+
     std::vector<VkDescriptorSetLayoutBinding> layout_bindings = {TransfomMatrices::LayoutBinding()};
-    std::vector<VkDescriptorPoolSize> pool_sizes = {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1}};
+    std::vector<VkDescriptorPoolSize> pool_sizes = {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1}};
+    std::vector<VkPushConstantRange> push_constant_ranges = {DrawConstants::Range()};
 }
 
 namespace ToString
@@ -724,6 +924,271 @@ namespace Populate
 
 } // namespace Populate
 
+struct MemoryAllocation
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    void* mapped = nullptr; // Host visible blocks stay mapped for their whole lifetime
+
+    uint32_t type = 0;
+    uint32_t block = 0;
+};
+
+struct MemoryStats
+{
+    uint32_t blocks = 0;      // Live vkAllocateMemory allocations
+    uint32_t allocations = 0; // Live sub-allocations
+    VkDeviceSize reserved = 0;
+    VkDeviceSize used = 0;
+};
+
+struct MemoryAllocator
+{
+    bool Create(VkDevice device, const VkPhysicalDeviceMemoryProperties& properties)
+    {
+        logical_device = device;
+        mem_properties = properties;
+        return true;
+    }
+
+    void Destroy()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& type_blocks : blocks)
+        {
+            for (auto& block : type_blocks)
+                FreeBlock(block);
+            type_blocks.clear();
+        }
+    }
+
+    bool Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                  MemoryAllocation& allocation, bool image = false)
+    {
+        uint32_t type;
+        if (!FindMemoryType(requirements.memoryTypeBits, properties, type))
+        {
+            std::cerr << "Failed to find suitable memory type!" << std::endl;
+            return false;
+        }
+
+        // Buffers and images never share a block, so bufferImageGranularity never applies
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& type_blocks = blocks[type];
+        for (uint32_t i = 0; i < type_blocks.size(); ++i)
+        {
+            Block& block = type_blocks[i];
+            if (block.memory == VK_NULL_HANDLE || block.image != image)
+                continue;
+
+            if (Suballocate(block, requirements.size, requirements.alignment, allocation.offset))
+                return Fill(allocation, block, type, i, requirements.size);
+        }
+
+        // No block had room, oversized resources get a dedicated one
+        uint32_t index = 0;
+        while (index < type_blocks.size() && type_blocks[index].memory != VK_NULL_HANDLE)
+            ++index;
+        if (index == type_blocks.size())
+            type_blocks.push_back({});
+
+        Block& block = type_blocks[index];
+        if (!CreateBlock(block, type, std::max(BlockSize(type), requirements.size), image))
+            return false;
+
+        Suballocate(block, requirements.size, requirements.alignment, allocation.offset);
+        return Fill(allocation, block, type, index, requirements.size);
+    }
+
+    void Free(MemoryAllocation& allocation)
+    {
+        if (allocation.memory == VK_NULL_HANDLE)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        Block& block = blocks[allocation.type][allocation.block];
+        block.used -= allocation.size;
+        block.live--;
+        Release(block, allocation.offset, allocation.size);
+
+        // Keep regular blocks around for reuse, give dedicated ones back
+        if (block.live == 0 && block.size > BlockSize(allocation.type))
+            FreeBlock(block);
+
+        allocation = {};
+    }
+
+    MemoryStats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        MemoryStats stats{};
+        for (const auto& type_blocks : blocks)
+            for (const auto& block : type_blocks)
+            {
+                if (block.memory == VK_NULL_HANDLE)
+                    continue;
+                stats.blocks++;
+                stats.allocations += block.live;
+                stats.reserved += block.size;
+                stats.used += block.used;
+            }
+        return stats;
+    }
+
+  private:
+
+    struct Range
+    {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    struct Block
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        VkDeviceSize used = 0;
+        uint32_t live = 0;
+        void* mapped = nullptr;
+
+        bool image = false;
+        std::vector<Range> free{}; // Sorted by offset, never adjacent
+    };
+
+    static VkDeviceSize Align(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+    }
+
+    bool FindMemoryType(uint32_t type_bits, VkMemoryPropertyFlags properties, uint32_t& type) const
+    {
+        for (uint32_t i = 0; i < mem_properties.memoryTypeCount; i++)
+        {
+            if ((type_bits & (1 << i)) && (mem_properties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                type = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    VkDeviceSize BlockSize(uint32_t type) const
+    {
+        // Small heaps (integrated GPUs' host visible windows) get proportionally smaller blocks
+        const VkDeviceSize heap_size = mem_properties.memoryHeaps[mem_properties.memoryTypes[type].heapIndex].size;
+        return std::min(Criteria::Prefered::memory_block_size, std::max<VkDeviceSize>(heap_size / 8, 1));
+    }
+
+    bool CreateBlock(Block& block, uint32_t type, VkDeviceSize size, bool image)
+    {
+        VkMemoryAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = size;
+        alloc_info.memoryTypeIndex = type;
+
+        if (vkAllocateMemory(logical_device, &alloc_info, allocation_callbacks, &block.memory) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to allocate device memory block!" << std::endl;
+            block = {};
+            return false;
+        }
+
+        if (mem_properties.memoryTypes[type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT &&
+            vkMapMemory(logical_device, block.memory, 0, VK_WHOLE_SIZE, 0, &block.mapped) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to map device memory block!" << std::endl;
+            vkFreeMemory(logical_device, block.memory, allocation_callbacks);
+            block = {};
+            return false;
+        }
+
+        block.size = size;
+        block.image = image;
+        block.free = {{0, size}};
+        return true;
+    }
+
+    void FreeBlock(Block& block)
+    {
+        if (block.memory == VK_NULL_HANDLE)
+            return;
+
+        if (block.mapped != nullptr)
+            vkUnmapMemory(logical_device, block.memory);
+        vkFreeMemory(logical_device, block.memory, allocation_callbacks);
+        block = {};
+    }
+
+    static bool Suballocate(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+    {
+        // First fit, the alignment padding stays free
+        for (size_t i = 0; i < block.free.size(); ++i)
+        {
+            Range& range = block.free[i];
+            offset = Align(range.offset, alignment);
+            const VkDeviceSize padding = offset - range.offset;
+            if (range.size < padding + size)
+                continue;
+
+            const Range tail = {offset + size, range.size - padding - size};
+            if (padding > 0)
+            {
+                range.size = padding;
+                if (tail.size > 0)
+                    block.free.insert(block.free.begin() + i + 1, tail);
+            }
+            else if (tail.size > 0)
+                range = tail;
+            else
+                block.free.erase(block.free.begin() + i);
+            return true;
+        }
+
+        return false;
+    }
+
+    static void Release(Block& block, VkDeviceSize offset, VkDeviceSize size)
+    {
+        auto next = std::lower_bound(block.free.begin(), block.free.end(), offset,
+                                     [](const Range& range, VkDeviceSize value) { return range.offset < value; });
+        next = block.free.insert(next, {offset, size});
+
+        // Coalesce with the following and preceding ranges
+        if (next + 1 != block.free.end() && next->offset + next->size == (next + 1)->offset)
+        {
+            next->size += (next + 1)->size;
+            block.free.erase(next + 1);
+        }
+        if (next != block.free.begin() && (next - 1)->offset + (next - 1)->size == next->offset)
+        {
+            (next - 1)->size += next->size;
+            block.free.erase(next);
+        }
+    }
+
+    bool Fill(MemoryAllocation& allocation, Block& block, uint32_t type, uint32_t index, VkDeviceSize size)
+    {
+        block.used += size;
+        block.live++;
+
+        allocation.memory = block.memory;
+        allocation.size = size;
+        allocation.mapped = block.mapped != nullptr ? static_cast<char*>(block.mapped) + allocation.offset : nullptr;
+        allocation.type = type;
+        allocation.block = index;
+        return true;
+    }
+
+  private:
+
+    VkDevice logical_device = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties mem_properties{};
+    std::vector<Block> blocks[VK_MAX_MEMORY_TYPES]{};
+    mutable std::mutex mutex;
+};
+
 struct LogicalDevice
 {
     VkDevice logical_device = VK_NULL_HANDLE;
@@ -742,25 +1207,36 @@ struct LogicalDevice
     uint32_t transfer_family = 0;
     uint32_t present_family = 0;
 
+    VkPhysicalDeviceProperties properties{};
     VkPhysicalDeviceMemoryProperties mem_properties;
+    MemoryAllocator allocator{};
+
+    // Created without a surface, nothing is presented so swapchain support isn't required
+    bool headless = false;
 
     bool Create(VkInstance instance, VkSurfaceKHR surface)
     {
+        headless = surface == VK_NULL_HANDLE;
         std::cout << "Finding suitable Vulkan Physical Devices." << std::endl;
         std::vector<VkPhysicalDevice> physical_devices{};
         if (!Populate::PhysicalDevices(instance, physical_devices))
             return false;
 
-        for (size_t i = 0; i < physical_devices.size(); ++i)
+        // Prefer discrete GPUs, fall back to any device (integrated, software rasterizers like lavapipe)
+        for (bool discrete_only : {true, false})
         {
-            physical_device = physical_devices[i];
-            if (HasValidType() && HasRequiredFeatures() && SupportsRequiredExtensions() &&
-                HasValidQueueFamiliesWithKHR(surface) && HasRequiredSurfaceFormat(surface) &&
-                HasRequiredPresentMode(surface) && CorrectCreation())
+            for (size_t i = 0; i < physical_devices.size(); ++i)
             {
-                std::cout << "Created Logical Device from suitable Vulkan Physical Device: " << i << std::endl;
-                vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
-                return true;
+                physical_device = physical_devices[i];
+                if (HasValidType(discrete_only) && HasRequiredFeatures() && SupportsRequiredExtensions() &&
+                    HasValidQueueFamiliesWithKHR(surface) && FindDedicatedTransferFamily() &&
+                    HasRequiredSurfaceFormat(surface) && HasRequiredPresentMode(surface) && CorrectCreation())
+                {
+                    std::cout << "Created Logical Device from suitable Vulkan Physical Device: " << i << std::endl;
+                    vkGetPhysicalDeviceProperties(physical_device, &properties);
+                    vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
+                    return allocator.Create(logical_device, mem_properties);
+                }
             }
         }
 
@@ -769,6 +1245,7 @@ struct LogicalDevice
     }
     void Delete()
     {
+        allocator.Destroy();
         if (logical_device != VK_NULL_HANDLE)
             vkDestroyDevice(logical_device, allocation_callbacks);
     }
@@ -780,6 +1257,21 @@ struct LogicalDevice
         return queue;
     }
 
+    VkQueue GetTransferQueue() const
+    {
+        VkQueue queue;
+        vkGetDeviceQueue(logical_device, transfer_family, 0, &queue);
+        return queue;
+    }
+
+    // Families that share buffers written by the transfer queue and read while rendering
+    std::vector<uint32_t> UploadFamilies() const
+    {
+        if (transfer_family == graphics_family)
+            return {};
+        return {graphics_family, transfer_family};
+    }
+
     bool HasRequiredFeatures()
     {
         VkPhysicalDeviceFeatures deviceFeatures;
@@ -797,13 +1289,21 @@ struct LogicalDevice
         return true;
     }
 
-    bool HasValidType()
+    bool HasValidType(bool discrete_only)
     {
+        if (!discrete_only)
+            return true;
+
         VkPhysicalDeviceProperties deviceProperties;
         vkGetPhysicalDeviceProperties(physical_device, &deviceProperties);
         return deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
     }
 
+    std::vector<const char*> RequiredExtensions() const
+    {
+        return headless ? std::vector<const char*>{} : Criteria::Required::extensions;
+    }
+
     bool SupportsRequiredExtensions()
     {
         uint32_t extensionCount;
@@ -811,7 +1311,7 @@ struct LogicalDevice
         std::vector<VkExtensionProperties> availableExtensions(extensionCount);
         vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extensionCount, availableExtensions.data());
 
-        for (const char* required : Criteria::Required::extensions)
+        for (const char* required : RequiredExtensions())
         {
             bool found = false;
             for (const auto& extension : availableExtensions)
@@ -846,9 +1346,10 @@ struct LogicalDevice
 
             bool has_graphics = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
             bool has_transfer = queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT;
-            VkBool32 present_support = false;
+            VkBool32 present_support = headless && has_graphics;
 
-            if (vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, family_index, surface, &present_support) !=
+            if (!headless &&
+                vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, family_index, surface, &present_support) !=
                 VK_SUCCESS)
             {
                 std::cerr << "Failed to retrieve Physical Device Surface KHR Support!" << std::endl;
@@ -914,12 +1415,37 @@ struct LogicalDevice
         queue_setup = SEPARATE;
         graphics_family = *graphics_families.begin();
         transfer_family = *transfer_families.begin();
-        transfer_family = *present_families.begin();
+        present_family = *present_families.begin();
+        return true;
+    }
+
+    bool FindDedicatedTransferFamily()
+    {
+        uint32_t queue_family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+        vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, queue_families.data());
+
+        // Transfer-only families map to DMA engines that copy alongside rendering
+        for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index)
+        {
+            const VkQueueFlags flags = queue_families[family_index].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) && !(flags & VK_QUEUE_COMPUTE_BIT))
+            {
+                transfer_family = family_index;
+                break;
+            }
+        }
+
+        // Always succeeds, the graphics family can transfer too
         return true;
     }
 
     bool HasRequiredSurfaceFormat(VkSurfaceKHR surface)
     {
+        if (headless)
+            return true;
+
         // Choose the surface format
         uint32_t formatCount;
         if (vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &formatCount, nullptr) != VK_SUCCESS)
@@ -948,6 +1474,9 @@ struct LogicalDevice
 
     bool HasRequiredPresentMode(VkSurfaceKHR surface)
     {
+        if (headless)
+            return true;
+
         uint32_t mode_count;
         if (vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &mode_count, nullptr) != VK_SUCCESS)
         {
@@ -975,22 +1504,29 @@ struct LogicalDevice
         VkDeviceCreateInfo deviceCreateInfo{};
         deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 
-        VkDeviceQueueCreateInfo queueCreateInfo{};
-        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-        queueCreateInfo.queueFamilyIndex = graphics_family;
-        queueCreateInfo.queueCount = 1;
+        // One queue per distinct family
         float queuePriority = 1.0f;
-        queueCreateInfo.pQueuePriorities = &queuePriority;
-        deviceCreateInfo.queueCreateInfoCount = 1;
-        deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+        std::vector<VkDeviceQueueCreateInfo> queueCreateInfos{};
+        for (uint32_t family : std::set<uint32_t>{graphics_family, present_family, transfer_family})
+        {
+            VkDeviceQueueCreateInfo queueCreateInfo{};
+            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueCreateInfo.queueFamilyIndex = family;
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = &queuePriority;
+            queueCreateInfos.push_back(queueCreateInfo);
+        }
+        deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+        deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
 
         // TODO: Physical Device Features 
         //VkPhysicalDeviceFeatures features;
         //vkGetPhysicalDeviceFeatures(physical_device, &features);
         //deviceCreateInfo.pEnabledFeatures = &features;
 
-        deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(Criteria::Required::extensions.size());
-        deviceCreateInfo.ppEnabledExtensionNames = Criteria::Required::extensions.data();
+        const std::vector<const char*> extensions = RequiredExtensions();
+        deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        deviceCreateInfo.ppEnabledExtensionNames = extensions.data();
 
         return vkCreateDevice(physical_device, &deviceCreateInfo, allocation_callbacks, &logical_device) == VK_SUCCESS;
     }
@@ -1123,7 +1659,6 @@ struct DynamicState
         STENCIL_REFERENCE = 1 << 9
     };
     uint16_t current_flags = 0;
-    uint16_t update_flags = 0;
     bool requires_recreation = false;
 
     void Setup(const VkExtent2D& extent, uint16_t flags = VIEWPORT | SCISSOR)
@@ -1179,7 +1714,6 @@ struct DynamicState
         if (current_flags & VIEWPORT && current_flags & SCISSOR)
         {
             pipelineInfo.pViewportState = nullptr;
-            update_flags |= VIEWPORT | SCISSOR;
         }
         else
         {
@@ -1227,7 +1761,6 @@ struct DynamicState
             return;
 
         viewport = next_viewport;
-        update_flags |= VIEWPORT;
         bool has_dyn_viewport = current_flags & VIEWPORT;
         requires_recreation |= !has_dyn_viewport;
     }
@@ -1241,24 +1774,23 @@ struct DynamicState
             return;
 
         scissor = next_scissor;
-        update_flags |= SCISSOR;
         bool has_dyn_scissor = current_flags & SCISSOR;
         requires_recreation |= !has_dyn_scissor;
     }
 
-    void Update(VkCommandBuffer commandBuffer)
-    {
-        if (update_flags == 0) return;
-        if (update_flags & VIEWPORT) vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-        if (update_flags & SCISSOR) vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-        if (update_flags & LINE_WIDTH) vkCmdSetLineWidth(commandBuffer, line_width);
-        if (update_flags & DEPTH_BIAS) vkCmdSetDepthBias(commandBuffer, depth_bias[0], depth_bias[1], depth_bias[2]);
-        if (update_flags & BLEND_CONSTANTS) vkCmdSetBlendConstants(commandBuffer, blend_constants);
-        if (update_flags & DEPTH_BOUNDS) vkCmdSetDepthBounds(commandBuffer, depth_bounds[0], depth_bounds[1]);
-        if (update_flags & STENCIL_COMPARE_MASK) vkCmdSetStencilCompareMask(commandBuffer, compare.face_mask, compare.mask);
-        if (update_flags & STENCIL_WRITE_MASK) vkCmdSetStencilWriteMask(commandBuffer, write.face_mask, write.mask);
-        if (update_flags & STENCIL_REFERENCE) vkCmdSetStencilReference(commandBuffer, reference.face_mask, reference.mask);
-        update_flags = 0;
+    // Command buffers start without dynamic state, primaries re-recorded each frame and secondaries alike,
+    // so every recording sets all of the pipeline's dynamic states
+    void Update(VkCommandBuffer commandBuffer) const
+    {
+        if (current_flags & VIEWPORT) vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        if (current_flags & SCISSOR) vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        if (current_flags & LINE_WIDTH) vkCmdSetLineWidth(commandBuffer, line_width);
+        if (current_flags & DEPTH_BIAS) vkCmdSetDepthBias(commandBuffer, depth_bias[0], depth_bias[1], depth_bias[2]);
+        if (current_flags & BLEND_CONSTANTS) vkCmdSetBlendConstants(commandBuffer, blend_constants);
+        if (current_flags & DEPTH_BOUNDS) vkCmdSetDepthBounds(commandBuffer, depth_bounds[0], depth_bounds[1]);
+        if (current_flags & STENCIL_COMPARE_MASK) vkCmdSetStencilCompareMask(commandBuffer, compare.face_mask, compare.mask);
+        if (current_flags & STENCIL_WRITE_MASK) vkCmdSetStencilWriteMask(commandBuffer, write.face_mask, write.mask);
+        if (current_flags & STENCIL_REFERENCE) vkCmdSetStencilReference(commandBuffer, reference.face_mask, reference.mask);
     }
 };
 
@@ -1266,50 +1798,24 @@ struct Buffer
 {
     uint32_t count = 0;
     VkBuffer buffer = VK_NULL_HANDLE;
-    VkDeviceMemory memory = VK_NULL_HANDLE;
+    MemoryAllocation allocation{};
 
-    template <typename T>
-    bool CreateFromStagedCopy(VkDevice logical_device, VkQueue queue,
-                              const VkPhysicalDeviceMemoryProperties& mem_properties, VkCommandPool commandPool,
-                              VkBufferUsageFlagBits usage_flags, const std::vector<T>& vector,
-                              VkDeviceSize element_size)
+    bool Create(VkDevice device, MemoryAllocator& allocator, VkDeviceSize size, VkBufferUsageFlags usage,
+                VkMemoryPropertyFlags properties, const std::vector<uint32_t>& families = {})
     {
-        count = static_cast<uint32_t>(vector.size());
-        VkDeviceSize buffer_size = element_size * count;
-        Buffer staging_buffer;
-        if (!staging_buffer.Create(logical_device, mem_properties, buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        VkBufferCreateInfo buffer_info{};
+        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_info.size = size;
+        buffer_info.usage = usage;
+        if (families.size() > 1)
         {
-            std::cerr << "Failed to create Staging Buffer." << std::endl;
-            return false;
+            // Written by the transfer queue, read by the graphics queue
+            buffer_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            buffer_info.queueFamilyIndexCount = static_cast<uint32_t>(families.size());
+            buffer_info.pQueueFamilyIndices = families.data();
         }
-
-        if (!staging_buffer.FillData(logical_device, vector.data(), buffer_size))
-        {
-            std::cerr << "Failed to copy data to Staging Buffer." << std::endl;
-            return false;
-        }
-        if (!Create(logical_device, mem_properties, buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage_flags,
-                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
-        {
-            std::cerr << "Failed to create new Buffer." << std::endl;
-            return false;
-        }
-        if (!staging_buffer.CopyTo(logical_device, buffer, buffer_size, queue, commandPool))
-            return false;
-
-        staging_buffer.Clear(logical_device);
-        return true;
-    }
-
-    bool Create(VkDevice device, const VkPhysicalDeviceMemoryProperties& mem_properties, VkDeviceSize size,
-                VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
-    {
-        VkBufferCreateInfo buffer_info{};
-        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        buffer_info.size = size;
-        buffer_info.usage = usage;
-        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        else
+            buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
         if (vkCreateBuffer(device, &buffer_info, nullptr, &buffer) != VK_SUCCESS)
         {
@@ -1320,34 +1826,13 @@ struct Buffer
         VkMemoryRequirements mem_requirements;
         vkGetBufferMemoryRequirements(device, buffer, &mem_requirements);
 
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_requirements.size;
-
-        bool found_valid_mem_type = false;
-        for (uint32_t i = 0; i < mem_properties.memoryTypeCount; i++)
-        {
-            if ((mem_requirements.memoryTypeBits & (1 << i)) &&
-                (mem_properties.memoryTypes[i].propertyFlags & properties) == properties)
-            {
-                found_valid_mem_type = true;
-                alloc_info.memoryTypeIndex = i;
-                break;
-            }
-        }
-        if (!found_valid_mem_type)
-        {
-            std::cerr << "Failed to find suitable memory type!" << std::endl;
-            return false;
-        }
-
-        if (vkAllocateMemory(device, &alloc_info, nullptr, &memory) != VK_SUCCESS)
+        if (!allocator.Allocate(mem_requirements, properties, allocation))
         {
             std::cerr << "Failed to allocate buffer memory!" << std::endl;
             return false;
         }
 
-        if (vkBindBufferMemory(device, buffer, memory, 0) != VK_SUCCESS)
+        if (vkBindBufferMemory(device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS)
         {
             std::cerr << "Failed to bind buffer memory!" << std::endl;
             return false;
@@ -1356,18 +1841,19 @@ struct Buffer
         return true;
     }
 
-    void Clear(VkDevice logical_device)
+    void Clear(VkDevice logical_device, MemoryAllocator& allocator)
     {
         if (buffer != VK_NULL_HANDLE)
             vkDestroyBuffer(logical_device, buffer, allocation_callbacks);
+        buffer = VK_NULL_HANDLE;
 
-        if (memory != VK_NULL_HANDLE)
-            vkFreeMemory(logical_device, memory, allocation_callbacks);
+        allocator.Free(allocation);
     }
 
     bool CreateDescriptorSet(VkDevice logical_device, VkDescriptorPool& descriptorPool,
                              VkDescriptorSetLayout& descriptorSetLayout, VkDeviceSize size,
-                             VkDescriptorSet& descriptorSet)
+                             VkDescriptorSet& descriptorSet,
+                             VkDescriptorType type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
     {
         // Create Descriptor Set
         VkDescriptorSetAllocateInfo allocInfo{};
@@ -1389,7 +1875,7 @@ struct Buffer
         descriptorWrite.dstSet = descriptorSet;
         descriptorWrite.dstBinding = 0;
         descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrite.descriptorType = type;
         descriptorWrite.descriptorCount = 1;
         descriptorWrite.pBufferInfo = &bufferInfo;
         vkUpdateDescriptorSets(logical_device, 1, &descriptorWrite, 0, nullptr);
@@ -1398,72 +1884,303 @@ struct Buffer
 
     bool FillData(VkDevice device, const void* source, VkDeviceSize size) const
     {
-        void* tmp;
-        if (vkMapMemory(device, memory, 0, size, 0, &tmp) != VK_SUCCESS)
+        if (allocation.mapped == nullptr || size > allocation.size)
         {
             std::cerr << "Failed to map buffer data for copy operation." << std::endl;
             return false;
         }
-        memcpy(tmp, source, static_cast<size_t>(size));
-        vkUnmapMemory(device, memory);
+        memcpy(allocation.mapped, source, static_cast<size_t>(size));
         return true;
     }
+};
 
-    bool CopyTo(VkDevice device, VkBuffer dst_buffer, VkDeviceSize size, VkQueue queue, VkCommandPool commandPool) const
+struct UploadBatcher
+{
+    // Records staged copies into shared command buffers instead of one submission and queue idle per copy.
+    // Data is written into a persistently mapped ring, each submitted batch holds its part of the ring
+    // until its fence signals. Call Finish() before rendering with freshly uploaded buffers.
+
+    static constexpr uint32_t max_batches = 4;
+    static constexpr VkDeviceSize copy_alignment = 16;
+
+    bool Create(LogicalDevice& device, VkDeviceSize size)
     {
-        VkCommandBufferAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        alloc_info.commandPool = commandPool;
-        alloc_info.commandBufferCount = 1;
+        logical_device = device.logical_device;
+        queue = device.GetTransferQueue();
+        capacity = size;
 
-        VkCommandBuffer command_buffer;
-        if (vkAllocateCommandBuffers(device, &alloc_info, &command_buffer) != VK_SUCCESS)
+        if (!ring.Create(logical_device, device.allocator, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
         {
-            std::cerr << "Failed to allocate command buffer in Buffer::CopyTo(...)." << std::endl;
+            std::cerr << "Failed to create Staging Ring." << std::endl;
             return false;
         }
 
-        VkCommandBufferBeginInfo begin_info{};
-        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = device.transfer_family;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        if (vkCreateCommandPool(logical_device, &poolInfo, allocation_callbacks, &commandPool) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to create Upload Command Pool!" << std::endl;
+            return false;
+        }
 
-        if (vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS)
+        VkCommandBuffer commandBuffers[max_batches];
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = max_batches;
+        if (vkAllocateCommandBuffers(logical_device, &allocInfo, commandBuffers) != VK_SUCCESS)
         {
-            std::cerr << "Failed to begin command buffer in Buffer::CopyTo(...)." << std::endl;
+            std::cerr << "Failed to allocate Upload Command Buffers!" << std::endl;
             return false;
         }
 
-        VkBufferCopy copy_region{};
-        copy_region.size = size;
-        vkCmdCopyBuffer(command_buffer, buffer, dst_buffer, 1, &copy_region);
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        for (uint32_t i = 0; i < max_batches; ++i)
+        {
+            batches[i].commandBuffer = commandBuffers[i];
+            if (vkCreateFence(logical_device, &fenceInfo, allocation_callbacks, &batches[i].fence) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to create Upload Fence!" << std::endl;
+                return false;
+            }
+            idle.push_back(i);
+        }
 
-        if (vkEndCommandBuffer(command_buffer) != VK_SUCCESS)
+        return true;
+    }
+
+    void Destroy(LogicalDevice& device)
+    {
+        if (logical_device == VK_NULL_HANDLE)
+            return;
+
+        Finish();
+        for (auto& batch : batches)
+            if (batch.fence != VK_NULL_HANDLE)
+                vkDestroyFence(logical_device, batch.fence, allocation_callbacks);
+        if (commandPool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(logical_device, commandPool, allocation_callbacks);
+
+        ring.Clear(logical_device, device.allocator);
+        *this = {};
+    }
+
+    bool Upload(VkBuffer dst_buffer, const void* data, VkDeviceSize size, VkDeviceSize dst_offset = 0)
+    {
+        // Big uploads go through in pieces so they never need the whole ring at once
+        const char* source = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            const VkDeviceSize chunk = std::min(size, capacity / 4);
+
+            VkDeviceSize offset;
+            if (!Reserve(chunk, offset) || !BeginBatch(offset))
+                return false;
+
+            memcpy(static_cast<char*>(ring.allocation.mapped) + offset, source, static_cast<size_t>(chunk));
+            VkBufferCopy region = {offset, dst_offset, chunk};
+            Batch& batch = batches[recording];
+            vkCmdCopyBuffer(batch.commandBuffer, ring.buffer, dst_buffer, 1, &region);
+            batch.copies++;
+            head = offset + chunk;
+
+            source += chunk;
+            dst_offset += chunk;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool CreateBuffer(LogicalDevice& device, Buffer& out, VkBufferUsageFlags usage, const std::vector<T>& vector)
+    {
+        out.count = static_cast<uint32_t>(vector.size());
+        VkDeviceSize buffer_size = sizeof(T) * vector.size();
+        if (!out.Create(logical_device, device.allocator, buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, device.UploadFamilies()))
         {
-            std::cerr << "Failed to end command buffer in Buffer::CopyTo(...)." << std::endl;
+            std::cerr << "Failed to create new Buffer." << std::endl;
             return false;
         }
 
-        VkSubmitInfo submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.commandBufferCount = 1;
-        submit_info.pCommandBuffers = &command_buffer;
+        return Upload(out.buffer, vector.data(), buffer_size);
+    }
+
+    // Submits the batch being recorded without waiting for it
+    bool Flush()
+    {
+        if (recording == none)
+            return true;
 
-        if (vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE) != VK_SUCCESS)
+        Batch& batch = batches[recording];
+        if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS)
         {
-            std::cerr << "Failed to submit command buffer to queue in Buffer::CopyTo(...)." << std::endl;
+            std::cerr << "Failed to end Upload Command Buffer." << std::endl;
             return false;
         }
 
-        if (vkQueueWaitIdle(queue) != VK_SUCCESS)
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &batch.commandBuffer;
+        if (vkQueueSubmit(queue, 1, &submitInfo, batch.fence) != VK_SUCCESS)
         {
-            std::cerr << "Failed to wait for idle queue in Buffer::CopyTo(...)." << std::endl;
+            std::cerr << "Failed to submit Upload Command Buffer." << std::endl;
             return false;
         }
 
-        vkFreeCommandBuffers(device, commandPool, 1, &command_buffer);
+        in_flight.push_back(recording);
+        recording = none;
+        return true;
+    }
+
+    // Submits pending copies and waits until every upload has landed
+    bool Finish()
+    {
+        if (!Flush())
+            return false;
+        while (!in_flight.empty())
+            if (!RetireOldest())
+                return false;
+        head = 0;
+        return true;
+    }
+
+  private:
+
+    struct Batch
+    {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkDeviceSize begin = 0; // Start of the batch's ring range
+        uint32_t copies = 0;
+    };
+
+    static constexpr uint32_t none = UINT32_MAX;
+
+    static VkDeviceSize Align(VkDeviceSize value)
+    {
+        return (value + copy_alignment - 1) / copy_alignment * copy_alignment;
+    }
+
+    bool InUse() const
+    {
+        return recording != none || !in_flight.empty();
+    }
+
+    VkDeviceSize Tail() const
+    {
+        return !in_flight.empty() ? batches[in_flight.front()].begin : batches[recording].begin;
+    }
+
+    bool Reserve(VkDeviceSize size, VkDeviceSize& offset)
+    {
+        for (;;)
+        {
+            if (!InUse())
+            {
+                head = 0;
+                offset = 0;
+                return true;
+            }
+
+            // The live range runs from the oldest batch's begin to head, possibly wrapping around.
+            // Wrapped space must stay strictly below the tail so head never catches up with it.
+            const VkDeviceSize tail = Tail();
+            const VkDeviceSize aligned = Align(head);
+            if (head >= tail)
+            {
+                if (aligned + size <= capacity)
+                {
+                    offset = aligned;
+                    return true;
+                }
+                if (size < tail)
+                {
+                    offset = 0;
+                    return true;
+                }
+            }
+            else if (aligned + size < tail)
+            {
+                offset = aligned;
+                return true;
+            }
+
+            // Ring full: submit what's recorded and reclaim the oldest batch's range
+            if (!Flush() || !RetireOldest())
+                return false;
+        }
+    }
+
+    bool BeginBatch(VkDeviceSize offset)
+    {
+        if (recording != none)
+            return true;
+
+        if (idle.empty() && !RetireOldest())
+            return false;
+
+        recording = idle.back();
+        idle.pop_back();
+
+        Batch& batch = batches[recording];
+        batch.begin = offset;
+        batch.copies = 0;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkResetCommandBuffer(batch.commandBuffer, 0) != VK_SUCCESS ||
+            vkBeginCommandBuffer(batch.commandBuffer, &beginInfo) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to begin Upload Command Buffer." << std::endl;
+            return false;
+        }
         return true;
     }
+
+    bool RetireOldest()
+    {
+        if (in_flight.empty())
+        {
+            std::cerr << "Staging Ring has no submitted uploads to reclaim." << std::endl;
+            return false;
+        }
+
+        const uint32_t oldest = in_flight.front();
+        Batch& batch = batches[oldest];
+        if (vkWaitForFences(logical_device, 1, &batch.fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS ||
+            vkResetFences(logical_device, 1, &batch.fence) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to wait for Upload Fence." << std::endl;
+            return false;
+        }
+
+        in_flight.pop_front();
+        idle.push_back(oldest);
+        return true;
+    }
+
+  private:
+
+    VkDevice logical_device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+
+    Buffer ring{};
+    VkDeviceSize capacity = 0;
+    VkDeviceSize head = 0;
+
+    Batch batches[max_batches]{};
+    uint32_t recording = none;
+    std::deque<uint32_t> in_flight{};
+    std::vector<uint32_t> idle{};
 };
 
 struct ModelData
@@ -1472,116 +2189,486 @@ struct ModelData
     Buffer index{};
     VkDeviceSize offset = 0;
 
-    std::vector<Buffer> uniforms{};
-    std::vector<VkDescriptorSet> descriptor_sets{};
+    Shaders::DrawConstants constants{};
+
+    bool Create(LogicalDevice& device, UploadBatcher& uploader, const std::vector<Shaders::Vertex>& vertices,
+                const std::vector<uint32_t>& indices)
+    {
+        if (!uploader.CreateBuffer(device, vertex, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertices))
+        {
+            std::cerr << "Failed to create vertex buffer!" << std::endl;
+            return false;
+        }
+        if (!uploader.CreateBuffer(device, index, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indices))
+        {
+            std::cerr << "Failed to create index buffer!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void Destroy(LogicalDevice& device)
+    {
+        vertex.Clear(device.logical_device, device.allocator);
+        index.Clear(device.logical_device, device.allocator);
+    }
+};
+
+struct UniformRing
+{
+    // Persistently mapped uniform buffer with one slice per frame in flight. Writes bump an offset
+    // through the current frame's slice and are bound with a dynamic offset into a single descriptor
+    // set, so per draw uniforms cost a memcpy instead of a buffer and descriptor set per object.
+
+    Buffer buffer{};
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+
+    bool Create(LogicalDevice& device, VkDescriptorPool& descriptorPool, VkDescriptorSetLayout& descriptorSetLayout,
+                VkDeviceSize size, VkDeviceSize range)
+    {
+        alignment = std::max<VkDeviceSize>(device.properties.limits.minUniformBufferOffsetAlignment, 1);
+        frame_size = Align(size);
+        block_range = range;
+
+        if (!buffer.Create(device.logical_device, device.allocator, frame_size * Criteria::Prefered::frames_in_flight,
+                           VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) ||
+            buffer.allocation.mapped == nullptr)
+        {
+            std::cerr << "Failed to create Uniform Ring!" << std::endl;
+            return false;
+        }
+
+        if (!buffer.CreateDescriptorSet(device.logical_device, descriptorPool, descriptorSetLayout, range,
+                                        descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC))
+        {
+            std::cerr << "Failed to create Uniform Ring Descriptor Set!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void Destroy(LogicalDevice& device)
+    {
+        // The descriptor set is released along with its pool
+        buffer.Clear(device.logical_device, device.allocator);
+        *this = {};
+    }
+
+    // Only once the frame's fence has signaled, the GPU may still read its slice until then
+    void BeginFrame(uint32_t frame)
+    {
+        begin = frame * frame_size;
+        head = begin;
+    }
+
+    bool Push(const void* data, VkDeviceSize size, uint32_t& dynamic_offset)
+    {
+        if (size > block_range || head + size > begin + frame_size)
+        {
+            std::cerr << "Uniform Ring out of space for " << size << " bytes!" << std::endl;
+            return false;
+        }
+
+        memcpy(static_cast<char*>(buffer.allocation.mapped) + head, data, static_cast<size_t>(size));
+        dynamic_offset = static_cast<uint32_t>(head);
+        head = Align(head + size);
+        return true;
+    }
+
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t dynamic_offset) const
+    {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptor_set,
+                                1, &dynamic_offset);
+    }
+
+  private:
+
+    VkDeviceSize Align(VkDeviceSize value) const
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+  private:
+
+    VkDeviceSize alignment = 1;
+    VkDeviceSize frame_size = 0;
+    VkDeviceSize block_range = 0;
+    VkDeviceSize begin = 0;
+    VkDeviceSize head = 0;
+};
+
+struct PipelineCache
+{
+    // Compiled pipeline state kept between runs, so launches and swapchain recreations skip most shader
+    // compilation. The file starts with the device and driver it was built with, a cache from any other
+    // device or driver version is discarded instead of handed to the driver.
+
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    std::string filepath{};
+
+    // Pipelines built through the cache, with the time spent in vkCreateGraphicsPipelines
+    uint32_t builds = 0;
+    double build_ms = 0.0;
+
+    bool Create(const LogicalDevice& device, const std::string& path)
+    {
+        logical_device = device.logical_device;
+        filepath = path;
+        FillHeader(device.properties);
+
+        std::string file{};
+        const bool loaded = !filepath.empty() && RE::FileSystem::ReadNative(filepath.c_str(), file) && IsValid(file);
+        if (!loaded && !file.empty())
+            std::cout << "Discarding Pipeline Cache built for another device or driver." << std::endl;
+
+        VkPipelineCacheCreateInfo cacheInfo{};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        if (loaded)
+        {
+            cacheInfo.initialDataSize = file.size() - sizeof(Header);
+            cacheInfo.pInitialData = file.data() + sizeof(Header);
+        }
+
+        if (vkCreatePipelineCache(logical_device, &cacheInfo, allocation_callbacks, &cache) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to create Pipeline Cache!" << std::endl;
+            return false;
+        }
+
+        std::cout << (loaded ? "Loaded " : "Created empty ") << "Pipeline Cache." << std::endl;
+        return true;
+    }
+
+    void Destroy()
+    {
+        if (cache == VK_NULL_HANDLE)
+            return;
+
+        Save();
+        vkDestroyPipelineCache(logical_device, cache, allocation_callbacks);
+        cache = VK_NULL_HANDLE;
+    }
+
+    bool Save()
+    {
+        if (cache == VK_NULL_HANDLE || filepath.empty())
+            return false;
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(logical_device, cache, &size, nullptr) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to get Pipeline Cache size!" << std::endl;
+            return false;
+        }
+
+        std::string file(sizeof(Header) + size, '\0');
+        if (vkGetPipelineCacheData(logical_device, cache, &size, file.data() + sizeof(Header)) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to get Pipeline Cache data!" << std::endl;
+            return false;
+        }
+
+        header.data_size = size;
+        memcpy(file.data(), &header, sizeof(Header));
+        if (!RE::FileSystem::WriteNative(filepath.c_str(), file.data(), sizeof(Header) + size))
+        {
+            std::cerr << "Failed to save Pipeline Cache to " << filepath << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool CreateGraphicsPipeline(const VkGraphicsPipelineCreateInfo& pipelineInfo, VkPipeline& pipeline)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const bool success = vkCreateGraphicsPipelines(logical_device, cache, 1, &pipelineInfo, allocation_callbacks,
+                                                       &pipeline) == VK_SUCCESS;
+
+        builds++;
+        build_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return success;
+    }
+
+  private:
+
+    struct Header
+    {
+        uint32_t magic = 0;
+        uint32_t vendor_id = 0;
+        uint32_t device_id = 0;
+        uint32_t driver_version = 0;
+        uint8_t uuid[VK_UUID_SIZE]{};
+        uint64_t data_size = 0;
+    };
+
+    static constexpr uint32_t magic = 0x50434552; // "REPC"
+
+    void FillHeader(const VkPhysicalDeviceProperties& properties)
+    {
+        header = {};
+        header.magic = magic;
+        header.vendor_id = properties.vendorID;
+        header.device_id = properties.deviceID;
+        header.driver_version = properties.driverVersion;
+        memcpy(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    }
+
+    bool IsValid(const std::string& file) const
+    {
+        if (file.size() < sizeof(Header))
+            return false;
+
+        Header stored{};
+        memcpy(&stored, file.data(), sizeof(Header));
+        return stored.magic == header.magic && stored.vendor_id == header.vendor_id &&
+               stored.device_id == header.device_id && stored.driver_version == header.driver_version &&
+               memcmp(stored.uuid, header.uuid, VK_UUID_SIZE) == 0 &&
+               stored.data_size == file.size() - sizeof(Header);
+    }
+
+  private:
+
+    VkDevice logical_device = VK_NULL_HANDLE;
+    Header header{};
+};
+
+struct RecordWorkers
+{
+    // Persistent threads recording secondary command buffers. Command pools can't be used from two
+    // threads at once, so each worker owns one, with a secondary buffer per frame in flight.
+
+    bool Create(VkDevice device, uint32_t family, uint32_t count)
+    {
+        logical_device = device;
+        workers.resize(count);
+        for (auto& worker : workers)
+        {
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.queueFamilyIndex = family;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            if (vkCreateCommandPool(logical_device, &poolInfo, allocation_callbacks, &worker.commandPool) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to create Recording Command Pool!" << std::endl;
+                return false;
+            }
+
+            worker.commandBuffers.resize(Criteria::Prefered::frames_in_flight);
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = worker.commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = static_cast<uint32_t>(worker.commandBuffers.size());
+            if (vkAllocateCommandBuffers(logical_device, &allocInfo, worker.commandBuffers.data()) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to allocate Secondary Command Buffers!" << std::endl;
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+            threads.emplace_back(&RecordWorkers::Loop, this, i);
 
-    bool Create(const LogicalDevice& device, VkCommandPool commandPool, VkDescriptorPool& descriptorPool,
-                VkDescriptorSetLayout& descriptorSetLayout, const std::vector<Shaders::Vertex>& vertices,
-                const std::vector<uint32_t>& indices)
+        std::cout << "Recording with " << count << " threads." << std::endl;
+        return true;
+    }
+
+    void Destroy()
     {
-        VkQueue queue = device.GetGraphicsQueue();
-        if (!vertex.CreateFromStagedCopy(device.logical_device, queue, device.mem_properties, commandPool,
-                                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertices, sizeof(vertices[0])))
-        {
-            std::cerr << "Failed to create vertex buffer!" << std::endl;
-            return false;
-        }
-        if (!index.CreateFromStagedCopy(device.logical_device, queue, device.mem_properties, commandPool,
-                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indices, sizeof(indices[0])))
         {
-            std::cerr << "Failed to create index buffer!" << std::endl;
-            return false;
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
         }
+        wake.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+        threads.clear();
 
-        VkDeviceSize size = sizeof(Shaders::TransfomMatrices);
-        uniforms.push_back({});
-        if (!uniforms[0].Create(device.logical_device, device.mem_properties, size,
-                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
-        {
-            std::cerr << "Failed to create <TransfomMatrices> Uniform Buffer!" << std::endl;
-            return false;
-        }
+        // Destroying the pools frees their command buffers
+        for (auto& worker : workers)
+            if (worker.commandPool != VK_NULL_HANDLE)
+                vkDestroyCommandPool(logical_device, worker.commandPool, allocation_callbacks);
+        workers.clear();
+    }
 
-        descriptor_sets.push_back({});
-        if (!uniforms[0].CreateDescriptorSet(device.logical_device, descriptorPool, descriptorSetLayout, size,
-                                             descriptor_sets[0]))
-        {
-            std::cerr << "Failed to create <TransfomMatrices> Descriptor Set!" << std::endl;
-            return false;
-        }
+    uint32_t Count() const
+    {
+        return static_cast<uint32_t>(workers.size());
+    }
 
-        return true;
+    VkCommandBuffer CommandBuffer(uint32_t worker, uint32_t frame) const
+    {
+        return workers[worker].commandBuffers[frame];
     }
 
-    void Destroy(VkDevice logical_device)
+    // Runs task(worker) on the first count workers, returns once all of them are done
+    void Run(uint32_t count, const std::function<void(uint32_t)>& next_task)
     {
-        vertex.Clear(logical_device);
-        index.Clear(logical_device);
+        std::unique_lock<std::mutex> lock(mutex);
+        task = &next_task;
+        active = std::min(count, Count());
+        pending = active;
+        generation++;
+        wake.notify_all();
 
-        for (auto& uniform : uniforms)
-            uniform.Clear(logical_device);
+        done.wait(lock, [this]() { return pending == 0; });
+        task = nullptr;
     }
 
-    bool UpdateAndBindUniformBuffers(VkDevice logical_device, const std::vector<std::pair<void*, VkDeviceSize>>& uniform_data,
-                                     VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) const
+  private:
+
+    void Loop(uint32_t index)
     {
-        const auto count = uniforms.size();
-        if (count != uniform_data.size())
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
         {
-            std::cerr << "Error: Supplied " << uniform_data.size() << "/" << count << " uniforms for model!" << std::endl;
-            return false;
-        }
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping)
+                return;
 
-        // Update Uniforms' Data
-        for (int i = 0; i < count; i++)
-        {
-            const auto& data = uniform_data[i];
-            if (!uniforms[i].FillData(logical_device, data.first, data.second))
-                return false;
+            seen = generation;
+            if (index >= active)
+                continue;
+
+            const auto* current = task;
+            lock.unlock();
+            (*current)(index);
+            lock.lock();
+
+            if (--pending == 0)
+                done.notify_one();
         }
+    }
 
-        // Bind Uniforms' Descriptor Sets
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
-                                static_cast<uint32_t>(descriptor_sets.size()), descriptor_sets.data(), 0, nullptr);
+  private:
 
-        return true;
+    struct Worker
+    {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> commandBuffers{};
+    };
+
+    VkDevice logical_device = VK_NULL_HANDLE;
+    std::vector<Worker> workers{};
+    std::vector<std::thread> threads{};
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(uint32_t)>* task = nullptr;
+    uint64_t generation = 0;
+    uint32_t active = 0;
+    uint32_t pending = 0;
+    bool stopping = false;
+};
+
+struct FrameStats
+{
+    uint64_t frames = 0;
+    double cpu_ms = 0.0;      // Recording, submission and presentation
+    double record_ms = 0.0;   // Recording draws, part of cpu_ms
+    double gpu_wait_ms = 0.0; // Blocked on the fence of a frame still in flight
+    std::vector<double> frame_ms{}; // Per frame wall time, only kept up to the capacity given to Reset
+
+    void Add(double wait_ms, double frame_cpu_ms, double frame_record_ms)
+    {
+        frames++;
+        gpu_wait_ms += wait_ms;
+        cpu_ms += frame_cpu_ms;
+        record_ms += frame_record_ms;
+        if (frame_ms.size() < frame_ms.capacity())
+            frame_ms.push_back(wait_ms + frame_cpu_ms);
+    }
+
+    double AverageCpuMs() const
+    {
+        return frames > 0 ? cpu_ms / frames : 0.0;
+    }
+    double AverageRecordMs() const
+    {
+        return frames > 0 ? record_ms / frames : 0.0;
     }
+    double AverageGpuWaitMs() const
+    {
+        return frames > 0 ? gpu_wait_ms / frames : 0.0;
+    }
+    // p in [0, 1], nearest rank over the kept samples
+    double PercentileMs(double p) const
+    {
+        if (frame_ms.empty())
+            return 0.0;
+
+        std::vector<double> sorted = frame_ms;
+        const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        const size_t index = std::min(rank > 0 ? rank - 1 : 0, sorted.size() - 1);
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+    void Reset(size_t sample_capacity = 0)
+    {
+        *this = {};
+        frame_ms.reserve(sample_capacity);
+    }
+};
+
+struct Frame
+{
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
+    VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
+    VkFence inFlightFence = VK_NULL_HANDLE; // Signaled once the GPU is done with the frame's submission
 };
 
 struct GraphicPipeline
 {
     VkDevice logical_device = VK_NULL_HANDLE;
     VkPipeline graphicsPipeline = VK_NULL_HANDLE;
+    PipelineCache* pipeline_cache = nullptr;
 
     // State
     VkClearColorValue clear_color = {0.f, 0.f, 0.f, 1.f};
     DynamicState dynamic_state{};
 
-    // Swapchain
+    // Render Targets
+    VkExtent2D extent{};
     Swapchain swapchain{};
     std::vector<VkImage> images{};
     std::vector<VkImageView> image_views{};  // Image views for swapchain images.
     std::vector<VkFramebuffer> framebuffers{}; // Framebuffers for swapchain images.
 
+    // Headless: one off-screen image per frame in flight instead of a surface and swapchain
+    bool headless = false;
+    bool readback = false; // Copy every frame into a host visible buffer
+    std::vector<MemoryAllocation> image_allocations{};
+    std::vector<Buffer> readback_buffers{};
+    uint32_t last_frame = UINT32_MAX;
+
     // Commands
+    uint32_t graphics_family = 0;
     VkCommandPool commandPool = VK_NULL_HANDLE;
-    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    std::unique_ptr<RecordWorkers> recorders{}; // Set to record draws in secondary command buffers
 
-    // Semaphores
-    VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
-    VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
+    // Frames in flight
+    std::vector<Frame> frames{};
+    uint32_t current_frame = 0;
+    FrameStats stats{};
 
     VkRenderPass renderPass = VK_NULL_HANDLE; // Describes rendering operations.
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE; // Manages shaders and resources.
 
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    UniformRing uniforms{};
 
     // Graphic Pipeline Creation
 
-    bool Create(LogicalDevice& device, VkSurfaceKHR surface, VkSurfaceCapabilitiesKHR& surface_capabilities,
-                const VkExtent2D& window_size)
+    bool Create(LogicalDevice& device, PipelineCache& cache, VkSurfaceKHR surface,
+                VkSurfaceCapabilitiesKHR& surface_capabilities, const VkExtent2D& window_size)
     {
         if (!swapchain.Create(device, surface, surface_capabilities, window_size))
         {
@@ -1590,27 +2677,32 @@ struct GraphicPipeline
         }
 
         logical_device = device.logical_device;
-        dynamic_state.Setup(swapchain.extent);
-
-        if (!RetrieveImages() ||
-            !CreateCommandPool(device.graphics_family) ||
-            !CreateCommandBuffer() ||
-            !CreateSemaphores() ||
-            !CreateRenderPass() ||
-            !CreateDescriptorSetLayout() ||
-            !CreatePipelineLayout() ||
-            !CreateGraphicsPipeline())
-        {
-            std::cerr << "Failed to create Graphic Pipeline." << std::endl;
-            return false;
-        }
+        extent = swapchain.extent;
+        return CreateCommon(device, cache);
+    }
 
-        std::cout << "Graphic Pipeline created." << std::endl;
-        return CreateDescriptorPool();
+    bool CreateHeadless(LogicalDevice& device, PipelineCache& cache, const VkExtent2D& target_size,
+                        bool read_frames)
+    {
+        logical_device = device.logical_device;
+        extent = target_size;
+        headless = true;
+        readback = read_frames;
+        return CreateCommon(device, cache);
     }
 
-    void Delete()
+    void Delete(LogicalDevice& device)
     {
+        if (logical_device != VK_NULL_HANDLE)
+            vkDeviceWaitIdle(logical_device);
+
+        uniforms.Destroy(device);
+        if (recorders)
+            recorders->Destroy();
+        recorders.reset();
+
+        if (graphicsPipeline != VK_NULL_HANDLE)
+            vkDestroyPipeline(logical_device, graphicsPipeline, allocation_callbacks);
         if (pipelineLayout != VK_NULL_HANDLE)
             vkDestroyPipelineLayout(logical_device, pipelineLayout, allocation_callbacks);
         if (renderPass != VK_NULL_HANDLE)
@@ -1621,15 +2713,30 @@ struct GraphicPipeline
         for (auto imageView : image_views)
             vkDestroyImageView(logical_device, imageView, allocation_callbacks);
 
+        if (headless)
+        {
+            for (auto image : images)
+                vkDestroyImage(logical_device, image, allocation_callbacks);
+            for (auto& allocation : image_allocations)
+                device.allocator.Free(allocation);
+            for (auto& buffer : readback_buffers)
+                buffer.Clear(logical_device, device.allocator);
+        }
         if (swapchain.swapchain != VK_NULL_HANDLE)
             vkDestroySwapchainKHR(logical_device, swapchain.swapchain, allocation_callbacks);
         if (commandPool != VK_NULL_HANDLE)
             vkDestroyCommandPool(logical_device, commandPool, allocation_callbacks);
 
-        if (imageAvailableSemaphore != VK_NULL_HANDLE)
-            vkDestroySemaphore(logical_device, imageAvailableSemaphore, allocation_callbacks);
-        if (renderFinishedSemaphore != VK_NULL_HANDLE)
-            vkDestroySemaphore(logical_device, renderFinishedSemaphore, allocation_callbacks);
+        for (auto& frame : frames)
+        {
+            if (frame.imageAvailableSemaphore != VK_NULL_HANDLE)
+                vkDestroySemaphore(logical_device, frame.imageAvailableSemaphore, allocation_callbacks);
+            if (frame.renderFinishedSemaphore != VK_NULL_HANDLE)
+                vkDestroySemaphore(logical_device, frame.renderFinishedSemaphore, allocation_callbacks);
+            if (frame.inFlightFence != VK_NULL_HANDLE)
+                vkDestroyFence(logical_device, frame.inFlightFence, allocation_callbacks);
+        }
+        frames.clear();
 
         if (descriptorSetLayout != VK_NULL_HANDLE)
             vkDestroyDescriptorSetLayout(logical_device, descriptorSetLayout, allocation_callbacks);
@@ -1640,31 +2747,183 @@ struct GraphicPipeline
     bool Render(const std::vector<ModelData>& geometry, LogicalDevice& device, VkSurfaceKHR surface,
                 VkSurfaceCapabilitiesKHR& surface_capabilities, const VkExtent2D& window_size)
     {
-        uint32_t next_swapchain_image;
+        using Clock = std::chrono::steady_clock;
+        const auto frame_start = Clock::now();
+
+        // Wait until the GPU is done with the last submission that used this frame's resources
+        Frame& frame = frames[current_frame];
+        if (vkWaitForFences(logical_device, 1, &frame.inFlightFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to wait for in flight frame." << std::endl;
+            return false;
+        }
+        const auto wait_end = Clock::now();
+
+        // Off-screen targets are paired with frames in flight, so their fence also guards the image
+        uint32_t next_swapchain_image = current_frame;
         if (!ValidatePipeline(device, surface, surface_capabilities, window_size) ||
-            !GetNextImage(next_swapchain_image) || !BeginCommandRecording())
+            (!headless && !GetNextImage(frame, next_swapchain_image)))
             return false;
 
-        BeginRenderPass(framebuffers[next_swapchain_image]);
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-        dynamic_state.Update(commandBuffer);
+        vkResetCommandBuffer(frame.commandBuffer, 0);
+        uniforms.BeginFrame(current_frame);
+        if (!BeginCommandRecording(frame.commandBuffer))
+            return false;
 
-        if (!DrawGeometry(geometry))
+        const auto record_start = Clock::now();
+        if (!DrawGeometry(frame.commandBuffer, framebuffers[next_swapchain_image], geometry))
             return false;
+        const auto record_end = Clock::now();
 
-        vkCmdEndRenderPass(commandBuffer);
-        if (!EndCommandRecording())
+        if (readback)
+            RecordReadback(frame.commandBuffer, next_swapchain_image);
+        if (!EndCommandRecording(frame.commandBuffer))
             return false;
 
         VkQueue graphics_queue = device.GetGraphicsQueue();
-        if (!SubmitCommands(graphics_queue) || !Present(graphics_queue, next_swapchain_image))
+        if (!SubmitCommands(graphics_queue, frame) ||
+            (!headless && !Present(graphics_queue, frame, next_swapchain_image)))
             return false;
 
+        last_frame = current_frame;
+        current_frame = (current_frame + 1) % static_cast<uint32_t>(frames.size());
+
+        const auto frame_end = Clock::now();
+        stats.Add(std::chrono::duration<double, std::milli>(wait_end - frame_start).count(),
+                  std::chrono::duration<double, std::milli>(frame_end - wait_end).count(),
+                  std::chrono::duration<double, std::milli>(record_end - record_start).count());
+        return true;
+    }
+
+    // Draws are recorded inline by the render thread with 0 or 1, and split across secondary command
+    // buffers recorded by that many threads otherwise
+    bool SetRecordThreads(uint32_t count)
+    {
+        if (logical_device != VK_NULL_HANDLE)
+            vkDeviceWaitIdle(logical_device);
+
+        if (recorders)
+            recorders->Destroy();
+        recorders.reset();
+
+        if (count <= 1)
+            return true;
+
+        recorders = std::make_unique<RecordWorkers>();
+        if (!recorders->Create(logical_device, graphics_family, count))
+        {
+            std::cerr << "Failed to create Recording Threads!" << std::endl;
+            recorders->Destroy();
+            recorders.reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    // Waits for the last rendered frame and copies it out as tightly packed BGRA8 rows
+    bool ReadFrame(std::vector<uint8_t>& pixels) const
+    {
+        if (!readback || last_frame == UINT32_MAX)
+        {
+            std::cerr << "No frame to read back, readback is only available on headless pipelines." << std::endl;
+            return false;
+        }
+
+        if (vkWaitForFences(logical_device, 1, &frames[last_frame].inFlightFence, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to wait for frame readback." << std::endl;
+            return false;
+        }
+
+        const auto& buffer = readback_buffers[last_frame];
+        pixels.resize(static_cast<size_t>(extent.width) * extent.height * 4);
+        memcpy(pixels.data(), buffer.allocation.mapped, pixels.size());
         return true;
     }
 
   private:
 
+    bool CreateCommon(LogicalDevice& device, PipelineCache& cache)
+    {
+        graphics_family = device.graphics_family;
+        pipeline_cache = &cache;
+        dynamic_state.Setup(extent);
+
+        // The render pass goes first, framebuffers are created against it
+        if (!CreateRenderPass() ||
+            !(headless ? CreateOffscreenImages(device) : RetrieveImages()) ||
+            !CreateCommandPool(device.graphics_family) ||
+            !CreateCommandBuffers() ||
+            !CreateSyncObjects() ||
+            !CreateDescriptorSetLayout() ||
+            !CreatePipelineLayout() ||
+            !CreateGraphicsPipeline())
+        {
+            std::cerr << "Failed to create Graphic Pipeline." << std::endl;
+            return false;
+        }
+
+        std::cout << "Graphic Pipeline created" << (headless ? " for off-screen rendering." : ".") << std::endl;
+        return CreateDescriptorPool() &&
+               uniforms.Create(device, descriptorPool, descriptorSetLayout, Criteria::Prefered::uniform_ring_size,
+                               sizeof(Shaders::TransfomMatrices));
+    }
+
+    bool CreateOffscreenImages(LogicalDevice& device)
+    {
+        std::cout << "Creating " << Criteria::Prefered::frames_in_flight << " off-screen images." << std::endl;
+        images.resize(Criteria::Prefered::frames_in_flight, VK_NULL_HANDLE);
+        image_allocations.resize(images.size());
+        if (readback)
+            readback_buffers.resize(images.size());
+
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.format = Criteria::Required::surface_format.format;
+            imageInfo.extent = {extent.width, extent.height, 1};
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (vkCreateImage(logical_device, &imageInfo, allocation_callbacks, &images[i]) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to create off-screen image " << i + 1 << "/" << images.size() << "!" << std::endl;
+                return false;
+            }
+
+            VkMemoryRequirements requirements;
+            vkGetImageMemoryRequirements(logical_device, images[i], &requirements);
+            if (!device.allocator.Allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image_allocations[i],
+                                           true) ||
+                vkBindImageMemory(logical_device, images[i], image_allocations[i].memory,
+                                  image_allocations[i].offset) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to allocate off-screen image memory!" << std::endl;
+                return false;
+            }
+
+            if (readback &&
+                !readback_buffers[i].Create(logical_device, device.allocator,
+                                            static_cast<VkDeviceSize>(extent.width) * extent.height * 4,
+                                            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+            {
+                std::cerr << "Failed to create readback buffer!" << std::endl;
+                return false;
+            }
+        }
+
+        return CreateFramebuffers();
+    }
+
     bool RetrieveImages()
     {
         // Get VkImages
@@ -1682,10 +2941,16 @@ struct GraphicPipeline
             return false;
         }
 
+        return CreateFramebuffers();
+    }
+
+    bool CreateFramebuffers()
+    {
         // Get VkImageViews & VkFramebuffers
+        const uint32_t image_count = static_cast<uint32_t>(images.size());
         image_views.resize(image_count);
         framebuffers.resize(image_count);
-        for (auto i = 0; i < image_count; i++)
+        for (uint32_t i = 0; i < image_count; i++)
         {
             VkImageViewCreateInfo createInfo{};
             createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -1713,8 +2978,8 @@ struct GraphicPipeline
             framebufferInfo.renderPass = renderPass;
             framebufferInfo.attachmentCount = 1;
             framebufferInfo.pAttachments = &image_views[i];
-            framebufferInfo.width = swapchain.extent.width;
-            framebufferInfo.height = swapchain.extent.height;
+            framebufferInfo.width = extent.width;
+            framebufferInfo.height = extent.height;
             framebufferInfo.layers = 1;
 
             if (vkCreateFramebuffer(logical_device, &framebufferInfo, nullptr, &framebuffers[i]) != VK_SUCCESS)
@@ -1732,7 +2997,7 @@ struct GraphicPipeline
         VkCommandPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         poolInfo.queueFamilyIndex = graphics_family;
-        poolInfo.flags = 0;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT; // Frames re-record their own buffer
 
         std::cout << "Creating Command Pool." << std::endl;
         if (vkCreateCommandPool(logical_device, &poolInfo, allocation_callbacks, &commandPool) != VK_SUCCESS)
@@ -1743,20 +3008,26 @@ struct GraphicPipeline
         return true;
     }
 
-    bool CreateCommandBuffer()
+    bool CreateCommandBuffers()
     {
+        frames.resize(Criteria::Prefered::frames_in_flight);
+        std::vector<VkCommandBuffer> commandBuffers(frames.size());
+
         VkCommandBufferAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         allocInfo.commandPool = commandPool;
         allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandBufferCount = 1;
+        allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
 
-        std::cout << "Creating Command Buffer." << std::endl;
-        if (vkAllocateCommandBuffers(logical_device, &allocInfo, &commandBuffer) != VK_SUCCESS)
+        std::cout << "Creating " << commandBuffers.size() << " Command Buffers." << std::endl;
+        if (vkAllocateCommandBuffers(logical_device, &allocInfo, commandBuffers.data()) != VK_SUCCESS)
         {
-            std::cerr << "Failed to create Command Buffer!" << std::endl;
+            std::cerr << "Failed to create Command Buffers!" << std::endl;
             return false;
         }
+
+        for (size_t i = 0; i < frames.size(); ++i)
+            frames[i].commandBuffer = commandBuffers[i];
         return true;
     }
 
@@ -1770,7 +3041,7 @@ struct GraphicPipeline
         colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
         VkAttachmentReference colorAttachmentRef{};
         colorAttachmentRef.attachment = 0;
@@ -1808,15 +3079,30 @@ struct GraphicPipeline
         return true;
     }
 
-    bool CreateSemaphores()
+    bool CreateSyncObjects()
     {
-        std::cout << "Creating Semaphores." << std::endl;
+        std::cout << "Creating Semaphores and Fences." << std::endl;
         VkSemaphoreCreateInfo semaphoreInfo{};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-        return vkCreateSemaphore(logical_device, &semaphoreInfo, allocation_callbacks,
-                                 &imageAvailableSemaphore) == VK_SUCCESS &&
-               vkCreateSemaphore(logical_device, &semaphoreInfo, allocation_callbacks,
-                                 &renderFinishedSemaphore) == VK_SUCCESS;
+
+        // Created signaled so the first wait on each frame returns immediately
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        for (auto& frame : frames)
+        {
+            if (vkCreateSemaphore(logical_device, &semaphoreInfo, allocation_callbacks,
+                                  &frame.imageAvailableSemaphore) != VK_SUCCESS ||
+                vkCreateSemaphore(logical_device, &semaphoreInfo, allocation_callbacks,
+                                  &frame.renderFinishedSemaphore) != VK_SUCCESS ||
+                vkCreateFence(logical_device, &fenceInfo, allocation_callbacks, &frame.inFlightFence) != VK_SUCCESS)
+            {
+                std::cerr << "Failed to create frame synchronization objects!" << std::endl;
+                return false;
+            }
+        }
+        return true;
     }
 
     bool CreatePipelineLayout()
@@ -1827,8 +3113,8 @@ struct GraphicPipeline
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         pipelineLayoutInfo.setLayoutCount = 1;
         pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(Shaders::push_constant_ranges.size());
+        pipelineLayoutInfo.pPushConstantRanges = Shaders::push_constant_ranges.data();
 
         if (vkCreatePipelineLayout(logical_device, &pipelineLayoutInfo, allocation_callbacks, &pipelineLayout) !=
             VK_SUCCESS)
@@ -1846,19 +3132,18 @@ struct GraphicPipeline
         const int shader_count = 2;
         VkPipelineShaderStageCreateInfo shader_stages[shader_count]{};
         const char* names[] = {"Vertex", "Fragment"};
-        const char* codes[] = {Shaders::Default::Vertex, Shaders::Default::Fragment};
-        shader_stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-        shader_stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        const Shaders::Source* sources[] = {&Shaders::Default::Vertex, &Shaders::Default::Fragment};
 
         std::set<VkShaderModule> shader_modules{};
         for (int i = 0; i < shader_count; i++)
         {
             auto& shader_stage = shader_stages[i];
             shader_stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            shader_stage.stage = sources[i]->stage;
             shader_stage.pName = "main";
 
             std::cout << "Creating " << names[i] << " Shader Module." << std::endl;
-            if (!Shaders::CreateModule(logical_device, codes[i], shader_stage.module))
+            if (!Shaders::CreateModule(logical_device, *sources[i], shader_stage.module))
                 break;
             shader_modules.insert(shader_stage.module);
         }
@@ -1905,8 +3190,7 @@ struct GraphicPipeline
                                                      dynamicState, states);
 
             // Build Graphics Pipeline
-            success = vkCreateGraphicsPipelines(logical_device, VK_NULL_HANDLE, 1, &pipelineInfo,
-                                                allocation_callbacks, &graphicsPipeline) == VK_SUCCESS;
+            success = pipeline_cache->CreateGraphicsPipeline(pipelineInfo, graphicsPipeline);
         }
         else
             std::cerr << "Failed to create shader modules!" << std::endl;
@@ -1947,6 +3231,7 @@ struct GraphicPipeline
     {
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        // A single set, frames in flight select their slice of the uniform ring through dynamic offsets
         poolInfo.poolSizeCount = static_cast<uint32_t>(Shaders::pool_sizes.size());
         poolInfo.pPoolSizes = Shaders::pool_sizes.data();
         poolInfo.maxSets = 1;
@@ -1965,40 +3250,55 @@ struct GraphicPipeline
     bool ValidatePipeline(LogicalDevice& device, VkSurfaceKHR surface, VkSurfaceCapabilitiesKHR& surface_capabilities,
                           const VkExtent2D& window_size)
     {
-        const uint8_t changes = swapchain.GetChanges(surface_capabilities);
+        const uint8_t changes = headless ? 0 : swapchain.GetChanges(surface_capabilities);
         if (changes != 0)
         {
             std::cout << "Recreating swapchain..." << std::endl;
 
+            // Frames in flight may still target the old framebuffers
+            vkDeviceWaitIdle(logical_device);
+
             // Freeing old resources
             for (auto framebuffer : framebuffers)
                 vkDestroyFramebuffer(logical_device, framebuffer, allocation_callbacks);
             for (auto imageView : image_views)
                 vkDestroyImageView(logical_device, imageView, allocation_callbacks);
 
-            if (!swapchain.Create(device, surface, surface_capabilities, window_size, swapchain.swapchain) ||
-                !RetrieveImages())
+            if (!swapchain.Create(device, surface, surface_capabilities, window_size, swapchain.swapchain))
+            {
+                std::cerr << "Failed to recreate swapchain!" << std::endl;
+                return false;
+            }
+
+            extent = swapchain.extent;
+            if (!RetrieveImages())
             {
                 std::cerr << "Failed to recreate swapchain!" << std::endl;
                 return false;
             }
 
             if(changes & Swapchain::CapabilityChanges::Extent)
-                dynamic_state.OnSwapchainExtentChanged(swapchain.extent);
+                dynamic_state.OnSwapchainExtentChanged(extent);
         }
 
-        if (dynamic_state.requires_recreation && !CreateGraphicsPipeline())
+        if (dynamic_state.requires_recreation)
         {
-            std::cerr << "Failed to recreate Graphics Pipeline!" << std::endl;
-            return false;
+            vkDeviceWaitIdle(logical_device);
+            vkDestroyPipeline(logical_device, graphicsPipeline, allocation_callbacks);
+            graphicsPipeline = VK_NULL_HANDLE;
+            if (!CreateGraphicsPipeline())
+            {
+                std::cerr << "Failed to recreate Graphics Pipeline!" << std::endl;
+                return false;
+            }
         }
 
         return true;
     }
 
-    bool GetNextImage(uint32_t& next_swapchain_image) const
+    bool GetNextImage(const Frame& frame, uint32_t& next_swapchain_image) const
     {
-        if (vkAcquireNextImageKHR(logical_device, swapchain.swapchain, UINT64_MAX, imageAvailableSemaphore,
+        if (vkAcquireNextImageKHR(logical_device, swapchain.swapchain, UINT64_MAX, frame.imageAvailableSemaphore,
                                   VK_NULL_HANDLE, &next_swapchain_image) != VK_SUCCESS)
         {
             std::cerr << "Failed to acquire next swapchain image." << std::endl;
@@ -2007,7 +3307,7 @@ struct GraphicPipeline
         return true;
     }
 
-    bool BeginCommandRecording() const
+    bool BeginCommandRecording(VkCommandBuffer commandBuffer) const
     {
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -2020,7 +3320,7 @@ struct GraphicPipeline
         return true;
     }
 
-    void BeginRenderPass(VkFramebuffer framebuffer) const
+    void BeginRenderPass(VkCommandBuffer commandBuffer, VkFramebuffer framebuffer, VkSubpassContents contents) const
     {
         VkClearValue clear = {clear_color};
         VkRenderPassBeginInfo renderPassInfo{};
@@ -2028,43 +3328,142 @@ struct GraphicPipeline
         renderPassInfo.renderPass = renderPass;
         renderPassInfo.framebuffer = framebuffer;
         renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = swapchain.extent;
+        renderPassInfo.renderArea.extent = extent;
         renderPassInfo.clearValueCount = 1;
         renderPassInfo.pClearValues = &clear;
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
     }
 
-    bool DrawGeometry(const std::vector<ModelData>& geometry) const
+    bool DrawGeometry(VkCommandBuffer commandBuffer, VkFramebuffer framebuffer, const std::vector<ModelData>& geometry)
     {
-        if (geometry.empty())
-            return true;
-
         // Fake time & Transform Matrices
         static float time = 0.0f;
         static Shaders::TransfomMatrices ubo{};
         time += 0.05f;
-        ubo.model[12] = sin(time) * 0.5f; // X-axis
-        ubo.model[13] = cos(time) * 0.5f; // Y-axis
+        const float offset_x = sin(time) * 0.5f;
+        const float offset_y = cos(time) * 0.5f;
+
+        // Frame uniforms are written once and bound by every command buffer
+        uint32_t dynamic_offset = 0;
+        if (!uniforms.Push(&ubo, sizeof(ubo), dynamic_offset))
+            return false;
 
-        std::vector<std::pair<void*, VkDeviceSize>> uniform_data = {
-            {&ubo, sizeof(ubo)}};
+        const uint32_t draw_count = static_cast<uint32_t>(geometry.size());
+        uint32_t thread_count = recorders ? recorders->Count() : 1;
+        thread_count = std::min(thread_count, std::max(1u, draw_count / Criteria::Prefered::draws_per_record_thread));
 
-        for (const auto& geo : geometry)
+        if (thread_count <= 1)
         {
-            // Update Uniforms
-            if (!geo.UpdateAndBindUniformBuffers(logical_device, uniform_data, commandBuffer, pipelineLayout))
-                return false;
+            BeginRenderPass(commandBuffer, framebuffer, VK_SUBPASS_CONTENTS_INLINE);
+            RecordDraws(commandBuffer, geometry, 0, draw_count, dynamic_offset, offset_x, offset_y);
+            vkCmdEndRenderPass(commandBuffer);
+            return true;
+        }
+
+        // Contiguous slices, each worker records its own into this frame's secondary buffer
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = renderPass;
+        inheritance.subpass = 0;
+        inheritance.framebuffer = framebuffer;
+
+        const uint32_t slice = (draw_count + thread_count - 1) / thread_count;
+        std::vector<VkCommandBuffer> secondaries(thread_count);
+        std::vector<uint8_t> succeeded(thread_count, 0);
+        recorders->Run(thread_count, [&](uint32_t worker) {
+            VkCommandBuffer secondary = recorders->CommandBuffer(worker, current_frame);
+            secondaries[worker] = secondary;
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags =
+                VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = &inheritance;
+            if (vkBeginCommandBuffer(secondary, &beginInfo) != VK_SUCCESS)
+                return;
+
+            const uint32_t begin = std::min(worker * slice, draw_count);
+            RecordDraws(secondary, geometry, begin, std::min(begin + slice, draw_count), dynamic_offset, offset_x,
+                        offset_y);
+            succeeded[worker] = vkEndCommandBuffer(secondary) == VK_SUCCESS;
+        });
+
+        if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+        {
+            std::cerr << "Failed to record secondary command buffers." << std::endl;
+            return false;
+        }
+
+        BeginRenderPass(commandBuffer, framebuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        vkCmdExecuteCommands(commandBuffer, thread_count, secondaries.data());
+        vkCmdEndRenderPass(commandBuffer);
+        return true;
+    }
+
+    // Only reads shared state, so workers may record different ranges at once
+    void RecordDraws(VkCommandBuffer commandBuffer, const std::vector<ModelData>& geometry, uint32_t begin,
+                     uint32_t end, uint32_t dynamic_offset, float offset_x, float offset_y) const
+    {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+        dynamic_state.Update(commandBuffer);
+        uniforms.Bind(commandBuffer, pipelineLayout, dynamic_offset);
+
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const auto& geo = geometry[i];
+
+            // Update Transform
+            Shaders::DrawConstants constants = geo.constants;
+            constants.model[12] += offset_x; // X-axis
+            constants.model[13] += offset_y; // Y-axis
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants),
+                               &constants);
 
             // Bind Buffers & Draw
             vkCmdBindVertexBuffers(commandBuffer, 0, 1, &geo.vertex.buffer, &geo.offset);
             vkCmdBindIndexBuffer(commandBuffer, geo.index.buffer, geo.offset, VK_INDEX_TYPE_UINT32);
             vkCmdDrawIndexed(commandBuffer, geo.index.count, 1, 0, 0, 0);
         }
+    }
 
-        return true;
+    void RecordReadback(VkCommandBuffer commandBuffer, uint32_t image_index) const
+    {
+        // The render pass leaves the image in TRANSFER_SRC_OPTIMAL, wait for its color writes
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = images[image_index];
+        toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {extent.width, extent.height, 1};
+        const VkBuffer buffer = readback_buffers[image_index].buffer;
+        vkCmdCopyImageToBuffer(commandBuffer, images[image_index], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1,
+                               &region);
+
+        // Make the copy visible to the host once the frame's fence signals
+        VkBufferMemoryBarrier toHost{};
+        toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.buffer = buffer;
+        toHost.offset = 0;
+        toHost.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr,
+                             1, &toHost, 0, nullptr);
     }
 
-    bool EndCommandRecording() const
+    bool EndCommandRecording(VkCommandBuffer commandBuffer) const
     {
         if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
         {
@@ -2075,41 +3474,51 @@ struct GraphicPipeline
         return true;
     }
 
-    bool SubmitCommands(VkQueue graphics_queue) const
+    bool SubmitCommands(VkQueue graphics_queue, const Frame& frame) const
     {
         // Submit the command buffer.
         VkSubmitInfo submitInfo{};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-        VkSemaphore waitSemaphores[] = {imageAvailableSemaphore};
+        // Without a swapchain there is no image to acquire or present
+        VkSemaphore waitSemaphores[] = {frame.imageAvailableSemaphore};
         VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.waitSemaphoreCount = headless ? 0 : 1;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
 
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
+        submitInfo.pCommandBuffers = &frame.commandBuffer;
 
-        VkSemaphore signalSemaphores[] = {renderFinishedSemaphore};
-        submitInfo.signalSemaphoreCount = 1;
+        VkSemaphore signalSemaphores[] = {frame.renderFinishedSemaphore};
+        submitInfo.signalSemaphoreCount = headless ? 0 : 1;
         submitInfo.pSignalSemaphores = signalSemaphores;
 
-        if (vkQueueSubmit(graphics_queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        // Reset right before the submit that signals it again, so a frame that fails earlier leaves
+        // the fence signaled and the next wait on it can't hang
+        if (vkResetFences(logical_device, 1, &frame.inFlightFence) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to reset in flight fence." << std::endl;
+            return false;
+        }
+        if (vkQueueSubmit(graphics_queue, 1, &submitInfo, frame.inFlightFence) != VK_SUCCESS)
         {
             std::cerr << "Failed to submit command buffer." << std::endl;
+            // An empty submit still signals the fence once the queue is done with earlier work
+            vkQueueSubmit(graphics_queue, 0, nullptr, frame.inFlightFence);
             return false;
         }
 
         return true;
     }
 
-    bool Present(VkQueue graphics_queue, uint32_t& next_swapchain_image) const
+    bool Present(VkQueue graphics_queue, const Frame& frame, uint32_t& next_swapchain_image) const
     {
         // Present the image.
         VkPresentInfoKHR presentInfo{};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
         presentInfo.waitSemaphoreCount = 1;
-        presentInfo.pWaitSemaphores = &renderFinishedSemaphore;
+        presentInfo.pWaitSemaphores = &frame.renderFinishedSemaphore;
         presentInfo.swapchainCount = 1;
         presentInfo.pSwapchains = &swapchain.swapchain;
         presentInfo.pImageIndices = &next_swapchain_image;
@@ -2178,6 +3587,12 @@ export namespace RE
 {
     namespace Vulkan
     {
+        // Off-screen rendering only needs the loader the engine links against, no SDL video subsystem
+        bool InitHeadless()
+        {
+            return Populate::Instance::LayerProperties();
+        }
+
         bool Init()
         {
             std::cout << "Loading default Vulkan library." << std::endl;
@@ -2190,15 +3605,27 @@ export namespace RE
             return Populate::Instance::LayerProperties();
         }
 
-        bool CreateTriangle(ModelData& out_data, const LogicalDevice& device, VkCommandPool commandPool,
-                                   VkDescriptorPool& descriptorPool, VkDescriptorSetLayout& descriptorSetLayout)
+        // Native directory the pipeline and shader caches are written to, empty goes back to the default one
+        void SetCacheDirectory(const char* directory)
+        {
+            cache_directory = directory != nullptr && directory[0] != '\0'
+                                  ? (std::filesystem::path(directory) / "").string()
+                                  : std::string();
+        }
+
+        std::string PipelineCachePath()
+        {
+            return CacheDirectory() + Criteria::Prefered::pipeline_cache_file;
+        }
+
+        bool CreateTriangle(ModelData& out_data, LogicalDevice& device, UploadBatcher& uploader)
         {
             std::vector<uint32_t> indices = {0, 1, 2};
             std::vector<Shaders::Vertex> vertices = {{{0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},
                                                      {{0.5f, 0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},
                                                      {{-0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
 
-            if (!out_data.Create(device, commandPool, descriptorPool, descriptorSetLayout, vertices, indices))
+            if (!out_data.Create(device, uploader, vertices, indices))
             {
                 std::cerr << "Failed to create triangle!" << std::endl;
                 return false;
@@ -2214,9 +3641,12 @@ export namespace RE
 
             DebugMessenger debug_messenger{};
             LogicalDevice device{};
+            PipelineCache pipeline_cache{};
             GraphicPipeline pipeline{};
+            UploadBatcher uploader{};
 
             // State
+            bool headless = false;
             VkSurfaceCapabilitiesKHR surface_capabilities{};
             VkExtent2D window_size{};
             std::vector<ModelData> to_draw{};
@@ -2230,9 +3660,9 @@ export namespace RE
                     !CreateSurface(window) ||
                     !device.Create(instance, surface) ||
                     !GetSurfaceCapabilities() ||
-                    !pipeline.Create(device, surface, surface_capabilities, window_size) ||
-                    !CreateTriangle(to_draw[0], device, pipeline.commandPool, pipeline.descriptorPool,
-                                               pipeline.descriptorSetLayout))
+                    !pipeline_cache.Create(device, PipelineCachePath()) ||
+                    !pipeline.Create(device, pipeline_cache, surface, surface_capabilities, window_size) ||
+                    !CreateScene())
                 {
                     std::cerr << "Failed to setup Context for Vulkan rendering." << std::endl;
                     Delete();
@@ -2243,15 +3673,44 @@ export namespace RE
                 return true;
             }
 
+            // Renders into off-screen images, no window, surface or swapchain. With readback each
+            // frame is copied to host memory and ReadFrame returns its pixels.
+            bool CreateHeadless(uint32_t w, uint32_t h, bool readback = false)
+            {
+                headless = true;
+                to_draw.push_back({});
+                window_size = {w, h};
+
+                if ((availableLayers.empty() && !Populate::Instance::LayerProperties()) ||
+                    !CreateInstance(nullptr) ||
+                    !device.Create(instance, VK_NULL_HANDLE) ||
+                    !pipeline_cache.Create(device, PipelineCachePath()) ||
+                    !pipeline.CreateHeadless(device, pipeline_cache, window_size, readback) ||
+                    !CreateScene())
+                {
+                    std::cerr << "Failed to setup headless Context for Vulkan rendering." << std::endl;
+                    Delete();
+                    return false;
+                }
+
+                std::cout << "Successfull headless Vulkan Context creation." << std::endl;
+                return true;
+            }
+
             bool Delete()
             {
+                // Frames in flight may still read the drawables' buffers
+                if (device.logical_device != VK_NULL_HANDLE)
+                    vkDeviceWaitIdle(device.logical_device);
+
                 for (auto& drawable : to_draw)
-                    drawable.Destroy(device.logical_device);
+                    drawable.Destroy(device);
 
-                pipeline.Delete();
+                uploader.Destroy(device);
+                pipeline.Delete(device);
+                pipeline_cache.Destroy();
 
-                if (device.logical_device != VK_NULL_HANDLE)
-                    vkDestroyDevice(device.logical_device, allocation_callbacks);
+                device.Delete();
                 if (surface != VK_NULL_HANDLE)
                     vkDestroySurfaceKHR(instance, surface, allocation_callbacks);
 
@@ -2264,9 +3723,34 @@ export namespace RE
                 return true;
             }
 
+            // Extra triangles laid out on a grid, one draw each
+            bool CreateTriangles(uint32_t count)
+            {
+                const uint32_t columns = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(count))));
+                const float scale = 1.f / columns;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    ModelData& triangle = to_draw.emplace_back();
+                    if (!CreateTriangle(triangle, device, uploader))
+                        return false;
+
+                    triangle.constants.model[0] = scale;
+                    triangle.constants.model[5] = scale;
+                    triangle.constants.model[12] = scale * (2 * (i % columns) + 1) - 1.f;
+                    triangle.constants.model[13] = scale * (2 * (i / columns) + 1) - 1.f;
+                }
+
+                return uploader.Finish();
+            }
+
+            bool SetRecordThreads(uint32_t count)
+            {
+                return pipeline.SetRecordThreads(count);
+            }
+
             bool RenderTriangle()
             {
-                if (!GetSurfaceCapabilities() ||
+                if ((!headless && !GetSurfaceCapabilities()) ||
                     !pipeline.Render(to_draw, device, surface, surface_capabilities, window_size))
                 {
                     std::cerr << "Failed to render!" << std::endl;
@@ -2276,17 +3760,55 @@ export namespace RE
                 return true;
             }
 
+            const FrameStats& GetFrameStats() const
+            {
+                return pipeline.stats;
+            }
+
+            const PipelineCache& GetPipelineCache() const
+            {
+                return pipeline_cache;
+            }
+
+            MemoryStats GetMemoryStats() const
+            {
+                return device.allocator.GetStats();
+            }
+
+            // Keeps up to sample_capacity frame times for percentiles
+            void ResetFrameStats(size_t sample_capacity = 0)
+            {
+                pipeline.stats.Reset(sample_capacity);
+            }
+
+            bool ReadFrame(std::vector<uint8_t>& pixels) const
+            {
+                return pipeline.ReadFrame(pixels);
+            }
+
           private:
 
+            bool CreateScene()
+            {
+                return uploader.Create(device, Criteria::Prefered::staging_ring_size) &&
+                       CreateTriangle(to_draw[0], device, uploader) &&
+                       uploader.Finish();
+            }
+
             bool CreateInstance(SDL_Window* window)
             {
                 std::vector<const char*> instance_extensions;
-                if (!Populate::Instance::RequiredSDLExtensions(window, instance_extensions))
+                if (window != nullptr && !Populate::Instance::RequiredSDLExtensions(window, instance_extensions))
                     return false;
 
                 std::vector<const char*> layers{};
                 Populate::Instance::Layers(layers);
 
+                // The debug messenger below needs its extension enabled
+                for (auto layer : layers)
+                    if (strcmp(layer, "VK_LAYER_KHRONOS_validation") == 0)
+                        instance_extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+
                 VkApplicationInfo appInfo{};
                 appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
                 appInfo.pApplicationName = "RedEye Engine";
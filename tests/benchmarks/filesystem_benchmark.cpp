@@ -0,0 +1,213 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <physfs.h>
+#include <string>
+#include <system_error>
+#include <vector>
+import FileSystem;
+
+namespace
+{
+    // Writes land in a temporary directory, set as the write directory and mounted for
+    // reading under "WriteDir/". It is removed when the benchmarks exit.
+    const char* benchmarkDir = "Benchmarks/";
+
+    struct TempDirectory
+    {
+        TempDirectory() : path(std::filesystem::temp_directory_path() / "RedEye_benchmarks")
+        {
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDirectory()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        std::filesystem::path path;
+    };
+
+    bool InitFileSystem()
+    {
+        static TempDirectory directory;
+        static bool initialized = []() {
+            const std::string native = directory.path.string();
+            return PHYSFS_init(nullptr) != 0 && PHYSFS_mount(native.c_str(), "WriteDir/", 0) != 0 &&
+                   PHYSFS_setWriteDir(native.c_str()) != 0;
+        }();
+        return initialized;
+    }
+
+    std::string MakeData(int64_t size)
+    {
+        std::string data(static_cast<size_t>(size), '\0');
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<char>('a' + i % 26);
+        return data;
+    }
+
+    std::string FileName(int64_t size)
+    {
+        return "file_" + std::to_string(size) + ".bin";
+    }
+
+    // Many small files, as a Library load or a thumbnail pass would read them
+    std::vector<std::string> MakeFiles(int64_t count)
+    {
+        const std::string data = MakeData(64 << 10);
+        std::vector<std::string> paths;
+        for (int64_t i = 0; i < count; ++i)
+        {
+            const std::string file = "batch_" + std::to_string(i) + ".bin";
+            RE::FileSystem::Write(benchmarkDir, file.c_str(), data.data(), static_cast<uint32_t>(data.size()));
+            paths.push_back(std::string("WriteDir/") + benchmarkDir + file);
+        }
+        return paths;
+    }
+} // namespace
+
+static void BM_FileSystem_Write(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::string data = MakeData(state.range(0));
+    const std::string file = FileName(state.range(0));
+
+    for (auto _ : state)
+        RE::FileSystem::Write(benchmarkDir, file.c_str(), data.data(), static_cast<uint32_t>(data.size()));
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_Write)->Arg(4 << 10)->Arg(16 << 20);
+
+static void BM_FileSystem_Read(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::string data = MakeData(state.range(0));
+    const std::string file = FileName(state.range(0));
+    RE::FileSystem::Write(benchmarkDir, file.c_str(), data.data(), static_cast<uint32_t>(data.size()));
+
+    const std::string path = std::string("WriteDir/") + benchmarkDir + file;
+    for (auto _ : state)
+    {
+        std::string read = RE::FileSystem::Read(path.c_str());
+        if (read.size() != data.size())
+        {
+            state.SkipWithError("Read size mismatch");
+            break;
+        }
+        benchmark::DoNotOptimize(read);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_Read)->Arg(4 << 10)->Arg(16 << 20);
+
+static void BM_FileSystem_ReadInto(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::string data = MakeData(state.range(0));
+    const std::string file = FileName(state.range(0));
+    RE::FileSystem::Write(benchmarkDir, file.c_str(), data.data(), static_cast<uint32_t>(data.size()));
+
+    const std::string path = std::string("WriteDir/") + benchmarkDir + file;
+    std::string buffer(static_cast<size_t>(RE::FileSystem::FileSize(path.c_str())), '\0');
+    for (auto _ : state)
+    {
+        if (RE::FileSystem::ReadInto(path.c_str(), buffer.data(), buffer.size()) != data.size())
+        {
+            state.SkipWithError("Read size mismatch");
+            break;
+        }
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_ReadInto)->Arg(4 << 10)->Arg(16 << 20);
+
+// Opens the view and touches every page, as a loader walking the whole asset would
+static void BM_FileSystem_Mapped(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::string data = MakeData(state.range(0));
+    const std::string file = FileName(state.range(0));
+    RE::FileSystem::Write(benchmarkDir, file.c_str(), data.data(), static_cast<uint32_t>(data.size()));
+
+    const std::string path = std::string("WriteDir/") + benchmarkDir + file;
+    for (auto _ : state)
+    {
+        RE::FileSystem::MappedFile view(path.c_str());
+        if (!view.IsValid() || view.Size() != data.size())
+        {
+            state.SkipWithError("Mapped size mismatch");
+            break;
+        }
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < view.Size(); i += 4096)
+            sum += static_cast<unsigned char>(view.Data()[i]);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_Mapped)->Arg(4 << 10)->Arg(16 << 20);
+
+static void BM_FileSystem_ReadSerial(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::vector<std::string> paths = MakeFiles(state.range(0));
+    for (auto _ : state)
+        for (const auto& path : paths)
+        {
+            std::string read = RE::FileSystem::Read(path.c_str());
+            benchmark::DoNotOptimize(read);
+        }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_ReadSerial)->Arg(64)->UseRealTime();
+
+static void BM_FileSystem_ReadBatch(benchmark::State& state)
+{
+    if (!InitFileSystem())
+    {
+        state.SkipWithError("Failed to mount the temporary directory");
+        return;
+    }
+    const std::vector<std::string> paths = MakeFiles(state.range(0));
+    for (auto _ : state)
+    {
+        auto reads = RE::FileSystem::ReadBatch(paths);
+        for (auto& read : reads)
+        {
+            std::string contents = read.get();
+            benchmark::DoNotOptimize(contents);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileSystem_ReadBatch)->Arg(64)->UseRealTime();
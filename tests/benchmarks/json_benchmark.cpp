@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <rapidjson/document.h>
+#include <rapidjson/pointer.h>
+#include <string>
+#include <vector>
+import JSON;
+
+namespace
+{
+    std::vector<std::string> MakeKeys(int64_t count)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (int64_t i = 0; i < count; ++i)
+            keys.push_back("key" + std::to_string(i));
+        return keys;
+    }
+
+    uint32_t MakeConfig(const std::vector<std::string>& keys)
+    {
+        uint32_t id = RE::JSON::Create();
+        RE::JSON::Cursor config(id, "/config");
+        for (const auto& key : keys)
+            config.PushString(key.c_str(), "value");
+        return id;
+    }
+
+    // A scene-like document: objects of numbered members holding floats, ints and strings
+    std::string MakeDocument(int64_t count)
+    {
+        RE::JSON::Writer writer;
+        writer.StartObject();
+        writer.StartObject("gameobjects");
+        for (int64_t i = 0; i < count; ++i)
+        {
+            const std::string key = std::to_string(i);
+            const float position[3] = {static_cast<float>(i), 1.f, 2.f};
+            writer.StartObject(key.c_str());
+            writer.PushString("name", ("GameObject" + key).c_str());
+            writer.PushUInt64("GOUID", 1000000000000ull + i);
+            writer.PushFloats("position", position, 3);
+            writer.PushBool("active", true);
+            writer.EndObject();
+        }
+        writer.EndObject();
+        writer.EndObject();
+        writer.Close();
+        return std::string(writer.GetBuffer());
+    }
+} // namespace
+
+// Reference: what PullString did before, a pointer string built and tokenized per call
+static void BM_PullString_PointerPerCall(benchmark::State& state)
+{
+    auto keys = MakeKeys(state.range(0));
+    rapidjson::Document document;
+    document.SetObject();
+    for (const auto& key : keys)
+        rapidjson::Pointer(("/config/" + key).c_str()).Set(document, "value");
+
+    std::string pointer = "/config";
+    for (auto _ : state)
+        for (const auto& key : keys)
+        {
+            rapidjson::Value* val = rapidjson::Pointer((pointer + "/" + key).c_str()).Get(document);
+            std::string str = val ? val->GetString() : "";
+            benchmark::DoNotOptimize(str);
+        }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PullString_PointerPerCall)->Arg(1000);
+
+static void BM_PullString_Value(benchmark::State& state)
+{
+    auto keys = MakeKeys(state.range(0));
+    uint32_t id = MakeConfig(keys);
+
+    RE::JSON::Value::Push("config", id);
+    for (auto _ : state)
+        for (const auto& key : keys)
+        {
+            std::string str = RE::JSON::Value::PullString(key.c_str(), "", id);
+            benchmark::DoNotOptimize(str);
+        }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    RE::JSON::Destroy(id);
+}
+BENCHMARK(BM_PullString_Value)->Arg(1000);
+
+static void BM_PullString_Cursor(benchmark::State& state)
+{
+    auto keys = MakeKeys(state.range(0));
+    uint32_t id = MakeConfig(keys);
+
+    RE::JSON::Cursor config(id, "/config", false);
+    for (auto _ : state)
+        for (const auto& key : keys)
+        {
+            std::string str = config.PullString(key.c_str(), "");
+            benchmark::DoNotOptimize(str);
+        }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    RE::JSON::Destroy(id);
+}
+BENCHMARK(BM_PullString_Cursor)->Arg(1000);
+
+static void BM_PushString_PointerPerCall(benchmark::State& state)
+{
+    auto keys = MakeKeys(state.range(0));
+    for (auto _ : state)
+    {
+        rapidjson::Document document;
+        document.SetObject();
+        for (const auto& key : keys)
+            rapidjson::Pointer(("/config/" + key).c_str()).Set(document, "value");
+        benchmark::DoNotOptimize(document);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PushString_PointerPerCall)->Arg(1000);
+
+static void BM_PushString_Cursor(benchmark::State& state)
+{
+    auto keys = MakeKeys(state.range(0));
+    for (auto _ : state)
+    {
+        uint32_t id = MakeConfig(keys);
+        RE::JSON::Destroy(id);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PushString_Cursor)->Arg(1000);
+
+static void BM_PullTyped_Cursor(benchmark::State& state)
+{
+    uint32_t id = RE::JSON::Create();
+    RE::JSON::Cursor transform(id, "/transform");
+    const float position[3] = {1.f, 2.f, 3.f};
+    transform.PushFloats("position", position, 3);
+    transform.PushInt("parent", 42);
+    transform.PushBool("static", true);
+    transform.PushFloat("scale", 2.f);
+
+    for (auto _ : state)
+    {
+        float out[3];
+        benchmark::DoNotOptimize(transform.PullFloats("position", out, 3));
+        benchmark::DoNotOptimize(transform.PullInt("parent", 0));
+        benchmark::DoNotOptimize(transform.PullBool("static", false));
+        benchmark::DoNotOptimize(transform.PullFloat("scale", 1.f));
+    }
+
+    RE::JSON::Destroy(id);
+}
+BENCHMARK(BM_PullTyped_Cursor);
+
+static void BM_Parse(benchmark::State& state)
+{
+    const std::string document = MakeDocument(state.range(0));
+    for (auto _ : state)
+    {
+        uint32_t id = RE::JSON::Parse(document);
+        benchmark::DoNotOptimize(id);
+        RE::JSON::Destroy(id);
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(BM_Parse)->Arg(100)->Arg(10000);
+
+// Includes copying the source into the mutable buffer, as a loader would after reading a file
+static void BM_ParseInsitu(benchmark::State& state)
+{
+    const std::string document = MakeDocument(state.range(0));
+    std::vector<char> buffer(document.size() + 1);
+    for (auto _ : state)
+    {
+        std::copy(document.c_str(), document.c_str() + buffer.size(), buffer.begin());
+        uint32_t id = RE::JSON::ParseInsitu(buffer.data());
+        benchmark::DoNotOptimize(id);
+        RE::JSON::Destroy(id);
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+BENCHMARK(BM_ParseInsitu)->Arg(100)->Arg(10000);
+
+static void BM_GetBuffer(benchmark::State& state)
+{
+    const std::string document = MakeDocument(state.range(0));
+    uint32_t id = RE::JSON::Parse(document);
+    for (auto _ : state)
+    {
+        std::string buffer = RE::JSON::GetBuffer(id);
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetBytesProcessed(state.iterations() * document.size());
+    RE::JSON::Destroy(id);
+}
+BENCHMARK(BM_GetBuffer)->Arg(100)->Arg(10000);
+
+static void BM_Writer(benchmark::State& state)
+{
+    size_t size = 0;
+    for (auto _ : state)
+    {
+        std::string document = MakeDocument(state.range(0));
+        size = document.size();
+        benchmark::DoNotOptimize(document);
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Writer)->Arg(100)->Arg(10000);
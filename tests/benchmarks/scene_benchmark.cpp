@@ -0,0 +1,286 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+import JSON;
+
+// Scene round-trips of the meshes and lights component pools, in the two formats the legacy
+// RE_ECS_Importer writes. The importer itself is not part of the CMake build, so both layouts are
+// reproduced here:
+// - JSON as ComponentPool::SerializeJson writes it: "poolSize", then one object per component holding
+//   "parentPoolID" and the component's members.
+// - Binary blocks as ComponentPool::SerializeBinaryBlock writes them: every GO_UID, then the fixed size
+//   records, with the entry counts kept in a table in front as the scene header does.
+namespace
+{
+    struct MeshComponent
+    {
+        uint64_t go = 0;
+        int32_t mesh = -1;
+        int32_t material = -1;
+    };
+
+    struct LightComponent
+    {
+        uint64_t go = 0;
+        uint16_t type = 0;
+        float intensity = 1.f, constant = 1.f, linear = 0.091f, quadratic = 0.011f;
+        float diffuse[3] = {1.f, 1.f, 1.f};
+        float specular = 0.2f, cutOff = 0.97f, outerCutOff = 0.95f;
+    };
+
+    struct SyntheticScene
+    {
+        std::vector<MeshComponent> meshes;
+        std::vector<LightComponent> lights;
+    };
+
+    constexpr size_t meshRecordSize = sizeof(int32_t) * 2;
+    constexpr size_t lightRecordSize = sizeof(uint16_t) + sizeof(float) * 10;
+
+    SyntheticScene MakeScene(int64_t count)
+    {
+        SyntheticScene scene;
+        scene.meshes.resize(static_cast<size_t>(count));
+        for (size_t i = 0; i < scene.meshes.size(); ++i)
+        {
+            MeshComponent& comp = scene.meshes[i];
+            comp.go = 1000000000000ull + i;
+            comp.mesh = static_cast<int32_t>(i % 64);
+            comp.material = (i % 5) != 0 ? static_cast<int32_t>(i % 16) : -1;
+        }
+
+        // A light for every eight meshes
+        scene.lights.resize(static_cast<size_t>(count / 8));
+        for (size_t i = 0; i < scene.lights.size(); ++i)
+        {
+            LightComponent& comp = scene.lights[i];
+            comp.go = 2000000000000ull + i;
+            comp.type = static_cast<uint16_t>(i % 3);
+            comp.intensity = 1.f + static_cast<float>(i) * 0.25f;
+            comp.diffuse[i % 3] = 0.5f;
+        }
+        return scene;
+    }
+
+    bool SameScene(const SyntheticScene& a, const SyntheticScene& b)
+    {
+        if (a.meshes.size() != b.meshes.size() || a.lights.size() != b.lights.size())
+            return false;
+        for (size_t i = 0; i < a.meshes.size(); ++i)
+            if (std::memcmp(&a.meshes[i], &b.meshes[i], sizeof(MeshComponent)) != 0)
+                return false;
+        for (size_t i = 0; i < a.lights.size(); ++i)
+        {
+            const LightComponent &l = a.lights[i], &r = b.lights[i];
+            if (l.go != r.go || l.type != r.type || l.intensity != r.intensity || l.constant != r.constant ||
+                l.linear != r.linear || l.quadratic != r.quadratic || l.specular != r.specular ||
+                l.cutOff != r.cutOff || l.outerCutOff != r.outerCutOff ||
+                std::memcmp(l.diffuse, r.diffuse, sizeof(l.diffuse)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    std::string SaveJson(const SyntheticScene& scene)
+    {
+        RE::JSON::Writer writer;
+        writer.StartObject();
+
+        writer.StartObject("Meshes Pool");
+        writer.PushUInt64("poolSize", scene.meshes.size());
+        for (size_t i = 0; i < scene.meshes.size(); ++i)
+        {
+            const MeshComponent& comp = scene.meshes[i];
+            writer.StartObject(std::to_string(i).c_str());
+            writer.PushUInt64("parentPoolID", comp.go);
+            writer.PushInt("meshResource", comp.mesh);
+            writer.PushInt("materialResource", comp.material);
+            writer.EndObject();
+        }
+        writer.EndObject();
+
+        writer.StartObject("Lights Pool");
+        writer.PushUInt64("poolSize", scene.lights.size());
+        for (size_t i = 0; i < scene.lights.size(); ++i)
+        {
+            const LightComponent& comp = scene.lights[i];
+            writer.StartObject(std::to_string(i).c_str());
+            writer.PushUInt64("parentPoolID", comp.go);
+            writer.PushInt("light_type", comp.type);
+            writer.PushFloat("intensity", comp.intensity);
+            writer.PushFloat("constant", comp.constant);
+            writer.PushFloat("linear", comp.linear);
+            writer.PushFloat("quadratic", comp.quadratic);
+            writer.PushFloats("diffuse", comp.diffuse, 3);
+            writer.PushFloat("specular", comp.specular);
+            writer.PushFloat("cutOff", comp.cutOff);
+            writer.PushFloat("outerCutOff", comp.outerCutOff);
+            writer.EndObject();
+        }
+        writer.EndObject();
+
+        writer.EndObject();
+        writer.Close();
+        return std::string(writer.GetBuffer());
+    }
+
+    SyntheticScene LoadJson(const std::string& buffer)
+    {
+        SyntheticScene scene;
+        uint32_t id = RE::JSON::Parse(buffer);
+
+        RE::JSON::Cursor meshes(id, "/Meshes Pool", false);
+        scene.meshes.resize(static_cast<size_t>(meshes.PullUInt64("poolSize", 0)));
+        for (size_t i = 0; i < scene.meshes.size(); ++i)
+        {
+            MeshComponent& comp = scene.meshes[i];
+            RE::JSON::Cursor node = meshes.Child(std::to_string(i).c_str(), false);
+            comp.go = node.PullUInt64("parentPoolID", 0);
+            comp.mesh = node.PullInt("meshResource", -1);
+            comp.material = node.PullInt("materialResource", -1);
+        }
+
+        RE::JSON::Cursor lights(id, "/Lights Pool", false);
+        scene.lights.resize(static_cast<size_t>(lights.PullUInt64("poolSize", 0)));
+        for (size_t i = 0; i < scene.lights.size(); ++i)
+        {
+            LightComponent& comp = scene.lights[i];
+            RE::JSON::Cursor node = lights.Child(std::to_string(i).c_str(), false);
+            comp.go = node.PullUInt64("parentPoolID", 0);
+            comp.type = static_cast<uint16_t>(node.PullInt("light_type", 0));
+            comp.intensity = node.PullFloat("intensity", comp.intensity);
+            comp.constant = node.PullFloat("constant", comp.constant);
+            comp.linear = node.PullFloat("linear", comp.linear);
+            comp.quadratic = node.PullFloat("quadratic", comp.quadratic);
+            node.PullFloats("diffuse", comp.diffuse, 3);
+            comp.specular = node.PullFloat("specular", comp.specular);
+            comp.cutOff = node.PullFloat("cutOff", comp.cutOff);
+            comp.outerCutOff = node.PullFloat("outerCutOff", comp.outerCutOff);
+        }
+
+        RE::JSON::Destroy(id);
+        return scene;
+    }
+
+    template <class T> void Write(char*& cursor, const T& value)
+    {
+        std::memcpy(cursor, &value, sizeof(T));
+        cursor += sizeof(T);
+    }
+
+    template <class T> void Read(const char*& cursor, T& value)
+    {
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+    }
+
+    std::string SaveBinary(const SyntheticScene& scene)
+    {
+        const size_t meshCount = scene.meshes.size(), lightCount = scene.lights.size();
+        std::string buffer(sizeof(uint64_t) * 2 + meshCount * (sizeof(uint64_t) + meshRecordSize) +
+                               lightCount * (sizeof(uint64_t) + lightRecordSize),
+                           '\0');
+        char* cursor = buffer.data();
+        Write<uint64_t>(cursor, meshCount);
+        Write<uint64_t>(cursor, lightCount);
+
+        for (const MeshComponent& comp : scene.meshes)
+            Write(cursor, comp.go);
+        for (const MeshComponent& comp : scene.meshes)
+        {
+            Write(cursor, comp.mesh);
+            Write(cursor, comp.material);
+        }
+
+        for (const LightComponent& comp : scene.lights)
+            Write(cursor, comp.go);
+        for (const LightComponent& comp : scene.lights)
+        {
+            Write(cursor, comp.type);
+            Write(cursor, comp.intensity);
+            Write(cursor, comp.constant);
+            Write(cursor, comp.linear);
+            Write(cursor, comp.quadratic);
+            std::memcpy(cursor, comp.diffuse, sizeof(comp.diffuse));
+            cursor += sizeof(comp.diffuse);
+            Write(cursor, comp.specular);
+            Write(cursor, comp.cutOff);
+            Write(cursor, comp.outerCutOff);
+        }
+        return buffer;
+    }
+
+    SyntheticScene LoadBinary(const std::string& buffer)
+    {
+        SyntheticScene scene;
+        const char* cursor = buffer.data();
+        uint64_t meshCount = 0, lightCount = 0;
+        Read(cursor, meshCount);
+        Read(cursor, lightCount);
+
+        scene.meshes.resize(static_cast<size_t>(meshCount));
+        for (MeshComponent& comp : scene.meshes)
+            Read(cursor, comp.go);
+        for (MeshComponent& comp : scene.meshes)
+        {
+            Read(cursor, comp.mesh);
+            Read(cursor, comp.material);
+        }
+
+        scene.lights.resize(static_cast<size_t>(lightCount));
+        for (LightComponent& comp : scene.lights)
+            Read(cursor, comp.go);
+        for (LightComponent& comp : scene.lights)
+        {
+            Read(cursor, comp.type);
+            Read(cursor, comp.intensity);
+            Read(cursor, comp.constant);
+            Read(cursor, comp.linear);
+            Read(cursor, comp.quadratic);
+            std::memcpy(comp.diffuse, cursor, sizeof(comp.diffuse));
+            cursor += sizeof(comp.diffuse);
+            Read(cursor, comp.specular);
+            Read(cursor, comp.cutOff);
+            Read(cursor, comp.outerCutOff);
+        }
+        return scene;
+    }
+
+    // Both formats run the same loop, after checking once that the scene survives the round-trip
+    template <class Save, class Load>
+    void RoundTrip(benchmark::State& state, Save save, Load load)
+    {
+        const SyntheticScene scene = MakeScene(state.range(0));
+        if (!SameScene(load(save(scene)), scene))
+        {
+            state.SkipWithError("Scene changed in the round-trip");
+            return;
+        }
+
+        size_t size = 0;
+        for (auto _ : state)
+        {
+            std::string buffer = save(scene);
+            SyntheticScene loaded = load(buffer);
+            size = buffer.size();
+            benchmark::DoNotOptimize(loaded);
+        }
+
+        state.SetItemsProcessed(state.iterations() * (scene.meshes.size() + scene.lights.size()));
+        state.counters["bytes"] = static_cast<double>(size);
+    }
+} // namespace
+
+static void BM_Scene_JsonRoundTrip(benchmark::State& state)
+{
+    RoundTrip(state, SaveJson, LoadJson);
+}
+BENCHMARK(BM_Scene_JsonRoundTrip)->Arg(256)->Arg(4096);
+
+static void BM_Scene_BinaryRoundTrip(benchmark::State& state)
+{
+    RoundTrip(state, SaveBinary, LoadBinary);
+}
+BENCHMARK(BM_Scene_BinaryRoundTrip)->Arg(256)->Arg(4096);
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+import Vulkan;
+
+// All Vulkan benchmarks render off-screen, so they run on CI machines without a display,
+// e.g. under lavapipe on machines without a GPU.
+namespace
+{
+    constexpr uint32_t width = 800, height = 600;
+
+    // Pipeline and shader caches go to a temporary directory, removed when the benchmarks exit,
+    // so the cold cache runs never delete a cache from the directory the benchmarks run in.
+    struct CacheDirectory
+    {
+        CacheDirectory() : path(std::filesystem::temp_directory_path() / "RedEye_vulkan_benchmarks")
+        {
+            std::filesystem::create_directories(path);
+            RE::Vulkan::SetCacheDirectory(path.string().c_str());
+        }
+
+        ~CacheDirectory()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        std::filesystem::path path;
+    };
+
+    bool InitVulkan(benchmark::State& state)
+    {
+        static CacheDirectory directory;
+        if (!RE::Vulkan::InitHeadless())
+        {
+            state.SkipWithError("Vulkan unavailable");
+            return false;
+        }
+        return true;
+    }
+
+    bool CreateContext(benchmark::State& state, RE::Vulkan::Context& context, bool readback = false)
+    {
+        if (!InitVulkan(state))
+            return false;
+        if (!context.CreateHeadless(width, height, readback))
+        {
+            state.SkipWithError("Failed to create Vulkan context");
+            return false;
+        }
+        return true;
+    }
+
+    void RenderFrames(benchmark::State& state, RE::Vulkan::Context& context)
+    {
+        context.ResetFrameStats(static_cast<size_t>(state.max_iterations));
+        for (auto _ : state)
+            if (!context.RenderTriangle())
+            {
+                state.SkipWithError("Failed to render frame");
+                break;
+            }
+
+        const auto& stats = context.GetFrameStats();
+        state.counters["cpu_ms"] = stats.AverageCpuMs();
+        state.counters["gpu_wait_ms"] = stats.AverageGpuWaitMs();
+        state.counters["p50_ms"] = stats.PercentileMs(0.5);
+        state.counters["p99_ms"] = stats.PercentileMs(0.99);
+    }
+} // namespace
+
+// Frame loop, optionally copying every frame back to host memory (1). Reports the CPU cost of a
+// frame, how long it blocked waiting for a frame still in flight and the frame time percentiles.
+// lit_pixels is a sanity check that the triangle actually reached the image.
+static void BM_Vulkan_Frame(benchmark::State& state)
+{
+    const bool readback = state.range(0) != 0;
+    RE::Vulkan::Context context;
+    if (!CreateContext(state, context, readback))
+        return;
+
+    RenderFrames(state, context);
+
+    std::vector<uint8_t> pixels;
+    if (readback && context.ReadFrame(pixels))
+    {
+        int64_t lit = 0;
+        for (size_t i = 0; i < pixels.size(); i += 4)
+            if (pixels[i] != 0 || pixels[i + 1] != 0 || pixels[i + 2] != 0)
+                lit++;
+        state.counters["lit_pixels"] = static_cast<double>(lit);
+    }
+
+    context.Delete();
+}
+BENCHMARK(BM_Vulkan_Frame)->ArgName("readback")->Arg(0)->Arg(1)->Iterations(300)->UseRealTime();
+
+// Context creation with the pipeline cache file removed (0) or left from the previous run (1).
+// pipeline_ms is the time spent in vkCreateGraphicsPipelines.
+static void BM_Vulkan_PipelineCache(benchmark::State& state)
+{
+    if (!InitVulkan(state))
+        return;
+
+    const bool warm = state.range(0) != 0;
+    const std::string cache_path = RE::Vulkan::PipelineCachePath();
+    double pipeline_ms = 0.0;
+    for (auto _ : state)
+    {
+        if (!warm)
+            std::filesystem::remove(cache_path);
+
+        RE::Vulkan::Context context;
+        if (!context.CreateHeadless(width, height))
+        {
+            state.SkipWithError("Failed to create Vulkan context");
+            break;
+        }
+        pipeline_ms += context.GetPipelineCache().build_ms;
+        context.Delete();
+    }
+
+    state.counters["pipeline_ms"] = state.iterations() > 0 ? pipeline_ms / state.iterations() : 0.0;
+}
+BENCHMARK(BM_Vulkan_PipelineCache)->Arg(0)->Arg(1)->Iterations(5)->UseRealTime();
+
+// Frame loop over many small draws, recorded inline (1 thread) or split across secondary
+// command buffers. record_ms is the recording part of cpu_ms.
+static void BM_Vulkan_RecordThreads(benchmark::State& state)
+{
+    RE::Vulkan::Context context;
+    if (!CreateContext(state, context))
+        return;
+
+    if (!context.CreateTriangles(static_cast<uint32_t>(state.range(0))) ||
+        !context.SetRecordThreads(static_cast<uint32_t>(state.range(1))))
+    {
+        state.SkipWithError("Failed to set up the scene");
+        context.Delete();
+        return;
+    }
+
+    RenderFrames(state, context);
+    state.counters["record_ms"] = context.GetFrameStats().AverageRecordMs();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    context.Delete();
+}
+BENCHMARK(BM_Vulkan_RecordThreads)
+    ->ArgNames({"objects", "threads"})
+    ->ArgsProduct({{10000}, {1, 2, 4, 8}})
+    ->Iterations(100)
+    ->UseRealTime();
@@ -0,0 +1,242 @@
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RE_Compression.h"
+
+// EASTL routes its allocations through these, the engine defines them in main.cpp
+void* operator new[](size_t size, const char*, int, unsigned, const char*, int)
+{
+    return new uint8_t[size];
+}
+void* operator new[](size_t size, size_t, size_t, const char*, int, unsigned, const char*, int)
+{
+    return new uint8_t[size];
+}
+
+namespace
+{
+    using Level = RE_Compression::Level;
+
+    // Same layout as the header the codec writes in front of Library entries
+    constexpr size_t headerSize = 16;
+    constexpr size_t levelOffset = 4;
+    constexpr size_t rawSizeOffset = 8;
+
+    // Mesh like data: repeated records with slowly changing values
+    std::string MakeCompressible(size_t size)
+    {
+        std::string data(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+            data[i] = static_cast<char>((i % 48) < 24 ? i / 1024 : 'a' + i % 7);
+        return data;
+    }
+
+    std::string MakeIncompressible(size_t size)
+    {
+        std::string data(size, '\0');
+        uint32_t state = 0x12345678u;
+        for (char& c : data)
+        {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<char>(state >> 24);
+        }
+        return data;
+    }
+
+    std::string Compress(const std::string& data, Level level)
+    {
+        char* compressed = nullptr;
+        size_t size = RE_Compression::Compress(data.data(), data.size(), compressed, level);
+        std::string ret(compressed, size);
+        delete[] compressed;
+        return ret;
+    }
+
+    Level GetLevel(const std::string& compressed)
+    {
+        return static_cast<Level>(compressed[levelOffset]);
+    }
+
+    void SetRawSize(std::string& compressed, uint64_t rawSize)
+    {
+        std::memcpy(compressed.data() + rawSizeOffset, &rawSize, sizeof(rawSize));
+    }
+
+    // Decompresses into a buffer sized to the header, so overruns show up under a sanitizer
+    bool Decompress(const std::string& compressed, std::string& out)
+    {
+        size_t rawSize = 0;
+        if (!RE_Compression::GetRawSize(compressed.data(), compressed.size(), rawSize))
+            return false;
+
+        std::unique_ptr<char[]> buffer(new char[rawSize]);
+        if (!RE_Compression::Decompress(compressed.data(), compressed.size(), buffer.get(), rawSize))
+            return false;
+
+        out.assign(buffer.get(), rawSize);
+        return true;
+    }
+} // namespace
+
+TEST(CompressionTest, RoundTripPerLevel)
+{
+    for (size_t size : {0, 1, 12, 13, 100, 4096, 300 * 1024})
+    {
+        const std::string data = MakeCompressible(size);
+        for (Level level : {Level::STORE, Level::FAST, Level::HIGH, Level::ADAPTIVE})
+        {
+            const std::string compressed = Compress(data, level);
+            ASSERT_TRUE(RE_Compression::IsCompressed(compressed.data(), compressed.size()));
+            ASSERT_LE(compressed.size(), RE_Compression::CompressBound(size));
+
+            std::string out;
+            ASSERT_TRUE(Decompress(compressed, out)) << "size " << size << " level " << int(level);
+            ASSERT_EQ(out, data) << "size " << size << " level " << int(level);
+        }
+    }
+
+    const std::string data = MakeCompressible(300 * 1024);
+    ASSERT_LT(Compress(data, Level::FAST).size(), data.size() / 2);
+    ASSERT_LE(Compress(data, Level::HIGH).size(), Compress(data, Level::FAST).size());
+    ASSERT_EQ(GetLevel(Compress(data, Level::STORE)), Level::STORE);
+}
+
+TEST(CompressionTest, RunsCloseToTheExpansionLimit)
+{
+    // Long runs are one match with a 255 byte length per input byte, near the limit headers are checked against
+    for (size_t size : {255 * 255, 1024 * 1024})
+    {
+        const std::string data(size, '\0');
+        for (Level level : {Level::FAST, Level::HIGH})
+        {
+            const std::string compressed = Compress(data, level);
+            ASSERT_EQ(GetLevel(compressed), level);
+            ASSERT_GT(data.size(), (compressed.size() - headerSize) * 240u);
+
+            std::string out;
+            ASSERT_TRUE(Decompress(compressed, out));
+            ASSERT_EQ(out, data);
+        }
+    }
+}
+
+TEST(CompressionTest, IncompressibleInputIsStored)
+{
+    const std::string data = MakeIncompressible(64 * 1024);
+    ASSERT_EQ(RE_Compression::ChooseLevel(data.data(), data.size()), Level::STORE);
+
+    // Asking for a level still stores it once the block doesn't shrink
+    for (Level level : {Level::FAST, Level::HIGH, Level::ADAPTIVE})
+    {
+        const std::string compressed = Compress(data, level);
+        ASSERT_EQ(GetLevel(compressed), Level::STORE);
+        ASSERT_EQ(compressed.size(), headerSize + data.size());
+
+        std::string out;
+        ASSERT_TRUE(Decompress(compressed, out));
+        ASSERT_EQ(out, data);
+    }
+}
+
+TEST(CompressionTest, RawEntriesPassThrough)
+{
+    const std::string data = "entry saved before compression";
+    ASSERT_FALSE(RE_Compression::IsCompressed(data.data(), data.size()));
+
+    size_t rawSize = 0;
+    ASSERT_TRUE(RE_Compression::GetRawSize(data.data(), data.size(), rawSize));
+    ASSERT_EQ(rawSize, data.size());
+
+    std::string out;
+    ASSERT_TRUE(Decompress(data, out));
+    ASSERT_EQ(out, data);
+
+    std::vector<char> small(data.size() - 1);
+    ASSERT_FALSE(RE_Compression::Decompress(data.data(), data.size(), small.data(), small.size()));
+}
+
+TEST(CompressionTest, TruncatedPayload)
+{
+    const std::string data = MakeCompressible(8 * 1024);
+    for (Level level : {Level::STORE, Level::FAST, Level::HIGH})
+    {
+        const std::string compressed = Compress(data, level);
+        for (size_t size = headerSize; size < compressed.size(); ++size)
+        {
+            std::string out;
+            ASSERT_FALSE(Decompress(compressed.substr(0, size), out)) << "level " << int(level) << " cut " << size;
+        }
+    }
+}
+
+TEST(CompressionTest, BadMatchOffset)
+{
+    // One literal, then a 4 byte match reaching further back than the output written so far
+    std::string compressed = Compress(std::string(), Level::STORE);
+    compressed[levelOffset] = static_cast<char>(Level::FAST);
+    SetRawSize(compressed, 5);
+    compressed += std::string("\x10" "a" "\x05\x00", 4);
+    compressed += std::string("\x00", 1);
+
+    std::string out;
+    ASSERT_FALSE(Decompress(compressed, out));
+
+    // Offset 0 is never written either
+    compressed[headerSize + 2] = 0;
+    ASSERT_FALSE(Decompress(compressed, out));
+
+    // Offset 1 repeats the literal, which is valid
+    compressed[headerSize + 2] = 1;
+    ASSERT_TRUE(Decompress(compressed, out));
+    ASSERT_EQ(out, "aaaaa");
+}
+
+TEST(CompressionTest, LyingRawSize)
+{
+    const std::string data = MakeCompressible(16 * 1024);
+    for (Level level : {Level::STORE, Level::FAST, Level::HIGH})
+    {
+        const std::string compressed = Compress(data, level);
+        const uint64_t payloadSize = compressed.size() - headerSize;
+        const uint64_t maxRawSize = level == Level::STORE ? payloadSize : payloadSize * 255u + 16u;
+
+        // Sizes no payload can expand to are rejected before anything is allocated
+        for (uint64_t rawSize : {UINT64_MAX, uint64_t(SIZE_MAX), uint64_t(SIZE_MAX) - 1, maxRawSize + 1})
+        {
+            std::string corrupt = compressed;
+            SetRawSize(corrupt, rawSize);
+            size_t size = 0;
+            ASSERT_FALSE(RE_Compression::GetRawSize(corrupt.data(), corrupt.size(), size)) << rawSize;
+
+            char byte = 0;
+            ASSERT_FALSE(RE_Compression::Decompress(corrupt.data(), corrupt.size(), &byte, SIZE_MAX)) << rawSize;
+        }
+
+        // Plausible sizes that don't match the payload fail while decoding, within the buffer
+        std::vector<uint64_t> plausible = {0, data.size() - 1, data.size() + 1};
+        if (level != Level::STORE)
+            plausible.push_back(maxRawSize);
+        for (uint64_t rawSize : plausible)
+        {
+            std::string corrupt = compressed;
+            SetRawSize(corrupt, rawSize);
+            std::string out;
+            ASSERT_FALSE(Decompress(corrupt, out)) << "level " << int(level) << " raw size " << rawSize;
+        }
+    }
+}
+
+TEST(CompressionTest, UnknownLevel)
+{
+    std::string compressed = Compress(MakeCompressible(4096), Level::FAST);
+    for (Level level : {Level::ADAPTIVE, static_cast<Level>(200)})
+    {
+        compressed[levelOffset] = static_cast<char>(level);
+        size_t rawSize = 0;
+        ASSERT_FALSE(RE_Compression::GetRawSize(compressed.data(), compressed.size(), rawSize));
+    }
+}
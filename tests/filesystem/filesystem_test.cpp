@@ -0,0 +1,326 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <physfs.h>
+#include <string>
+#include <utility>
+#include <vector>
+import FileSystem;
+
+namespace
+{
+    const char* argv0 = nullptr;
+
+    std::string MakeData(size_t size)
+    {
+        std::string data(size, '\0');
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<char>('a' + i % 26);
+        return data;
+    }
+
+    void WriteNativeFile(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    uint32_t Crc32(const std::string& data)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        for (const char c : data)
+        {
+            crc ^= static_cast<unsigned char>(c);
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        return ~crc;
+    }
+
+    // Zip archive holding one stored entry, so the file has no path on disk
+    std::string MakeZip(const std::string& name, const std::string& content)
+    {
+        std::string zip;
+        auto u16 = [&zip](uint32_t value) {
+            zip += static_cast<char>(value & 0xFF);
+            zip += static_cast<char>((value >> 8) & 0xFF);
+        };
+        auto u32 = [&u16](uint32_t value) {
+            u16(value & 0xFFFF);
+            u16(value >> 16);
+        };
+        const uint32_t crc = Crc32(content);
+        const uint32_t size = static_cast<uint32_t>(content.size());
+        const uint32_t nameSize = static_cast<uint32_t>(name.size());
+
+        u32(0x04034b50); // Local file header
+        u16(10), u16(0), u16(0), u16(0), u16(0x21);
+        u32(crc), u32(size), u32(size);
+        u16(nameSize), u16(0);
+        zip += name;
+        zip += content;
+
+        const uint32_t directoryOffset = static_cast<uint32_t>(zip.size());
+        u32(0x02014b50); // Central directory
+        u16(10), u16(10), u16(0), u16(0), u16(0), u16(0x21);
+        u32(crc), u32(size), u32(size);
+        u16(nameSize), u16(0), u16(0), u16(0), u16(0);
+        u32(0), u32(0);
+        zip += name;
+        const uint32_t directorySize = static_cast<uint32_t>(zip.size()) - directoryOffset;
+
+        u32(0x06054b50); // End of central directory
+        u16(0), u16(0), u16(1), u16(1);
+        u32(directorySize), u32(directoryOffset);
+        u16(0);
+        return zip;
+    }
+} // namespace
+
+// Reads real files through PhysFS from temporary directories, one mounted at the root and one
+// under "Mounted/", and from a zip archive mounted under "Archive/"
+class FileSystemTest : public ::testing::Test
+{
+  protected:
+    static void SetUpTestSuite()
+    {
+        directory = std::filesystem::temp_directory_path() / "RedEye_filesystem_test";
+        std::filesystem::create_directories(directory / "root");
+        std::filesystem::create_directories(directory / "mounted");
+        WriteNativeFile(directory / "archive.zip", MakeZip("inside.bin", MakeData(1000)));
+
+        // One worker, so requests are served strictly in queue order
+        RE::FileSystem::SetIOWorkerCount(1);
+        ASSERT_NE(PHYSFS_init(argv0), 0);
+        ASSERT_NE(PHYSFS_setWriteDir((directory / "root").string().c_str()), 0);
+        ASSERT_NE(PHYSFS_mount((directory / "root").string().c_str(), nullptr, 0), 0);
+        ASSERT_NE(PHYSFS_mount((directory / "mounted").string().c_str(), "Mounted", 0), 0);
+        ASSERT_NE(PHYSFS_mount((directory / "archive.zip").string().c_str(), "Archive", 0), 0);
+    }
+
+    static void TearDownTestSuite()
+    {
+        RE::FileSystem::CleanUp();
+        std::filesystem::remove_all(directory);
+    }
+
+    static inline std::filesystem::path directory;
+};
+
+TEST_F(FileSystemTest, ReadWholeFile)
+{
+    const std::string data = MakeData(200 * 1024 + 7);
+    WriteNativeFile(directory / "root" / "read.bin", data);
+    WriteNativeFile(directory / "mounted" / "read.bin", data);
+
+    ASSERT_EQ(RE::FileSystem::Read("read.bin"), data);
+
+    std::string out = "previous contents";
+    ASSERT_TRUE(RE::FileSystem::Read("Mounted/read.bin", out));
+    ASSERT_EQ(out, data);
+
+    ASSERT_FALSE(RE::FileSystem::Read("missing.bin", out));
+    ASSERT_TRUE(out.empty());
+    ASSERT_TRUE(RE::FileSystem::Read("missing.bin").empty());
+}
+
+TEST_F(FileSystemTest, MappedFileMapsDirectoryMounts)
+{
+    const std::string data = MakeData(100 * 1024 + 3);
+    WriteNativeFile(directory / "root" / "sub" / "mapped.bin", data);
+    WriteNativeFile(directory / "mounted" / "sub" / "mapped.bin", data);
+
+    // At the root and under a mount point, which is stripped to find the file on disk
+    for (const char* path : {"sub/mapped.bin", "Mounted/sub/mapped.bin"})
+    {
+        RE::FileSystem::MappedFile view(path);
+        ASSERT_TRUE(view.IsValid()) << path;
+        ASSERT_TRUE(view.IsMapped()) << path;
+        ASSERT_EQ(view.Size(), data.size());
+        ASSERT_EQ(std::memcmp(view.Data(), data.data(), data.size()), 0);
+    }
+}
+
+TEST_F(FileSystemTest, MappedFileReadsArchives)
+{
+    const std::string data = MakeData(1000);
+    ASSERT_EQ(RE::FileSystem::Read("Archive/inside.bin"), data);
+
+    RE::FileSystem::MappedFile view("Archive/inside.bin");
+    ASSERT_TRUE(view.IsValid());
+    ASSERT_FALSE(view.IsMapped());
+    ASSERT_EQ(std::string(view.Data(), view.Size()), data);
+}
+
+TEST_F(FileSystemTest, MappedFileEdgeCases)
+{
+    WriteNativeFile(directory / "root" / "empty.bin", "");
+    RE::FileSystem::MappedFile empty("empty.bin");
+    ASSERT_TRUE(empty.IsValid());
+    ASSERT_EQ(empty.Size(), 0);
+
+    RE::FileSystem::MappedFile missing("missing.bin");
+    ASSERT_FALSE(missing.IsValid());
+    ASSERT_EQ(missing.Data(), nullptr);
+
+    const std::string data = MakeData(4096);
+    WriteNativeFile(directory / "root" / "moved.bin", data);
+    RE::FileSystem::MappedFile first("moved.bin");
+    RE::FileSystem::MappedFile second(std::move(first));
+    ASSERT_FALSE(first.IsValid());
+    ASSERT_TRUE(second.IsValid());
+    ASSERT_EQ(std::string(second.Data(), second.Size()), data);
+
+    second.Close();
+    ASSERT_FALSE(second.IsValid());
+    ASSERT_EQ(second.Size(), 0);
+}
+
+TEST_F(FileSystemTest, NativeRoundTrip)
+{
+    const std::string data = MakeData(64 * 1024 + 5);
+    const std::string path = (directory / "native" / "nested" / "dirs" / "file.bin").string();
+    ASSERT_FALSE(RE::FileSystem::ExistNative(path.c_str()));
+
+    // Missing parent directories are created
+    ASSERT_TRUE(RE::FileSystem::WriteNative(path.c_str(), data.data(), data.size()));
+    ASSERT_TRUE(RE::FileSystem::ExistNative(path.c_str()));
+    ASSERT_TRUE(RE::FileSystem::ExistNative((directory / "native" / "nested").string().c_str()));
+    ASSERT_EQ(RE::FileSystem::ReadNative(path.c_str()), data);
+
+    // Rewriting truncates the previous contents
+    ASSERT_TRUE(RE::FileSystem::WriteNative(path.c_str(), data.data(), 10));
+    std::string out;
+    ASSERT_TRUE(RE::FileSystem::ReadNative(path.c_str(), out));
+    ASSERT_EQ(out, data.substr(0, 10));
+
+    // The directory is joined with a separator whether or not it ends with one
+    const std::string outside = (directory / "outside").string();
+    RE::FileSystem::WriteOutside(outside.c_str(), "plain.bin", data.data(), 100);
+    RE::FileSystem::WriteOutside((outside + "/").c_str(), "slash.bin", data.data(), 100);
+    ASSERT_EQ(RE::FileSystem::ReadNative((directory / "outside" / "plain.bin").string().c_str()), data.substr(0, 100));
+    ASSERT_EQ(RE::FileSystem::ReadNative((directory / "outside" / "slash.bin").string().c_str()), data.substr(0, 100));
+}
+
+TEST_F(FileSystemTest, NativeMissingFile)
+{
+    const std::string path = (directory / "native" / "missing.bin").string();
+    ASSERT_FALSE(RE::FileSystem::ExistNative(path.c_str()));
+
+    std::string out = "previous contents";
+    ASSERT_FALSE(RE::FileSystem::ReadNative(path.c_str(), out));
+    ASSERT_TRUE(out.empty());
+    ASSERT_TRUE(RE::FileSystem::ReadNative(path.c_str()).empty());
+
+    // A directory can't be opened as a file
+    std::filesystem::create_directories(directory / "native" / "blocked");
+    ASSERT_FALSE(RE::FileSystem::WriteNative((directory / "native" / "blocked").string().c_str(), "x", 1));
+}
+
+TEST_F(FileSystemTest, NativeConcurrentWrites)
+{
+    constexpr size_t threads = 8, files = 16;
+    std::vector<std::future<bool>> writers;
+    for (size_t t = 0; t < threads; ++t)
+        writers.push_back(std::async(std::launch::async, [t]() {
+            bool ok = true;
+            for (size_t f = 0; f < files; ++f)
+            {
+                const std::string data = MakeData(1024 * (t + 1) + f);
+                const std::filesystem::path path =
+                    directory / "concurrent" / std::to_string(t) / (std::to_string(f) + ".bin");
+                ok &= RE::FileSystem::WriteNative(path.string().c_str(), data.data(), data.size());
+            }
+            return ok;
+        }));
+    for (auto& writer : writers)
+        ASSERT_TRUE(writer.get());
+
+    for (size_t t = 0; t < threads; ++t)
+        for (size_t f = 0; f < files; ++f)
+        {
+            const std::filesystem::path path =
+                directory / "concurrent" / std::to_string(t) / (std::to_string(f) + ".bin");
+            ASSERT_EQ(RE::FileSystem::ReadNative(path.string().c_str()), MakeData(1024 * (t + 1) + f));
+        }
+}
+
+TEST_F(FileSystemTest, AsyncRequestsByPriority)
+{
+    WriteNativeFile(directory / "root" / "async.bin", MakeData(512));
+
+    // The worker is held by the first request until everything else is queued
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::promise<void> held;
+    ASSERT_TRUE(RE::FileSystem::ReadAsync(
+        "async.bin",
+        [opened, &held](std::string) {
+            held.set_value();
+            opened.wait();
+        },
+        RE::FileSystem::Priority::Interactive));
+    held.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&mutex, &order](const char* name) {
+        return [&mutex, &order, name](std::string contents) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(contents.size() == 512 ? name : "short read");
+        };
+    };
+    RE::FileSystem::ReadAsync("async.bin", record("background"), RE::FileSystem::Priority::Background);
+    RE::FileSystem::ReadAsync("async.bin", record("normal"), RE::FileSystem::Priority::Normal);
+    RE::FileSystem::ReadAsync("async.bin", record("interactive"), RE::FileSystem::Priority::Interactive);
+    RE::FileSystem::ReadAsync("async.bin", record("normal 2"), RE::FileSystem::Priority::Normal);
+
+    // Futures complete once their request is served, the last queued one fences the callbacks
+    std::future<std::string> read = RE::FileSystem::ReadAsync("async.bin", RE::FileSystem::Priority::Background);
+    std::vector<std::future<std::string>> batch =
+        RE::FileSystem::ReadBatch({"async.bin", "missing.bin"}, RE::FileSystem::Priority::Interactive);
+    ASSERT_EQ(read.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+
+    gate.set_value();
+    ASSERT_EQ(read.get().size(), 512);
+    ASSERT_EQ(batch[0].get().size(), 512);
+    ASSERT_TRUE(batch[1].get().empty());
+
+    const std::vector<std::string> expected = {"interactive", "normal", "normal 2", "background"};
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order, expected);
+}
+
+TEST_F(FileSystemTest, AsyncWriteCompletes)
+{
+    const std::string data = MakeData(2048);
+    std::future<void> written = RE::FileSystem::WriteAsync("async/", "written.bin", std::string(data));
+    written.get();
+    ASSERT_EQ(RE::FileSystem::Read("async/written.bin"), data);
+}
+
+// Last in the suite, it shuts the file system down
+TEST_F(FileSystemTest, AsyncRejectedAfterCleanUp)
+{
+    RE::FileSystem::CleanUp();
+    std::future<std::string> read = RE::FileSystem::ReadAsync("async.bin");
+    ASSERT_EQ(read.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    ASSERT_THROW(read.get(), std::future_error);
+
+    bool called = false;
+    ASSERT_FALSE(RE::FileSystem::ReadAsync("async.bin", [&called](std::string) { called = true; }));
+    ASSERT_FALSE(called);
+}
+
+int main(int argc, char** argv)
+{
+    argv0 = argv[0];
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,61 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <physfs.h>
+#include <string>
+#include <thread>
+#include <vector>
 import JSON;
 
+namespace
+{
+    const char* argv0 = nullptr;
+}
+
+// Parses real files through PhysFS, from a temporary directory mounted under "JsonTest/"
+class JsonFileTest : public ::testing::Test
+{
+  protected:
+    static void SetUpTestSuite()
+    {
+        directory = std::filesystem::temp_directory_path() / "RedEye_json_test";
+        std::filesystem::create_directories(directory);
+        ASSERT_NE(PHYSFS_init(argv0), 0);
+        ASSERT_NE(PHYSFS_mount(directory.string().c_str(), "JsonTest", 0), 0);
+    }
+
+    static void TearDownTestSuite()
+    {
+        PHYSFS_deinit();
+        std::filesystem::remove_all(directory);
+    }
+
+    static std::string WriteFile(const char* name, const std::string& content)
+    {
+        std::ofstream file(directory / name, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return std::string("JsonTest/") + name;
+    }
+
+    // An array of objects whose strings and numbers straddle chunk boundaries
+    static std::string MakeDocument(int count)
+    {
+        std::string json = R"({"name":"RedEye","items":[)";
+        for (int i = 0; i < count; ++i)
+        {
+            if (i > 0)
+                json += ',';
+            json += R"({"id":)" + std::to_string(1000000 + i) + R"(,"label":"item\u0041)" + std::to_string(i) +
+                    R"(","scale":)" + std::to_string(i) + ".5}";
+        }
+        json += "]}";
+        return json;
+    }
+
+    static inline std::filesystem::path directory;
+};
+
 TEST(JsonTest, CreateJsonContainer)
 {
     uint32_t id = RE::JSON::Create();
@@ -19,6 +74,124 @@ TEST(JsonTest, ParseJsonString)
     RE::JSON::Destroy(id);
 }
 
+TEST(JsonTest, ParseJsonInsitu)
+{
+    char buffer[] = R"({"name":"RedEye","version":1})";
+    uint32_t id = RE::JSON::ParseInsitu(buffer);
+    ASSERT_NE(id, 0);
+
+    ASSERT_EQ(RE::JSON::Value::PullString("name", "", id), "RedEye");
+    ASSERT_EQ(RE::JSON::GetBuffer(id), R"({"name":"RedEye","version":1})");
+    RE::JSON::Destroy(id);
+}
+
+TEST_F(JsonFileTest, ParseMissingFile)
+{
+    ASSERT_EQ(RE::JSON::ParseFile("JsonTest/missing.json"), 0);
+}
+
+TEST_F(JsonFileTest, ParseFileAcrossChunks)
+{
+    const std::string json = MakeDocument(200);
+    const std::string path = WriteFile("chunks.json", json);
+    const uint32_t expected = RE::JSON::Parse(json);
+    ASSERT_NE(expected, 0);
+
+    // Small chunks so the document spans hundreds of refills, sizes below 4 are raised to 4
+    for (size_t chunkSize : {0, 1, 3, 7, 64, 4096, 64 * 1024})
+    {
+        uint32_t id = RE::JSON::ParseFile(path.c_str(), chunkSize);
+        ASSERT_NE(id, 0) << "chunk size " << chunkSize;
+        ASSERT_EQ(RE::JSON::GetBuffer(id), RE::JSON::GetBuffer(expected));
+
+        RE::JSON::Cursor last(id, "/items/199", false);
+        ASSERT_TRUE(last.IsValid());
+        ASSERT_EQ(last.PullInt("id", 0), 1000199);
+        ASSERT_EQ(last.PullString("label", ""), "itemA199");
+        ASSERT_EQ(last.PullFloat("scale", 0.f), 199.5f);
+        RE::JSON::Destroy(id);
+    }
+    RE::JSON::Destroy(expected);
+}
+
+TEST_F(JsonFileTest, ParseFileExactChunkMultiple)
+{
+    constexpr size_t chunkSize = 64;
+    std::string json = MakeDocument(20);
+    json.append(chunkSize - json.size() % chunkSize, ' ');
+    ASSERT_EQ(json.size() % chunkSize, 0);
+    const std::string path = WriteFile("exact.json", json);
+
+    uint32_t id = RE::JSON::ParseFile(path.c_str(), chunkSize);
+    ASSERT_NE(id, 0);
+    ASSERT_EQ(RE::JSON::Value::PullString("name", "", id), "RedEye");
+    RE::JSON::Cursor last(id, "/items/19", false);
+    ASSERT_EQ(last.PullInt("id", 0), 1000019);
+    RE::JSON::Destroy(id);
+
+    // Ending on the last byte of a chunk, with no trailing whitespace to absorb the refill
+    json = R"({"pad":")";
+    json.append(chunkSize - json.size() - 2, 'x');
+    json += "\"}";
+    ASSERT_EQ(json.size(), chunkSize);
+    id = RE::JSON::ParseFile(WriteFile("exact_one.json", json).c_str(), chunkSize);
+    ASSERT_NE(id, 0);
+    ASSERT_EQ(RE::JSON::Value::PullString("pad", "", id).size(), chunkSize - 10);
+    RE::JSON::Destroy(id);
+}
+
+TEST_F(JsonFileTest, ParseFileTruncated)
+{
+    const std::string json = MakeDocument(50);
+    const std::string path = WriteFile("truncated.json", json.substr(0, json.size() - 1));
+    ASSERT_EQ(RE::JSON::ParseFile(path.c_str(), 64), 0);
+    ASSERT_EQ(RE::JSON::ParseFile(WriteFile("empty.json", "").c_str(), 64), 0);
+}
+
+TEST(JsonTest, StreamingWriter)
+{
+    RE::JSON::Writer writer;
+    writer.StartObject();
+    writer.PushString("name", "RedEye");
+    writer.StartArray("components");
+    for (int i = 0; i < 3; ++i)
+    {
+        writer.StartObject();
+        writer.PushUInt64("parentPoolID", 1000000000000ull + i);
+        const float position[3] = {1.f, 2.f, static_cast<float>(i)};
+        writer.PushFloats("position", position, 3);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    ASSERT_TRUE(writer.Close());
+
+    uint32_t id = RE::JSON::Parse(std::string(writer.GetBuffer()));
+    ASSERT_NE(id, 0);
+    ASSERT_EQ(RE::JSON::Value::PullString("name", "", id), "RedEye");
+
+    RE::JSON::Cursor component(id, "/components/2", false);
+    ASSERT_TRUE(component.IsValid());
+    ASSERT_EQ(component.PullUInt64("parentPoolID", 0), 1000000000002ull);
+    ASSERT_EQ(component.PullUInt64("position", 7), 7);
+    float position[3] = {};
+    ASSERT_EQ(component.PullFloats("position", position, 3), 3);
+    ASSERT_EQ(position[2], 2.f);
+    RE::JSON::Destroy(id);
+}
+
+TEST_F(JsonFileTest, WriterOpenFailure)
+{
+    // No write directory is set, so the file can't be opened
+    RE::JSON::Writer writer("JsonTest/unwritable.json");
+    ASSERT_FALSE(writer.IsValid());
+    writer.StartObject();
+    writer.PushString("name", "RedEye");
+    writer.EndObject();
+    ASSERT_TRUE(writer.GetBuffer().empty());
+    ASSERT_FALSE(writer.Close());
+}
+
 TEST(JsonTest, GetJsonValue)
 {
     const std::string jsonString = R"({"name":"RedEye","version":1})";
@@ -43,8 +216,86 @@ TEST(JsonTest, SetJsonValue)
     RE::JSON::Destroy(id);
 }
 
+TEST(JsonTest, CursorTypedValues)
+{
+    uint32_t id = RE::JSON::Create();
+    ASSERT_NE(id, 0);
+
+    RE::JSON::Cursor transform(id, "/transform");
+    const float position[3] = {1.f, 2.f, 3.f};
+    transform.PushFloats("position", position, 3);
+    transform.PushInt("parent", 42);
+    transform.PushFloat("scale", 0.5f);
+    transform.PushBool("static", true);
+    transform.PushString("name", "RedEye");
+
+    RE::JSON::Cursor read(id, "/transform", false);
+    ASSERT_TRUE(read.IsValid());
+
+    float out[3] = {};
+    ASSERT_EQ(read.PullFloats("position", out, 3), 3);
+    ASSERT_EQ(out[2], 3.f);
+    ASSERT_EQ(read.PullInt("parent", 0), 42);
+    ASSERT_EQ(read.PullFloat("scale", 1.f), 0.5f);
+    ASSERT_TRUE(read.PullBool("static", false));
+    ASSERT_EQ(read.PullString("name", ""), "RedEye");
+    ASSERT_EQ(read.PullInt("missing", -1), -1);
+
+    RE::JSON::Value::Push("transform", id);
+    ASSERT_EQ(RE::JSON::Value::PullString("name", "", id), "RedEye");
+
+    RE::JSON::Destroy(id);
+}
+
+TEST(JsonTest, CursorMissingScope)
+{
+    uint32_t id = RE::JSON::Parse(std::string(R"({"name":"RedEye"})"));
+    ASSERT_NE(id, 0);
+
+    RE::JSON::Cursor missing(id, "/scene", false);
+    ASSERT_FALSE(missing.IsValid());
+
+    RE::JSON::Cursor root(id, "", false);
+    ASSERT_TRUE(root.IsValid());
+    ASSERT_FALSE(root.Child("scene", false).IsValid());
+    ASSERT_EQ(root.PullString("name", ""), "RedEye");
+
+    RE::JSON::Destroy(id);
+}
+
+TEST(JsonTest, ConcurrentDocuments)
+{
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t)
+        workers.emplace_back([t, &failures]() {
+            for (int i = 0; i < 200; ++i)
+            {
+                const std::string name = "worker" + std::to_string(t) + "_" + std::to_string(i);
+
+                uint32_t out = RE::JSON::Create();
+                RE::JSON::PushSelected(out);
+                RE::JSON::Value::PushString(name.c_str(), "name");
+                std::string buffer = RE::JSON::GetBuffer();
+                RE::JSON::Destroy();
+                RE::JSON::PopSelected();
+
+                uint32_t in = RE::JSON::Parse(buffer);
+                if (RE::JSON::Value::PullString("name", "", in) != name)
+                    ++failures;
+                RE::JSON::Destroy(in);
+            }
+        });
+
+    for (auto& worker : workers)
+        worker.join();
+
+    ASSERT_EQ(failures, 0);
+}
+
 int main(int argc, char** argv)
 {
+    argv0 = argv[0];
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
\ No newline at end of file